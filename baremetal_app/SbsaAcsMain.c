@@ -22,6 +22,10 @@
 #include "val/common/include/acs_pe.h"
 #include "val/sbsa/include/sbsa_val_interface.h"
 #include "val/sbsa/include/sbsa_acs_pe.h"
+#include "val/common/include/acs_pgt.h"
+#include "val/sbsa/include/sbsa_acs_smmu.h"
+
+#include "../test_pool/common/smmu_ctx.h"
 
 #include "SbsaAcs.h"
 
@@ -42,6 +46,10 @@ uint32_t  *g_skip_test_num;
 uint32_t  *g_execute_tests;
 uint32_t  *g_execute_modules;
 uint32_t  g_sys_last_lvl_cache;
+uint32_t  g_sbsa_perf_mode;
+uint32_t  g_sbsa_hmat_tol;
+uint32_t  g_sbsa_msi_gap;
+uint32_t  g_sbsa_msi_rounds;
 
 extern uint32_t g_skip_array[];
 extern uint32_t g_num_skip;
@@ -380,6 +388,10 @@ ShellAppMainsbsa(
 
   g_execute_nist = FALSE;
   g_print_mmio = FALSE;
+  g_sbsa_perf_mode = FALSE;
+  g_sbsa_hmat_tol = 0;
+  g_sbsa_msi_gap = 0;
+  g_sbsa_msi_rounds = 0;
   g_wakeup_timeout = PLATFORM_OVERRIDE_TIMEOUT;
   g_sys_last_lvl_cache = PLATFORM_OVERRRIDE_SLC;
 
@@ -458,6 +470,7 @@ ShellAppMainsbsa(
 
   /***         Starting Exerciser tests              ***/
   Status |= val_sbsa_exerciser_execute_tests(g_sbsa_level);
+  smmu_ctx_pool_destroy();
 
   /***         Starting MPAM tests                   ***/
   if (g_sbsa_level > 6)
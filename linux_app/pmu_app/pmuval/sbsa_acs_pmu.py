@@ -19,7 +19,7 @@ Test SBSA PMU events
 
 from __future__ import print_function
 
-import os, sys, subprocess, argparse
+import os, sys, math, subprocess, argparse
 
 import pysweep
 from pyperf.perf_enum import *
@@ -45,12 +45,41 @@ parser.add_argument("-e", "--event", type=ecode, action="append", default=[], he
 parser.add_argument("-r", "--repeat", type=int, default=1, help="repeat test N times")
 parser.add_argument("-v", "--verbose", action="count", default=0, help="increase verbosity level")
 parser.add_argument("--scaling", type=int, default=0, help="Enable scaling factor")
+parser.add_argument("--counters", type=int, default=0, help="events per counter group (default: probe the PMU)")
+parser.add_argument("--no-group", action="store_true", help="test each event in a workload run of its own")
+parser.add_argument("--load-cache", type=int, default=3, help="number of suspended synthetic workloads to keep")
+parser.add_argument("--warmup", type=float, default=0.01, help="time to run a new synthetic workload before counting")
+parser.add_argument("--fit", type=int, default=0, help="fit predictable events against the workload over N sizes")
+parser.add_argument("--fit-tol", type=float, default=0.05, help="allowed relative deviation from the expected slope")
 parser.add_argument("command", nargs=argparse.REMAINDER, help="command to execute")
 
 opts = parser.parse_args([])
 
 total = [0, 0, 0]
 
+PROBE_EVENT  = 0x08    # INST_RETIRED, needs a general purpose counter
+CYCLE_EVENT  = 0x11    # CPU_CYCLES, has a dedicated cycle counter
+MAX_COUNTERS = 32      # Largest group pyperf reads in one go
+
+FIT_BASE_SIZE = 4096   # Smallest code and data working set of a --fit run
+
+# Events whose counts follow from the operations pysweep generated, as listed by
+# load.expected(). An "exact" event counts those operations, an "at least" event
+# may count more (speculation, split accesses, micro-operations).
+EXPECTED_EVENTS = {
+    0x08: (["inst"], "exact"),                       # INST_RETIRED
+    0x21: (["branch"], "exact"),                     # BR_RETIRED
+    0x3A: (["inst"], "at least"),                    # OP_RETIRED
+    0x3B: (["inst"], "at least"),                    # OP_SPEC
+    0x13: (["mem_read", "mem_write"], "at least"),   # MEM_ACCESS
+    0x66: (["mem_read"], "at least"),                # MEM_ACCESS_RD
+    0x67: (["mem_write"], "at least"),               # MEM_ACCESS_WR
+}
+
+# Two-sided 95% quantiles of Student's t distribution, by degrees of freedom
+T95 = [12.706, 4.303, 3.182, 2.776, 2.571, 2.447, 2.365, 2.306, 2.262, 2.228,
+       2.201, 2.179, 2.160, 2.145, 2.131, 2.120, 2.110, 2.101, 2.093, 2.086]
+
 class BadEvent(Exception):
     pass
 
@@ -124,7 +153,7 @@ def read_relations():
             continue
         yield r
 
-def open_event(en, group=None, enabled=True):
+def open_event(en, group=None, enabled=True, leader=False):
     """
     Open a hardware PMU event to monitor the workload.
 
@@ -132,6 +161,12 @@ def open_event(en, group=None, enabled=True):
      - we don't have privilege
      - we're on an inappropriate target that doesn't support this hardware event code
      - we are opening as a group member, and haven't got enough physical counters
+
+    A group leader reads the values of all its members, tagged with their ids.
+
+    Counters are read from the event's mmap page where the kernel allows it:
+    this only applies when the workload is this thread. Other workloads, and
+    subcommands whose children are counted by inheritance, are read with read().
     """
     if opts.all_cpus:
         pid = -1
@@ -142,13 +177,17 @@ def open_event(en, group=None, enabled=True):
     # Tool verbosity=1: no event messages; tool verbosity=2 (-vv), minimal event messages
     event_verbose = max(0, (opts.verbose - 1))
     rf = PERF_FORMAT_TOTAL_TIME_RUNNING|PERF_FORMAT_TOTAL_TIME_ENABLED
-    attr = PerfEventAttr(type=PERF_TYPE_RAW, config=en, read_format=rf, exclude_kernel=False, inherit=True)
-    flags = pp.PERF_FLAG_WEAK_GROUP
+    if leader:
+        rf |= PERF_FORMAT_GROUP|PERF_FORMAT_ID
+    attr = PerfEventAttr(type=PERF_TYPE_RAW, config=en, read_format=rf, exclude_kernel=False, inherit=(command is not None))
+    if pid == pp.gettid() and os.uname()[4] == "aarch64":
+        attr.update(config1=0x2)    # ask for EL0 access to the counters (needs perf_user_access)
+    flags = pp.PERF_FLAG_WEAK_GROUP|pp.PERF_FLAG_READ_USERSPACE
     e = None
     try:
         if event_verbose:
             print("open_event: %s" % attr)
-        if group is not None:
+        if event_verbose and group is not None:
             print("  in group: %s" % group)
         e = pp.Event(attr, pid=pid, cpu=cpu, enabled=enabled, group=group, verbose=event_verbose, flags=flags)
     except OSError:
@@ -200,6 +239,61 @@ def read_events_values(el):
     values += [e.read().value for e in el[ix:]]
     return values
 
+class CounterGroup:
+    """
+    Count a set of events as one group, so that they all see the same workload run.
+    """
+    def __init__(self, codes):
+        self.codes = codes
+        self.events = []
+
+    def open(self):
+        leader = open_event(self.codes[0], enabled=False, leader=True)
+        self.events = [leader]
+        for en in self.codes[1:]:
+            self.events.append(open_event(en, group=leader, enabled=False))
+        return self
+
+    def enable(self):
+        # Members first: an event that PERF_FLAG_WEAK_GROUP opened outside the
+        # group must still count the same run.
+        for e in self.events[1:]:
+            e.enable()
+        self.events[0].enable()
+        return self
+
+    def disable(self):
+        self.events[0].disable()
+        for e in self.events[1:]:
+            e.disable()
+        return self
+
+    def read(self):
+        """
+        Return the count of each event, or None for an event that was not
+        counting for the whole run (not scheduled, or multiplexed).
+        """
+        (enabled, running, grouped) = self.events[0].read_values()
+        grouped = dict(grouped)
+        group_running = (float(running) / enabled) if enabled else 0.0
+        values = []
+        for e in self.events:
+            if e.id() in grouped:
+                v = grouped[e.id()]
+                running = group_running
+            else:
+                rd = e.read()
+                v = rd.value
+                running = rd.fraction_running
+            values.append(v if (v is not None and running >= 1.0) else None)
+        return values
+
+    def close(self):
+        for e in reversed(self.events):
+            e.close()
+        self.events = []
+        return self
+
 class Witness:
     """
     Take a reading from a monitor, to get a set of event values to check against the relationship.
@@ -216,7 +310,7 @@ class Witness:
 
     def accepts(self):
         if opts.scaling:
-            if x == 2:
+            if self.m.x == 2:
                 return self.m.r.accepts(total)
             else :
                 return 1
@@ -224,20 +318,57 @@ class Witness:
             return self.m.r.accepts(total)
 
 class Workload:
+    """
+    The workload that events are counted on. Synthetic loads are kept suspended
+    and cached by their pysweep spec, so relations and scaling steps asking for
+    the same spec reuse a load instead of generating its code and data again.
+    """
     def __init__(self):
         self.pid = None
+        self.load = None
+        self.iterations = 0
+        self.loads = []    # (spec key, load), least recently used first
 
     def prepare(self):
         if opts.data or opts.code:
             load_opts = {"data": opts.data, "data_dispersion": opts.data_dispersion, "inst": opts.code, "flags": pysweep.MEM_NO_HUGEPAGE}
-            self.load = pysweep.Load(load_opts, verbose=max(0, opts.verbose-1))
-            self.load.start()
+            self.load = self.cached_load(load_opts)
             self.pid = self.load.tids()[0]
+        else:
+            self.pid = os.getpid()
+
+    def cached_load(self, load_opts):
+        # pysweep ignores fields that are None, so they don't distinguish specs
+        key = tuple(sorted((k, v) for (k, v) in load_opts.items() if v is not None))
+        for (i, (k, load)) in enumerate(self.loads):
+            if k == key:
+                self.loads.append(self.loads.pop(i))
+                return load
+        if len(self.loads) < max(1, opts.load_cache):
+            load = pysweep.Load(load_opts, verbose=max(0, opts.verbose-1))
+            load.start()
             if opts.verbose:
                 print("reltest: suspend")
-            self.load.suspend()
+            load.suspend()
         else:
-            self.pid = os.getpid()
+            # Retarget the least recently used load, keeping its thread
+            (k, load) = self.loads.pop(0)
+            if opts.verbose:
+                print("reltest: update")
+            load.update(load_opts)
+        self.loads.append((key, load))
+        if opts.warmup:
+            # Warm the caches and TLBs on the new code and data
+            load.resume()
+            pysweep.sleep(opts.warmup)
+            load.suspend()
+        return load
+
+    def close(self):
+        for (k, load) in self.loads:
+            load.stop()
+        self.loads = []
+        self.load = None
 
     def run(self):
         if opts.verbose:
@@ -253,13 +384,20 @@ class Workload:
                 print(out, end="")
         elif opts.data or opts.code:
             # Run a synthetic workload, for the --sleep duration
+            n_iters = self.load.iterations()
             self.load.resume()
             pysweep.sleep(opts.sleep)
             self.load.suspend()
+            self.iterations = self.load.iterations() - n_iters
         else:
             # Just sleep for the --sleep duration, e.g. to pick up background system activity
             pysweep.sleep(opts.sleep)
 
+def set_scaling(x):
+    if opts.scaling:
+        opts.data = (x + 1) * 100
+        opts.code = (x + 1) * 100
+
 def test_relation(r,x):
     """
     Test a relationship between events. Because each relationship involves a specific
@@ -267,10 +405,7 @@ def test_relation(r,x):
     test for each relationship, with just those events configured.
     """
 
-    if opts.scaling:
-        opts.data = (x + 1) * 100
-        opts.code = (x + 1) * 100
-
+    set_scaling(x)
     g_workload.prepare()
     m = Monitor(r, x)
     m.enable()
@@ -285,22 +420,193 @@ def test_relation(r,x):
 
     if opts.scaling:
         if x == 2:  # Update test count on third itration
-            r.n_tests += 1
-            if not w.ok:
-                r.n_fails += 1
-            show_witness(w)
+            record_result(r, w.ok)
     else:
-        r.n_tests += 1
-        if not w.ok:
-            r.n_fails += 1
-        show_witness(w)
+        record_result(r, w.ok)
 
     return w.ok
 
-def show_witness(w):
+def count_group(codes):
+    """
+    Run the workload once with the events counted as one group, returning
+    the values read by CounterGroup.read().
+    """
+    g_workload.prepare()
+    g = CounterGroup(codes).open()
+    g.enable()
+    g_workload.run()
+    if opts.scaling:
+        pysweep.br_pred(opts.data)
+    else:
+        pysweep.br_pred(1);
+    g.disable()
+    values = g.read()
+    g.close()
+    return values
+
+def probe_counters():
+    """
+    Find how many events can be counted in one group. Open a group as large as
+    pyperf can read, run the workload, and shrink the group until every member
+    was counted for the whole run.
+    """
+    set_scaling(0)
+    n = MAX_COUNTERS
+    while n > 1:
+        values = count_group([PROBE_EVENT] * n)
+        counted = len([v for v in values if v is not None])
+        if counted == n:
+            break
+        n = max(1, min(n - 1, counted))
+    if opts.verbose:
+        print("reltest: %u events per counter group" % n)
+    return n
+
+def pack_relations(rels, n_counters):
+    """
+    Pack the events of the relations into groups of at most n_counters events.
+    Relations on the same event share its counter, and CPU_CYCLES rides along in
+    the first group on the dedicated cycle counter. The first group is cut to
+    MAX_COUNTERS - 1 events then, so that it still fits pyperf's group read.
+    """
+    codes = []
+    for r in rels:
+        if r.sup not in codes:
+            codes.append(r.sup)
+    cycles = CYCLE_EVENT in codes
+    if cycles:
+        codes.remove(CYCLE_EVENT)
+    first = min(n_counters, MAX_COUNTERS - 1) if cycles else n_counters
+    groups = [codes[:first]] if codes else []
+    groups += [codes[i:i + n_counters] for i in range(first, len(codes), n_counters)]
+    if cycles:
+        if groups:
+            groups[0].append(CYCLE_EVENT)
+        else:
+            groups.append([CYCLE_EVENT])
+    return groups
+
+def test_groups(rels, groups):
+    """
+    Test the relations with one workload run per counter group (per scaling
+    step), rather than one per relation. A relation whose event could not be
+    counted for the whole run falls back to test_relation(), so the pass/fail
+    result is the same as testing it on its own.
+    """
+    runs = []
+    for x in range(3 if opts.scaling else 1):
+        set_scaling(x)
+        counts = {}
+        for codes in groups:
+            for (en, v) in zip(codes, count_group(codes)):
+                counts[en] = v
+        runs.append(counts)
+
+    for r in rels:
+        total[0] = 0
+        total[1] = 0
+        total[2] = 0
+        values = [counts[r.sup] for counts in runs]
+        if None in values:
+            if opts.verbose:
+                print("reltest: %04x not counted in its group, testing alone" % r.sup)
+            for x in range(len(runs)):
+                test_relation(r, x)
+        else:
+            total[:len(values)] = values
+            record_result(r, r.accepts(total))
+
+def fit_line(xs, ys):
+    """
+    Least squares fit of y = offset + slope * x. Return (offset, slope, half width
+    of the 95% confidence interval of the slope), or None if there are too few
+    distinct points to estimate the interval.
+    """
+    n = len(xs)
+    if n < 3:
+        return None
+    mx = sum(xs) / float(n)
+    my = sum(ys) / float(n)
+    sxx = sum((x - mx) ** 2 for x in xs)
+    if sxx == 0:
+        return None
+    slope = sum((x - mx) * (y - my) for (x, y) in zip(xs, ys)) / sxx
+    offset = my - slope * mx
+    sse = sum((y - offset - slope * x) ** 2 for (x, y) in zip(xs, ys))
+    t = T95[n - 3] if (n - 2) <= len(T95) else 1.96
+    return (offset, slope, t * math.sqrt(sse / (n - 2) / sxx))
+
+def expected_count(en, expected):
+    # Operations per workload iteration that event en should count
+    (fields, kind) = EXPECTED_EVENTS[en]
+    n = 0.0
+    for f in fields:
+        n += 1.0 if f == "inst" else expected[f]
+    return n * expected["n_inst"]
+
+def fit_accepts(kind, fit):
+    (offset, slope, ci) = fit
+    if slope + ci < 1.0 - opts.fit_tol:
+        return 0    # Counts fewer operations than the workload executes
+    if kind == "exact" and slope - ci > 1.0 + opts.fit_tol:
+        return 0    # Counts more operations than the workload executes
+    return 1
+
+def fit_relations(rels, n_counters):
+    """
+    Precision check of the events that pysweep can predict. Run the workload at
+    opts.fit code and data sizes, with the events counted in groups, and fit each
+    event's counts against the operations the workload executed. The slope should
+    be 1 within opts.fit_tol; the offset absorbs the cost of starting and stopping.
+    Return (tests, fails).
+    """
+    rels = [r for r in rels if r.sup in EXPECTED_EVENTS]
+    if not rels:
+        return (0, 0)
+    groups = pack_relations(rels, n_counters)
+    points = dict((en, ([], [])) for codes in groups for en in codes)
+    (data, code) = (opts.data, opts.code)
+    for i in range(opts.fit):
+        opts.data = FIT_BASE_SIZE << i
+        opts.code = FIT_BASE_SIZE << i
+        for codes in groups:
+            values = count_group(codes)
+            expected = g_workload.load.expected()
+            if expected is None or not g_workload.iterations:
+                continue
+            for (en, v) in zip(codes, values):
+                if v is not None:
+                    points[en][0].append(expected_count(en, expected) * g_workload.iterations)
+                    points[en][1].append(v)
+    (opts.data, opts.code) = (data, code)
+
+    n_tests = 0
+    n_fails = 0
+    for r in rels:
+        kind = EXPECTED_EVENTS[r.sup][1]
+        fit = fit_line(*points[r.sup])
+        print(" Fit  : %s, event : %04x, %-8s" % (r.rule, r.sup, kind), end="")
+        if fit is None:
+            print(" too few samples (%u)  %s :SKIP" % (len(points[r.sup][0]), r.reason.ljust(30)))
+            continue
+        (offset, slope, ci) = fit
+        ok = fit_accepts(kind, fit)
+        n_tests += 1
+        if not ok:
+            n_fails += 1
+        print(" slope %.4f +/- %.4f, offset %.0f  %s" % (slope, ci, offset, r.reason.ljust(30)), end="")
+        print(" :PASS" if ok else " :FAIL")
+    return (n_tests, n_fails)
+
+def record_result(r, ok):
+    r.n_tests += 1
+    if not ok:
+        r.n_fails += 1
+    show_witness(r, ok)
+
+def show_witness(r, ok):
     # Print more detail about how these values contradict the relationship.
     # (Or perhaps not - when verbose, we also show this for all tests.)
-    r = w.m.r
     if opts.scaling:
         print(" Rule : %s, event : %04x, count[%08u,%08u,%08u]" % (r.rule, r.sup, total[0], total[1], total[2]), end="")
     else :
@@ -309,7 +615,7 @@ def show_witness(w):
     string_revised=r.reason.ljust(30)
     print("  %s" % (string_revised), end="")
 
-    if not w.ok:
+    if not ok:
         print(" :FAIL")
     else:
         print(" :PASS")
@@ -326,20 +632,30 @@ if __name__ == "__main__":
     total_tests = 0
     total_fails = 0
 
+    if opts.no_group:
+        n_counters = 1
+        groups = None
+    else:
+        n_counters = min(opts.counters if opts.counters else probe_counters(), MAX_COUNTERS)
+        groups = pack_relations(rels, n_counters)
+
     print("")
     print("***** Starting PMU event test *****")
     print("")
     
     for i in range(opts.repeat):
+        if groups:
+            test_groups(rels, groups)
         for r in rels:
-            total[0] = 0
-            total[1] = 0
-            total[2] = 0
-            if opts.scaling:
-                for x in range(0, 3):
-                    test_relation(r, x)
-            else:
-                test_relation(r, 0)
+            if not groups:
+                total[0] = 0
+                total[1] = 0
+                total[2] = 0
+                if opts.scaling:
+                    for x in range(0, 3):
+                        test_relation(r, x)
+                else:
+                    test_relation(r, 0)
 
             total_tests += r.n_tests
             total_fails += r.n_fails
@@ -347,3 +663,12 @@ if __name__ == "__main__":
         print("----------------------------------------------------------")
         print(" Total tets: %d , Total Passed: %d, Total Failed: %d" % (total_tests, (total_tests - total_fails), total_fails))
         print("----------------------------------------------------------")
+
+    if opts.fit and command:
+        print("Fit needs the synthetic workload, not a command")
+    elif opts.fit:
+        (fit_tests, fit_fails) = fit_relations(rels, n_counters)
+        print(" Fit tests: %d , Fit Passed: %d, Fit Failed: %d" % (fit_tests, (fit_tests - fit_fails), fit_fails))
+        print("----------------------------------------------------------")
+
+    g_workload.close()
@@ -51,6 +51,7 @@
 #include <sys/ioctl.h>
 #include <sys/mman.h>
 #include <sys/personality.h>
+#include <sched.h>
 #include <poll.h>
 
 /*
@@ -121,7 +122,7 @@ struct event_object_s {
     PyObject_HEAD
     struct perf_event_attr attr;   /* kernel perf's info about the event */
     int cpu;                       /* cpu that this event is bound to, or -1 if all-cpu */
-    //int pid;                       /* PID that this event is bound to, or -1 if system-wide */
+    int pid;                       /* thread that this event is bound to, 0 for self, or -1 if system-wide */
     int fd;                        /* file handle from perf_event_open: unique to this event */
     unsigned long long id;         /* event unique identifier */
     int verbose;                   /* -vv or similar was used */
@@ -635,13 +636,6 @@ static int event_init(PyObject *x, PyObject *args, PyObject *kwds)
     if (e_custom_flags & PERF_FLAG_NO_READ_USERSPACE) {
         e->try_userspace_read = 0;
     }
-    if (e->attr.read_format & PERF_FORMAT_GROUP) {
-        /* If we want all the counters read at the same time, then it doesn't
-           make sense to read 'live' values from userspace - unless those
-           counters have been simultaneously frozen */
-        e->try_userspace_read = 0;
-    }
-
     {
         /* Get the perf_event_attr buffer. The buffer argument may be any of:
              bytes()
@@ -697,6 +691,12 @@ static int event_init(PyObject *x, PyObject *args, PyObject *kwds)
         e->attr.disabled = !PyObject_IsTrue(e_enabled_obj);
     }
 
+    if (e->attr.inherit) {
+        /* The mmap page only tracks the counter in the parent task -
+           counts from inherited child tasks are only summed by read(). */
+        e->try_userspace_read = 0;
+    }
+
     /* This is a sampling event, which will need a buffer allocated.
        Strictly, we don't need to know that when we create the event.
        But it helps to create the buffer early so that
@@ -870,6 +870,7 @@ retry:;
                     /* We could create this event, just not in a group */
                     if (e_custom_flags & PERF_FLAG_WEAK_GROUP) {
                         fd = temp_fd;
+                        e_group_fd = -1;    /* not read with the leader */
                         goto event_created;
                     }
                     close(temp_fd);
@@ -924,6 +925,7 @@ event_created:
      * The event has been successfully created.
      */
     e->cpu = e_cpu;
+    e->pid = pidtid;
     e->fd = fd;
 
     /*
@@ -954,6 +956,11 @@ event_created:
         /* TBD: what happens to this list when we delete events
            (in some order?) */
     }
+    if (e_group_fd != -1) {
+        /* The kernel reports this event in the leader's group readings */
+        Py_INCREF(e_group_obj);
+        e->group_leader = (EventObject *)e_group_obj;
+    }
     if (is_sampling) {
         if (e->buffer_owner == NULL) {
             event_setup_buffer(e);
@@ -1501,6 +1508,9 @@ static void postprocess_reading(PyObject *x)
 
 static PyObject *populate_reading_object_from_data(PyObject *x, void const *data, EventObject *e);
 
+/* Most counters we expect to read from one group */
+#define GROUP_READ_MAX 32
+
 static PyObject *perf_read_count_using_read(PyObject *x)
 {
     /*
@@ -1511,7 +1521,7 @@ static PyObject *perf_read_count_using_read(PyObject *x)
      */
     int n;
     int size_expected = -1;
-    unsigned long long buf[20];    /* 8 counters * (1+1) + 4 header */
+    unsigned long long buf[3 + GROUP_READ_MAX*2];    /* counters * (value+id) + 3 header */
     BaseReadingObject *base = (BaseReadingObject *)x;
     EventObject *e = base->event;
     size_t tr = perf_reading_size(e);
@@ -1679,6 +1689,39 @@ static inline unsigned long long rdpmc(unsigned int idx)
 }
 
 
+/*
+ * Get the calling thread's OS thread id, caching it so that checking
+ * an event before a userspace read doesn't cost a system call.
+ */
+static pid_t current_tid(void)
+{
+    static __thread pid_t tid;
+    if (tid == 0) {
+        tid = (pid_t)syscall(SYS_gettid);
+    }
+    return tid;
+}
+
+
+/*
+ * Test if an event's live counter would be on the core we're running on:
+ * the mmap page index is set while the event is on a counter on any core,
+ * but rdpmc only reads our own core's counters.
+ */
+static int event_is_local(EventObject const *e)
+{
+    if (e->pid == 0 || e->pid == current_tid()) {
+        /* Monitoring our own thread - its counters move with us */
+        return 1;
+    }
+    if (e->pid == -1 && e->cpu >= 0) {
+        /* Monitoring a core - only local while we're running on it */
+        return sched_getcpu() == e->cpu;
+    }
+    return 0;
+}
+
+
 /*
  * Try to read the current event value from userspace, into an event_sample_t.
  * Return 1 if successful, 0 if unsuccessful.
@@ -1686,8 +1729,7 @@ static inline unsigned long long rdpmc(unsigned int idx)
  * This only makes sense if we're monitoring either
  *  - our own thread, and nothing else
  *  - this core, and nothing else
- * It probably doesn't make sense for grouped objects either, since we
- * can't guarantee to read all counters in a group without a schedule.
+ * For other events, and for inherited events, the caller must use read().
  */
 static int perf_read_count_userspace(event_sample_t *ed, EventObject *e)
 {
@@ -1703,6 +1745,9 @@ static int perf_read_count_userspace(event_sample_t *ed, EventObject *e)
         /* Can't read PMU from userspace */
         return 0;
     }
+    if (!event_is_local(e)) {
+        return 0;
+    }
     unsigned int seq;
     unsigned long long enabled, running;
     unsigned int time_mult, time_shift;
@@ -1729,6 +1774,10 @@ static int perf_read_count_userspace(event_sample_t *ed, EventObject *e)
         }
         barrier();
     } while (mp->lock != seq);
+    if (e->pid == -1 && sched_getcpu() != e->cpu) {
+        /* Migrated off the monitored core while reading */
+        return 0;
+    }
     if (0) {
         fprintf(stderr, "-- [%u] read_count_userspace, caps=0x%x:\n", e->fd, (unsigned int)mp->capabilities);
         if (mp->capabilities & _cap_user_time) {
@@ -1770,6 +1819,74 @@ static int perf_read_count_userspace(event_sample_t *ed, EventObject *e)
 }
 
 
+/*
+ * Read all the counters of a group from userspace, into a GroupReading,
+ * in the order a PERF_FORMAT_GROUP read() would return them.
+ * Return 1 if successful, 0 if any member can't be read from userspace -
+ * in which case the whole group should be read with one read().
+ *
+ * Each member is read in its own pass of the mmap page seqlock, so unlike
+ * read(), live counters aren't sampled at one instant - the skew between
+ * members is a few counter reads, rather than a system call.
+ */
+static int perf_read_group_userspace(GroupReadingObject *g, EventObject *e)
+{
+    EventObject *members[GROUP_READ_MAX];
+    event_sample_t samples[GROUP_READ_MAX];
+    EventObject *s;
+    unsigned int n = 0, i;
+
+    for (s = e->next_sub; s != NULL; s = s->next_sub) {
+        if (s->group_leader != e) {
+            /* Sharing the leader's buffer, but counted outside the group */
+            continue;
+        }
+        if (n == GROUP_READ_MAX - 1) {
+            return 0;
+        }
+        members[++n] = s;
+    }
+    /* Subordinates are chained most recent first, but the kernel reports
+       them in the order they joined the group, after the leader. */
+    members[0] = e;
+    for (i = 1; i <= n / 2; ++i) {
+        s = members[i];
+        members[i] = members[n + 1 - i];
+        members[n + 1 - i] = s;
+    }
+    n += 1;
+    for (i = 0; i < n; ++i) {
+        s = members[i];
+        if (!s->try_userspace_read || !s->mmap_page) {
+            return 0;
+        }
+        if ((e->attr.read_format & PERF_FORMAT_ID) && !event_get_id(s)) {
+            return 0;
+        }
+        if (!perf_read_count_userspace(&samples[i], s)) {
+            return 0;
+        }
+    }
+    if (g->n_values != n) {
+        free(g->samples);
+        g->samples = (event_sample_t *)malloc(n * sizeof(event_sample_t));
+        if (!g->samples) {
+            g->n_values = 0;
+            return 0;
+        }
+        g->n_values = n;
+    }
+    /* As with read(), the group shares the leader's enabled and running times */
+    g->base.sample = samples[0];
+    for (i = 0; i < n; ++i) {
+        g->samples[i] = samples[0];
+        g->samples[i].value = samples[i].value;
+        g->samples[i].id = (e->attr.read_format & PERF_FORMAT_ID) ? members[i]->id : 0xCCCCCCCC;
+    }
+    return 1;
+}
+
+
 /*
  * Read a counter event's value(s).
  * Use userspace if available, else use read().
@@ -1779,8 +1896,12 @@ static int perf_read_count(PyObject *x)
     int ok;
     BaseReadingObject *base = (BaseReadingObject *)x;
     EventObject *e = base->event;
-    if (e->try_userspace_read) {
-        ok = perf_read_count_userspace(&base->sample, e);
+    if (e->try_userspace_read && e->fd != -1) {
+        if (e->attr.read_format & PERF_FORMAT_GROUP) {
+            ok = perf_read_group_userspace((GroupReadingObject *)x, e);
+        } else {
+            ok = perf_read_count_userspace(&base->sample, e);
+        }
         if (ok) {
             if (0) {
                 /* Consistency check against read() values */
@@ -1795,6 +1916,9 @@ static int perf_read_count(PyObject *x)
                 }
                 assert(ed->value >= edr.value);
             }
+            if (e->datasnap != NULL) {
+                subtract_event_values(x, e->datasnap, e);
+            }
             postprocess_reading(x);
             return ok;
         }
@@ -2251,6 +2375,7 @@ static PyObject *populate_reading_object_from_data(PyObject *x, void const *data
         g->n_values = (unsigned int)*p++;
         unsigned int i;
         p = read_data_to_sample(ed, p, e);
+        free(g->samples);    /* from a previous update() */
         g->samples = (event_sample_t *)malloc(g->n_values * sizeof(event_sample_t));
         for (i = 0; i < g->n_values; ++i) {
             event_sample_t *sed = &g->samples[i];   /* array entry to write into */
@@ -2310,6 +2435,38 @@ static PyObject *event_read(PyObject *x)
 }
 
 
+/*
+ * Read the counts of an event, or of all the events in a group, in one call.
+ * Return a tuple (time_enabled, time_running, ((id, value), ...)) - for a group
+ * leader, one (id, value) pair per member in the order they joined the group,
+ * taken from the same reading. Values are raw counts since the last reset().
+ */
+static PyObject *event_read_values(PyObject *x)
+{
+    EventObject *e = (EventObject *)x;
+    PyObject *r = take_reading(e, NULL);
+    PyObject *values;
+    BaseReadingObject *br;
+    if (!r) {
+        return NULL;
+    }
+    br = (BaseReadingObject *)r;
+    if (e->attr.read_format & PERF_FORMAT_GROUP) {
+        GroupReadingObject *g = (GroupReadingObject *)r;
+        unsigned int i;
+        values = PyTuple_New(g->n_values);
+        for (i = 0; i < g->n_values; ++i) {
+            PyTuple_SET_ITEM(values, i, Py_BuildValue("(KK)", g->samples[i].id, g->samples[i].value));
+        }
+    } else {
+        values = Py_BuildValue("((KK))", br->sample.id, br->sample.value);
+    }
+    x = Py_BuildValue("(KKN)", br->sample.time_enabled, br->sample.time_running, values);
+    Py_DECREF(r);
+    return x;
+}
+
+
 /*
  * Update a Reading object
  */
@@ -2755,6 +2912,7 @@ static PyMethodDef Event_methods[] = {
     {"pause", (PyCFunction)&event_pause, METH_NOARGS, "pause a sampling event"},
     {"resume", (PyCFunction)&event_resume, METH_NOARGS, "resume a sampling event"},
     {"read", (PyCFunction)&event_read, METH_NOARGS, "Reading: read the current value of a counting event"},
+    {"read_values", (PyCFunction)&event_read_values, METH_NOARGS, "(int, int, ((int, int), ...)): read enabled and running times, and (id, value) of each counter in the group"},
     {"poll", (PyCFunction)&event_poll, METH_NOARGS, "bool: test if event record is available"},
     {"is_active", (PyCFunction)&event_is_active, METH_NOARGS, "bool: test if event was closed by kernel"},
     {"get_record", (PyCFunction)&event_get_record, METH_NOARGS, "Record: get next record from a sampling event"},
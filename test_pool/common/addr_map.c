@@ -0,0 +1,229 @@
+/** @file
+ * Copyright (c) 2026, Arm Limited or its affiliates. All rights reserved.
+ * SPDX-License-Identifier : Apache-2.0
+
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ **/
+
+
+#include "val/common/include/acs_val.h"
+#include "val/common/include/acs_common.h"
+#include "val/common/include/acs_peripherals.h"
+
+#include "addr_map.h"
+
+/* Indexed by ADDR_OWNER_* */
+static char8_t *addr_owner_fmt[ADDR_OWNER_MAX] = {
+  " MSC %d",
+  " USB %d",
+  " UART %d",
+  " SATA %d",
+  " Peripheral %d"
+};
+
+void
+addr_map_init(ADDR_MAP *map)
+{
+  map->num_ranges = 0;
+  map->dropped    = 0;
+}
+
+/**
+  @brief   Append a range to the map.
+
+  @param   map          Address map
+  @param   base         Start address
+  @param   len          Length in bytes, 0 for a single address
+  @param   owner_type   ADDR_OWNER_* of the table the range comes from
+  @param   owner_index  Index of the range in that table
+  @return  0 on success, 1 if the map is full.
+**/
+uint32_t
+addr_map_add(ADDR_MAP *map, uint64_t base, uint64_t len, uint32_t owner_type,
+             uint32_t owner_index)
+{
+  ADDR_RANGE *range;
+
+  if (map->num_ranges >= ADDR_MAP_MAX_RANGES) {
+      map->dropped++;
+      return 1;
+  }
+
+  range = &map->range[map->num_ranges++];
+  range->base        = base;
+  range->len         = len;
+  range->owner_type  = owner_type;
+  range->owner_index = owner_index;
+
+  return 0;
+}
+
+/**
+  @brief   Append the base address of every peripheral of one kind. Peripherals
+           with a base of 0 are not described and are left out.
+
+  @param   map         Address map
+  @param   num_info    val_peripheral_get_info type giving the count, e.g. NUM_UART
+  @param   base_info   val_peripheral_get_info type giving the base, e.g. UART_BASE0
+  @param   owner_type  ADDR_OWNER_* recorded for these ranges
+  @return  Number of ranges added.
+**/
+uint32_t
+addr_map_add_peripherals(ADDR_MAP *map, uint32_t num_info, uint32_t base_info,
+                         uint32_t owner_type)
+{
+  uint32_t count;
+  uint32_t idx;
+  uint32_t added = 0;
+  uint64_t base;
+
+  count = val_peripheral_get_info(num_info, 0);
+  for (idx = 0; idx < count; idx++) {
+      base = val_peripheral_get_info(base_info, idx);
+      if (base == 0)
+          continue;
+
+      if (addr_map_add(map, base, 0, owner_type, idx))
+          break;
+
+      added++;
+  }
+
+  return added;
+}
+
+static
+uint32_t
+addr_range_less(ADDR_RANGE *a, ADDR_RANGE *b)
+{
+  if (a->base != b->base)
+      return a->base < b->base;
+
+  if (a->owner_type != b->owner_type)
+      return a->owner_type < b->owner_type;
+
+  return a->owner_index < b->owner_index;
+}
+
+static
+void
+addr_range_sift_down(ADDR_RANGE *range, uint32_t root, uint32_t num)
+{
+  uint32_t child;
+  ADDR_RANGE tmp;
+
+  while ((child = 2 * root + 1) < num) {
+      if (child + 1 < num && addr_range_less(&range[child], &range[child + 1]))
+          child++;
+
+      if (!addr_range_less(&range[root], &range[child]))
+          return;
+
+      tmp          = range[root];
+      range[root]  = range[child];
+      range[child] = tmp;
+      root = child;
+  }
+}
+
+/**
+  @brief   Heap sort the ranges by base address, in place and without any
+           allocation so it can run before the memory map is trusted.
+**/
+static
+void
+addr_map_sort(ADDR_MAP *map)
+{
+  ADDR_RANGE *range = map->range;
+  ADDR_RANGE tmp;
+  uint32_t num = map->num_ranges;
+  uint32_t idx;
+
+  if (num < 2)
+      return;
+
+  for (idx = num / 2; idx-- > 0; )
+      addr_range_sift_down(range, idx, num);
+
+  for (idx = num - 1; idx > 0; idx--) {
+      tmp        = range[0];
+      range[0]   = range[idx];
+      range[idx] = tmp;
+      addr_range_sift_down(range, 0, idx);
+  }
+}
+
+static
+void
+addr_map_report(ADDR_RANGE *a, ADDR_RANGE *b)
+{
+  val_print(ACS_PRINT_ERR, "\n       Address overlap:", 0);
+  val_print(ACS_PRINT_ERR, addr_owner_fmt[a->owner_type], a->owner_index);
+  val_print(ACS_PRINT_ERR, " at 0x%llx and", a->base);
+  val_print(ACS_PRINT_ERR, addr_owner_fmt[b->owner_type], b->owner_index);
+  val_print(ACS_PRINT_ERR, " at 0x%llx", b->base);
+}
+
+/**
+  @brief   Sort the ranges by base and sweep them once, reporting every pair
+           that conflicts. Range b conflicts with an earlier range a when
+           b.base < a.base + a.len + min_gap, so min_gap 0 is a plain overlap
+           check and a non zero min_gap also enforces a spacing. Since the
+           ranges are sorted, the inner scan stops at the first range clear
+           of a, which keeps the cost at O(N log N + conflicts).
+
+  @param   map         Address map, sorted in place
+  @param   min_gap     Minimum distance between the end of a range and the next base
+  @param   owner_mask  ADDR_OWNER_BIT() set, a pair is only checked when at least
+                       one of its ranges belongs to an owner type in the set
+  @return  Number of conflicting pairs.
+**/
+uint32_t
+addr_map_check(ADDR_MAP *map, uint64_t min_gap, uint32_t owner_mask)
+{
+  ADDR_RANGE *a;
+  ADDR_RANGE *b;
+  uint64_t limit;
+  uint32_t idx;
+  uint32_t next;
+  uint32_t conflicts = 0;
+
+  if (map->dropped)
+      val_print(ACS_PRINT_WARN, "\n       Address map full, %d ranges not checked",
+                map->dropped);
+
+  addr_map_sort(map);
+
+  for (idx = 0; idx < map->num_ranges; idx++) {
+      a = &map->range[idx];
+
+      /* Saturate so a range at the top of the address space does not wrap */
+      limit = a->base + a->len + min_gap;
+      if (limit < a->base)
+          limit = ~0ull;
+
+      for (next = idx + 1; next < map->num_ranges; next++) {
+          b = &map->range[next];
+          if (b->base >= limit)
+              break;
+
+          if (!(owner_mask & (ADDR_OWNER_BIT(a->owner_type) | ADDR_OWNER_BIT(b->owner_type))))
+              continue;
+
+          addr_map_report(a, b);
+          conflicts++;
+      }
+  }
+
+  return conflicts;
+}
@@ -0,0 +1,59 @@
+/** @file
+ * Copyright (c) 2026, Arm Limited or its affiliates. All rights reserved.
+ * SPDX-License-Identifier : Apache-2.0
+
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ **/
+
+
+#ifndef __ADDR_MAP_H__
+#define __ADDR_MAP_H__
+
+#define ADDR_MAP_MAX_RANGES  1024
+
+typedef enum {
+  ADDR_OWNER_MSC = 0,
+  ADDR_OWNER_USB,
+  ADDR_OWNER_UART,
+  ADDR_OWNER_SATA,
+  ADDR_OWNER_PERIPHERAL,
+  ADDR_OWNER_MAX
+} ADDR_OWNER_TYPE;
+
+#define ADDR_OWNER_BIT(type)  (1u << (type))
+#define ADDR_OWNER_ALL        (ADDR_OWNER_BIT(ADDR_OWNER_MAX) - 1)
+
+/* Address range and the table entry it was read from. A length of 0 is a
+ * single address, e.g. a peripheral base with no size in the info table.
+ */
+typedef struct {
+  uint64_t base;
+  uint64_t len;
+  uint32_t owner_type;     /* ADDR_OWNER_* */
+  uint32_t owner_index;    /* Index in the owner's info table */
+} ADDR_RANGE;
+
+typedef struct {
+  uint32_t   num_ranges;
+  uint32_t   dropped;      /* Ranges not added because the map was full */
+  ADDR_RANGE range[ADDR_MAP_MAX_RANGES];
+} ADDR_MAP;
+
+void     addr_map_init(ADDR_MAP *map);
+uint32_t addr_map_add(ADDR_MAP *map, uint64_t base, uint64_t len, uint32_t owner_type,
+                      uint32_t owner_index);
+uint32_t addr_map_add_peripherals(ADDR_MAP *map, uint32_t num_info, uint32_t base_info,
+                                  uint32_t owner_type);
+uint32_t addr_map_check(ADDR_MAP *map, uint64_t min_gap, uint32_t owner_mask);
+
+#endif /* __ADDR_MAP_H__ */
@@ -0,0 +1,487 @@
+/** @file
+ * Copyright (c) 2026, Arm Limited or its affiliates. All rights reserved.
+ * SPDX-License-Identifier : Apache-2.0
+
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ **/
+
+
+#include "val/common/include/acs_val.h"
+#include "val/common/include/acs_pe.h"
+#include "val/sbsa/include/sbsa_val_interface.h"
+
+#include "val/sbsa/include/sbsa_acs_pmu.h"
+#include "val/sbsa/include/sbsa_acs_memory.h"
+#include "val/sbsa/include/sbsa_acs_mpam.h"
+
+#include "traffic_gen.h"
+#include "apmt_prof.h"
+
+/* CoreSight PMU configuration register, SIZE is the counter width minus one */
+#define APMT_PMCFGR             0xE00
+#define APMT_PMCFGR_SIZE_SHIFT  8
+#define APMT_PMCFGR_SIZE_MASK   0x3F
+
+/* Traffic of apmt_prof_run, copied in each memory range. The buffers span
+ * several LLCs so the copy streams from memory rather than the cache.
+ */
+#define APMT_PROF_BUF_SIZE      0x400000     /* Smallest buffer, and when the LLC size is unknown */
+#define APMT_PROF_BUF_MAX       0x4000000    /* Buffer cap, 64 MB */
+#define APMT_PROF_LLC_MULT      4
+#define APMT_PROF_CHUNK         (APMT_PROF_BUF_SIZE / 8)
+#define APMT_PROF_RUN_MON       3
+
+static PMU_EVENT_TYPE_e run_event[][APMT_PROF_RUN_MON] = {
+  {PMU_EVENT_IB_TOTAL_BW, PMU_EVENT_IB_READ_BW, PMU_EVENT_IB_WRITE_BW},
+  {PMU_EVENT_IB_OPEN_TXN, PMU_EVENT_IB_TOTAL_TXN},
+  {PMU_EVENT_LOCAL_BW, PMU_EVENT_REMOTE_BW, PMU_EVENT_ALL_BW}
+};
+static uint32_t run_num_mon[] = {3, 2, 3};
+
+static APMT_PROF mem_prof;
+
+static
+uint32_t
+apmt_prof_is_bw(uint32_t event)
+{
+  switch (event) {
+  case PMU_EVENT_IB_TOTAL_BW:
+  case PMU_EVENT_IB_READ_BW:
+  case PMU_EVENT_IB_WRITE_BW:
+  case PMU_EVENT_OB_TOTAL_BW:
+  case PMU_EVENT_OB_READ_BW:
+  case PMU_EVENT_OB_WRITE_BW:
+  case PMU_EVENT_LOCAL_BW:
+  case PMU_EVENT_REMOTE_BW:
+  case PMU_EVENT_ALL_BW:
+      return 1;
+  default:
+      return 0;
+  }
+}
+
+/* Position of the monitor counting event on the node, APMT_PROF_MAX_MON if none */
+static
+uint32_t
+apmt_prof_find(APMT_PROF_NODE *node, uint32_t event)
+{
+  uint32_t mon;
+
+  for (mon = 0; mon < node->num_mon; mon++) {
+      if (node->event[mon] == event)
+          break;
+  }
+
+  return (mon < node->num_mon) ? mon : APMT_PROF_MAX_MON;
+}
+
+/* Bytes per us is MB/s, bandwidth monitors count bytes */
+static
+uint64_t
+apmt_prof_mbps(uint64_t bytes, uint64_t ticks)
+{
+  uint64_t ns = perf_ticks_to_ns(ticks);
+
+  return ns ? (bytes * 1000) / ns : 0;
+}
+
+/* Average latency in PMU cycles from the open and total transaction counts */
+static
+uint64_t
+apmt_prof_latency(APMT_PROF_NODE *node, uint64_t *count)
+{
+  uint32_t open = apmt_prof_find(node, PMU_EVENT_IB_OPEN_TXN);
+  uint32_t total = apmt_prof_find(node, PMU_EVENT_IB_TOTAL_TXN);
+
+  if (open == APMT_PROF_MAX_MON || total == APMT_PROF_MAX_MON || count[total] == 0)
+      return 0;
+
+  return count[open] / count[total];
+}
+
+/**
+  @brief   Start a profile description, no monitor is attached yet.
+
+  @param   prof       Profile
+  @param   period_ns  Minimum time between two samples
+**/
+void
+apmt_prof_init(APMT_PROF *prof, uint64_t period_ns)
+{
+  val_memory_set(prof, sizeof(APMT_PROF), 0);
+  prof->period = (period_ns * perf_get_freq()) / 1000000000ULL;
+}
+
+/**
+  @brief   Mask of the counter bits implemented by an APMT node, from the
+           PMCFGR SIZE field. Taken as 32 bits if the node has no base.
+**/
+uint64_t
+apmt_prof_wrap(uint32_t node_index)
+{
+  uint32_t bits;
+  uint64_t base;
+
+  base = val_pmu_get_info(PMU_NODE_BASE0, node_index);
+  bits = base ? ((val_mmio_read(base + APMT_PMCFGR) >> APMT_PMCFGR_SIZE_SHIFT) &
+                 APMT_PMCFGR_SIZE_MASK) + 1 : 32;
+
+  return (bits >= 64) ? ~0ULL : ((1ULL << bits) - 1);
+}
+
+/**
+  @brief   Sample a monitor the caller has configured to count event. The
+           counter width of the node is read from PMCFGR the first time the
+           node is seen.
+
+  @param   prof        Profile
+  @param   node_index  APMT node
+  @param   mon         Monitor index on the node
+  @param   event       PMU_EVENT_TYPE_e counted by the monitor
+  @return  0 on success, 1 if the profile is out of nodes or monitors.
+**/
+uint32_t
+apmt_prof_add_monitor(APMT_PROF *prof, uint32_t node_index, uint32_t mon, uint32_t event)
+{
+  uint32_t idx;
+  APMT_PROF_NODE *node;
+
+  for (idx = 0; idx < prof->num_nodes; idx++) {
+      if (prof->node[idx].node_index == node_index)
+          break;
+  }
+
+  if (idx == prof->num_nodes) {
+      if (idx >= APMT_PROF_MAX_NODES)
+          return 1;
+
+      node = &prof->node[prof->num_nodes++];
+      node->node_index = node_index;
+      node->wrap = apmt_prof_wrap(node_index);
+  }
+
+  node = &prof->node[idx];
+  for (idx = 0; idx < node->num_mon; idx++) {
+      if (node->ctr[idx] == mon)
+          return 0;
+  }
+
+  if (node->num_mon >= APMT_PROF_MAX_MON)
+      return 1;
+
+  node->ctr[node->num_mon] = mon;
+  node->event[node->num_mon] = event;
+  node->num_mon++;
+
+  return 0;
+}
+
+static
+void
+apmt_prof_sample(APMT_PROF *prof, uint64_t now)
+{
+  uint32_t idx, mon;
+  uint64_t raw, delta;
+  APMT_PROF_NODE *node;
+  APMT_PROF_SAMPLE *sample;
+
+  sample = &prof->ring[prof->head & (APMT_PROF_RING_SIZE - 1)];
+  sample->ts = now - prof->start_ts;
+  prof->head++;
+
+  for (idx = 0; idx < prof->num_nodes; idx++) {
+      node = &prof->node[idx];
+
+      for (mon = 0; mon < node->num_mon; mon++) {
+          raw = val_pmu_read_count(node->node_index, node->ctr[mon]);
+          delta = (raw - node->last[mon]) & node->wrap;
+          node->last[mon] = raw;
+          node->total[mon] += delta;
+          sample->delta[idx][mon] = delta;
+      }
+  }
+
+  prof->last_ts = now;
+}
+
+/**
+  @brief   Enable the sampled monitors and take their start values.
+**/
+void
+apmt_prof_start(APMT_PROF *prof)
+{
+  uint32_t idx, mon;
+  APMT_PROF_NODE *node;
+
+  for (idx = 0; idx < prof->num_nodes; idx++) {
+      node = &prof->node[idx];
+      for (mon = 0; mon < node->num_mon; mon++) {
+          val_pmu_enable_monitor(node->node_index, node->ctr[mon]);
+          node->last[mon] = val_pmu_read_count(node->node_index, node->ctr[mon]);
+          node->total[mon] = 0;
+      }
+  }
+
+  prof->head = 0;
+  prof->start_ts = perf_get_ticks();
+  prof->last_ts = prof->start_ts;
+}
+
+/**
+  @brief   To be called by the traffic source between operations. Takes a
+           sample once the period elapsed since the previous one.
+**/
+void
+apmt_prof_poll(APMT_PROF *prof)
+{
+  uint64_t now = perf_get_ticks();
+
+  if ((now - prof->last_ts) >= prof->period)
+      apmt_prof_sample(prof, now);
+}
+
+/**
+  @brief   Take the closing sample and disable the monitors of every node.
+**/
+void
+apmt_prof_stop(APMT_PROF *prof)
+{
+  uint32_t idx;
+
+  apmt_prof_sample(prof, perf_get_ticks());
+
+  for (idx = 0; idx < prof->num_nodes; idx++)
+      val_pmu_disable_all_monitors(prof->node[idx].node_index);
+}
+
+/**
+  @brief   Run cfg rounds times, polling the profile after each run. Each
+           run covers the next cfg->size bytes of the buffers, wrapping at
+           span, so the traffic is not served from the cache after the
+           first round.
+
+  @param   span  Bytes of each buffer, a multiple of cfg->size
+**/
+void
+apmt_prof_traffic(APMT_PROF *prof, TGEN_CFG *cfg, uint64_t span, uint32_t rounds)
+{
+  uint64_t src = cfg->src;
+  uint64_t dst = cfg->dst;
+  uint64_t offset = 0;
+
+  while (rounds--) {
+      cfg->src = src ? src + offset : 0;
+      cfg->dst = dst ? dst + offset : 0;
+      tgen_run(cfg);
+      apmt_prof_poll(prof);
+
+      offset += cfg->size;
+      if (offset + cfg->size > span)
+          offset = 0;
+  }
+
+  cfg->src = src;
+  cfg->dst = dst;
+}
+
+/* Size of the apmt_prof_run buffers, several times the LLC */
+static
+uint64_t
+apmt_prof_buf_size(void)
+{
+  uint32_t llc_index = val_cache_get_llc_index();
+  uint64_t cache_size = 0;
+  uint64_t size;
+
+  if (llc_index != CACHE_TABLE_EMPTY)
+      cache_size = val_cache_get_info(CACHE_SIZE, llc_index);
+
+  if (cache_size == INVALID_CACHE_INFO)
+      cache_size = 0;
+
+  size = APMT_PROF_LLC_MULT * cache_size;
+  if (size < APMT_PROF_BUF_SIZE)
+      size = APMT_PROF_BUF_SIZE;
+  if (size > APMT_PROF_BUF_MAX)
+      size = APMT_PROF_BUF_MAX;
+
+  return (size + APMT_PROF_CHUNK - 1) & ~((uint64_t)APMT_PROF_CHUNK - 1);
+}
+
+/**
+  @brief   Print the time series of every node, bandwidth monitors in MB/s
+           and the average latency when the transaction monitors are present,
+           then the counts aggregated over all nodes.
+**/
+void
+apmt_prof_report(APMT_PROF *prof)
+{
+  uint32_t idx, mon, num;
+  uint32_t first, other;
+  uint32_t has_lat;
+  uint64_t prev_ts, ticks;
+  uint64_t sum, elapsed;
+  APMT_PROF_NODE *node;
+  APMT_PROF_SAMPLE *sample;
+  uint64_t count[APMT_PROF_MAX_MON];
+
+  first = (prof->head > APMT_PROF_RING_SIZE) ? prof->head - APMT_PROF_RING_SIZE : 0;
+  elapsed = prof->last_ts - prof->start_ts;
+
+  for (idx = 0; idx < prof->num_nodes; idx++) {
+      node = &prof->node[idx];
+      has_lat = (apmt_prof_find(node, PMU_EVENT_IB_OPEN_TXN) != APMT_PROF_MAX_MON) &&
+                (apmt_prof_find(node, PMU_EVENT_IB_TOTAL_TXN) != APMT_PROF_MAX_MON);
+
+      val_print(ACS_PRINT_TEST, "\n       APMT profile, node %d", node->node_index);
+      val_print(ACS_PRINT_TEST, ", %d samples", prof->head);
+      if (first)
+          val_print(ACS_PRINT_TEST, " (%d overwritten)", first);
+
+      val_print(ACS_PRINT_INFO, "\n       t (us)", 0);
+      for (mon = 0; mon < node->num_mon; mon++)
+          val_print(ACS_PRINT_INFO, apmt_prof_is_bw(node->event[mon]) ?
+                    "  ev%2d MB/s" : "  ev%2d cnt ", node->event[mon]);
+      if (has_lat)
+          val_print(ACS_PRINT_INFO, "  lat (cyc)", 0);
+
+      prev_ts = (first == 0) ? 0 : prof->ring[(first - 1) & (APMT_PROF_RING_SIZE - 1)].ts;
+      for (num = first; num < prof->head; num++) {
+          sample = &prof->ring[num & (APMT_PROF_RING_SIZE - 1)];
+          ticks = sample->ts - prev_ts;
+          prev_ts = sample->ts;
+
+          val_print(ACS_PRINT_INFO, "\n       %6d", perf_ticks_to_ns(sample->ts) / 1000);
+          for (mon = 0; mon < node->num_mon; mon++) {
+              count[mon] = sample->delta[idx][mon];
+              val_print(ACS_PRINT_INFO, " %11d", apmt_prof_is_bw(node->event[mon]) ?
+                        apmt_prof_mbps(count[mon], ticks) : count[mon]);
+          }
+          if (has_lat)
+              val_print(ACS_PRINT_INFO, " %10d", apmt_prof_latency(node, count));
+      }
+
+      for (mon = 0; mon < node->num_mon; mon++) {
+          val_print(ACS_PRINT_TEST, "\n       Event 0x%x", node->event[mon]);
+          val_print(ACS_PRINT_TEST, " total %d", node->total[mon]);
+          if (apmt_prof_is_bw(node->event[mon]))
+              val_print(ACS_PRINT_TEST, ", %d MB/s",
+                        apmt_prof_mbps(node->total[mon], elapsed));
+      }
+      if (has_lat)
+          val_print(ACS_PRINT_TEST, "\n       Average latency %d cycles",
+                    apmt_prof_latency(node, node->total));
+  }
+
+  if (prof->num_nodes < 2)
+      return;
+
+  /* Bandwidth over the whole system, summed per event over the nodes */
+  node = &prof->node[0];
+  for (mon = 0; mon < node->num_mon; mon++) {
+      if (!apmt_prof_is_bw(node->event[mon]))
+          continue;
+
+      sum = 0;
+      for (idx = 0; idx < prof->num_nodes; idx++) {
+          other = apmt_prof_find(&prof->node[idx], node->event[mon]);
+          if (other != APMT_PROF_MAX_MON)
+              sum += prof->node[idx].total[other];
+      }
+
+      val_print(ACS_PRINT_TEST, "\n       All nodes, event 0x%x", node->event[mon]);
+      val_print(ACS_PRINT_TEST, " total %d", sum);
+      val_print(ACS_PRINT_TEST, ", %d MB/s", apmt_prof_mbps(sum, elapsed));
+  }
+}
+
+/**
+  @brief   Profile every PMU node of a memory range while copying through
+           each memory range in turn, so local and remote traffic of every
+           node shows up in its time series.
+
+  @param   kind  APMT_PROF_KIND monitor set programmed on the nodes
+  @return  Number of nodes profiled.
+**/
+uint32_t
+apmt_prof_run(uint32_t kind)
+{
+  uint32_t node_index;
+  uint32_t mon;
+  uint64_t range, num_mem_range;
+  uint64_t prox_domain, base, len;
+  uint64_t buf_size = apmt_prof_buf_size();
+  void *src_buf;
+  void *dest_buf;
+  TGEN_CFG traffic = {TGEN_OP_COPY, TGEN_PATTERN_SEQ, 0, 0, 1, 0, 0, APMT_PROF_CHUNK, 0};
+
+  num_mem_range = val_srat_get_info(SRAT_MEM_NUM_MEM_RANGE, 0);
+  if (num_mem_range == 0 || num_mem_range == SRAT_INVALID_INFO)
+      return 0;
+
+  apmt_prof_init(&mem_prof, APMT_PROF_PERIOD_NS);
+
+  for (range = 0; range < num_mem_range; range++) {
+      prox_domain = val_srat_get_prox_domain(range);
+      if (prox_domain == SRAT_INVALID_INFO)
+          continue;
+
+      node_index = val_pmu_get_node_index(prox_domain);
+      if (node_index == PMU_INVALID_INDEX ||
+          val_pmu_get_monitor_count(node_index) < run_num_mon[kind])
+          continue;
+
+      for (mon = 0; mon < run_num_mon[kind]; mon++) {
+          if (val_pmu_configure_monitor(node_index, run_event[kind][mon], mon))
+              break;
+      }
+      if (mon < run_num_mon[kind])
+          continue;
+
+      for (mon = 0; mon < run_num_mon[kind]; mon++)
+          apmt_prof_add_monitor(&mem_prof, node_index, mon, run_event[kind][mon]);
+  }
+
+  if (mem_prof.num_nodes == 0)
+      return 0;
+
+  apmt_prof_start(&mem_prof);
+
+  for (range = 0; range < num_mem_range; range++) {
+      prox_domain = val_srat_get_prox_domain(range);
+      base = val_srat_get_info(SRAT_MEM_BASE_ADDR, prox_domain);
+      len = val_srat_get_info(SRAT_MEM_ADDR_LEN, prox_domain);
+      if ((prox_domain == SRAT_INVALID_INFO) || (base == SRAT_INVALID_INFO) ||
+          (len == SRAT_INVALID_INFO) || (len <= 2 * buf_size))
+          continue;
+
+      src_buf = (void *)val_mem_alloc_at_address(base, buf_size);
+      dest_buf = (void *)val_mem_alloc_at_address(base + buf_size, buf_size);
+
+      if ((src_buf != NULL) && (dest_buf != NULL)) {
+          traffic.src = (uint64_t)src_buf;
+          traffic.dst = (uint64_t)dest_buf;
+          apmt_prof_traffic(&mem_prof, &traffic, buf_size, APMT_PROF_ROUNDS);
+      }
+
+      if (src_buf != NULL)
+          val_mem_free_at_address((uint64_t)src_buf, buf_size);
+      if (dest_buf != NULL)
+          val_mem_free_at_address((uint64_t)dest_buf, buf_size);
+  }
+
+  apmt_prof_stop(&mem_prof);
+  apmt_prof_report(&mem_prof);
+
+  return mem_prof.num_nodes;
+}
@@ -0,0 +1,79 @@
+/** @file
+ * Copyright (c) 2026, Arm Limited or its affiliates. All rights reserved.
+ * SPDX-License-Identifier : Apache-2.0
+
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ **/
+
+
+#ifndef __APMT_PROF_H__
+#define __APMT_PROF_H__
+
+#include "perf_util.h"
+#include "traffic_gen.h"
+
+#define APMT_PROF_MAX_NODES   8
+#define APMT_PROF_MAX_MON     4
+#define APMT_PROF_RING_SIZE   64      /* Power of two */
+#define APMT_PROF_PERIOD_NS   100000
+#define APMT_PROF_ROUNDS      32      /* Traffic chunks, a poll after each */
+
+/* Monitor sets programmed on every memory node by apmt_prof_run */
+typedef enum {
+  APMT_PROF_BANDWIDTH = 0,            /* Inbound total, read and write bandwidth */
+  APMT_PROF_LATENCY,                  /* Inbound open and total transactions */
+  APMT_PROF_NUMA                      /* Local, remote and all bandwidth */
+} APMT_PROF_KIND;
+
+typedef struct {
+  uint64_t ts;                                        /* Ticks since the profile started */
+  uint64_t delta[APMT_PROF_MAX_NODES][APMT_PROF_MAX_MON];  /* Counts since the previous one */
+} APMT_PROF_SAMPLE;
+
+typedef struct {
+  uint32_t node_index;                /* APMT node */
+  uint32_t num_mon;
+  uint32_t ctr[APMT_PROF_MAX_MON];    /* Monitor index on the node */
+  uint32_t event[APMT_PROF_MAX_MON];  /* Event counted by the monitor */
+  uint64_t wrap;                      /* Mask of the implemented counter bits */
+  uint64_t last[APMT_PROF_MAX_MON];   /* Raw counter values at the last sample */
+  uint64_t total[APMT_PROF_MAX_MON];  /* Counts since the start, extended to 64 bits */
+} APMT_PROF_NODE;
+
+/* Samples every monitor of every profiled APMT node into a ring holding the
+ * latest APMT_PROF_RING_SIZE samples. The traffic source calls apmt_prof_poll
+ * between operations, a sample is taken whenever the period elapsed. Counters
+ * narrower than 64 bits are extended as long as they wrap at most once a period.
+ */
+typedef struct {
+  uint64_t period;                    /* Sampling period in ticks */
+  uint64_t start_ts;
+  uint64_t last_ts;
+  uint32_t num_nodes;
+  APMT_PROF_NODE node[APMT_PROF_MAX_NODES];
+  uint32_t head;                      /* Samples taken, the ring keeps the last ones */
+  APMT_PROF_SAMPLE ring[APMT_PROF_RING_SIZE];
+} APMT_PROF;
+
+uint64_t apmt_prof_wrap(uint32_t node_index);
+void     apmt_prof_init(APMT_PROF *prof, uint64_t period_ns);
+uint32_t apmt_prof_add_monitor(APMT_PROF *prof, uint32_t node_index, uint32_t mon,
+                               uint32_t event);
+void     apmt_prof_start(APMT_PROF *prof);
+void     apmt_prof_poll(APMT_PROF *prof);
+void     apmt_prof_stop(APMT_PROF *prof);
+void     apmt_prof_traffic(APMT_PROF *prof, TGEN_CFG *cfg, uint64_t span, uint32_t rounds);
+void     apmt_prof_report(APMT_PROF *prof);
+uint32_t apmt_prof_run(uint32_t kind);
+
+#endif /* __APMT_PROF_H__ */
@@ -0,0 +1,250 @@
+/** @file
+ * Copyright (c) 2026, Arm Limited or its affiliates. All rights reserved.
+ * SPDX-License-Identifier : Apache-2.0
+
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ **/
+
+
+#include "val/common/include/acs_val.h"
+#include "val/sbsa/include/sbsa_val_interface.h"
+
+#include "val/sbsa/include/sbsa_acs_smmu.h"
+
+#include "smmu_caps.h"
+#include "smmu_cmdq.h"
+#include "cmdq_bench.h"
+
+#define CMDQ_BENCH_ASID     0xA5
+#define CMDQ_BENCH_VA       0x40000000ULL
+
+typedef struct {
+  char8_t  *name;
+  uint64_t dw0;
+  uint64_t dw1;
+  uint32_t pages;          /* Pages invalidated by one command */
+} CMDQ_BENCH_CMD;
+
+static CMDQ_BENCH_CMD cmdq_cmd[] = {
+  {"TLBI_NH_VA   ", SMMU_CMDQ_OP_TLBI_NH_VA | SMMU_CMDQ_ASID(CMDQ_BENCH_ASID),
+                    CMDQ_BENCH_VA | SMMU_CMDQ_LEAF, 1},
+  {"TLBI_NH_VA rg", SMMU_CMDQ_OP_TLBI_NH_VA | SMMU_CMDQ_ASID(CMDQ_BENCH_ASID) |
+                    SMMU_CMDQ_RANGE_NUM(CMDQ_BENCH_RANGE_PAGES - 1) | SMMU_CMDQ_RANGE_SCALE(0),
+                    CMDQ_BENCH_VA | SMMU_CMDQ_TG_4KB | SMMU_CMDQ_LEAF, CMDQ_BENCH_RANGE_PAGES},
+  {"CFGI_STE     ", SMMU_CMDQ_OP_CFGI_STE | SMMU_CMDQ_SID(0), SMMU_CMDQ_LEAF, 0},
+};
+
+#define CMDQ_CMD_VA     0
+#define CMDQ_CMD_RANGE  1
+#define CMDQ_CMD_STE    2
+#define CMDQ_CMD_NUM    (sizeof(cmdq_cmd) / sizeof(cmdq_cmd[0]))
+
+/**
+  @brief   Time batch commands followed by a CMD_SYNC, from the first queue
+           write until the SMMU consumed the CMD_SYNC.
+
+  @return  Average ns per batch, 0 on error.
+**/
+static
+uint64_t
+cmdq_bench_batch(SMMU_CMDQ *q, CMDQ_BENCH_CMD *cmd, uint32_t batch)
+{
+  uint32_t round, idx;
+  uint64_t start;
+  PERF_STATS ns;
+
+  perf_stats_init(&ns);
+
+  for (round = 0; round < CMDQ_BENCH_ROUNDS; round++) {
+      start = perf_get_ticks();
+
+      for (idx = 0; idx < batch; idx++)
+          smmu_cmdq_push(q, cmd->dw0, cmd->dw1);
+
+      smmu_cmdq_push(q, SMMU_CMDQ_OP_SYNC, 0);
+      smmu_cmdq_doorbell(q);
+      if (smmu_cmdq_drain(q))
+          return 0;
+
+      perf_stats_add(&ns, perf_ticks_to_ns(perf_get_ticks() - start));
+  }
+
+  return perf_stats_avg(&ns);
+}
+
+/**
+  @brief   Stream commands with one doorbell per command, never letting more
+           than depth commands be outstanding.
+
+  @return  Average ns per command, 0 on error.
+**/
+static
+uint64_t
+cmdq_bench_stream(SMMU_CMDQ *q, CMDQ_BENCH_CMD *cmd, uint32_t depth)
+{
+  uint32_t idx;
+  uint32_t timeout;
+  uint64_t start;
+
+  start = perf_get_ticks();
+
+  for (idx = 0; idx < CMDQ_BENCH_STREAM_CMDS; idx++) {
+      timeout = SMMU_CMDQ_TIMEOUT;
+      while (smmu_cmdq_used(q) >= depth && timeout--)
+          ;
+
+      smmu_cmdq_push(q, cmd->dw0, cmd->dw1);
+      smmu_cmdq_doorbell(q);
+  }
+
+  smmu_cmdq_push(q, SMMU_CMDQ_OP_SYNC, 0);
+  smmu_cmdq_doorbell(q);
+  if (smmu_cmdq_drain(q))
+      return 0;
+
+  return perf_ticks_to_ns(perf_get_ticks() - start) / CMDQ_BENCH_STREAM_CMDS;
+}
+
+static
+void
+cmdq_bench_sync_latency(SMMU_CMDQ *q)
+{
+  uint32_t round;
+  uint64_t start;
+  PERF_STATS ns;
+
+  perf_stats_init(&ns);
+
+  for (round = 0; round < CMDQ_BENCH_ROUNDS; round++) {
+      smmu_cmdq_push(q, SMMU_CMDQ_OP_SYNC, 0);
+
+      start = perf_get_ticks();
+      smmu_cmdq_doorbell(q);
+      if (smmu_cmdq_drain(q))
+          break;
+
+      perf_stats_add(&ns, perf_ticks_to_ns(perf_get_ticks() - start));
+  }
+
+  perf_stats_print(ACS_PRINT_TEST, "\n       CMD_SYNC latency (ns)", &ns);
+}
+
+/**
+  @brief   Measure the command queue of one SMMU and print its tables.
+**/
+static
+void
+cmdq_bench_smmu(SMMU_CMDQ *q, SMMU_CAPS *caps)
+{
+  uint32_t idx;
+  uint32_t batch, depth, max_batch;
+  uint64_t ns;
+  uint64_t single_ns = 0, range_ns = 0;
+  CMDQ_BENCH_CMD *cmd;
+
+  /* One slot is kept for the CMD_SYNC closing a batch */
+  max_batch = smmu_cmdq_entries(q) - 1;
+  if (max_batch > CMDQ_BENCH_MAX_BATCH)
+      max_batch = CMDQ_BENCH_MAX_BATCH;
+
+  val_print(ACS_PRINT_TEST, "\n       SMMU %d command queue", q->smmu_index);
+  val_print(ACS_PRINT_TEST, ", %d entries", smmu_cmdq_entries(q));
+
+  cmdq_bench_sync_latency(q);
+
+  val_print(ACS_PRINT_TEST,
+            "\n       Command        Batch  ns/batch    cmds/s   pages/s", 0);
+
+  for (idx = 0; idx < CMDQ_CMD_NUM; idx++) {
+      cmd = &cmdq_cmd[idx];
+
+      /* Stage 1 TLB maintenance is illegal without stage 1 support */
+      if (idx != CMDQ_CMD_STE && !caps->s1p)
+          continue;
+      if (idx == CMDQ_CMD_RANGE && !caps->ril)
+          continue;
+
+      for (batch = 1; batch <= max_batch; batch <<= 1) {
+          ns = cmdq_bench_batch(q, cmd, batch);
+          if (!ns) {
+              val_print(ACS_PRINT_WARN, "\n       Command error 0x%x", q->error);
+              return;
+          }
+
+          val_print(ACS_PRINT_TEST, "\n       ", 0);
+          val_print(ACS_PRINT_TEST, cmd->name, 0);
+          val_print(ACS_PRINT_TEST, "  %5d", batch);
+          val_print(ACS_PRINT_TEST, " %9d", ns);
+          val_print(ACS_PRINT_TEST, " %9d", (batch * 1000000000ULL) / ns);
+          val_print(ACS_PRINT_TEST, " %9d", (batch * cmd->pages * 1000000000ULL) / ns);
+      }
+  }
+
+  cmd = caps->s1p ? &cmdq_cmd[CMDQ_CMD_VA] : &cmdq_cmd[CMDQ_CMD_STE];
+  val_print(ACS_PRINT_TEST, "\n       Depth  ns/cmd    cmds/s  (", 0);
+  val_print(ACS_PRINT_TEST, cmd->name, 0);
+  val_print(ACS_PRINT_TEST, ")", 0);
+
+  for (depth = 1; depth <= max_batch; depth <<= 1) {
+      ns = cmdq_bench_stream(q, cmd, depth);
+      if (!ns)
+          return;
+
+      val_print(ACS_PRINT_TEST, "\n       %5d", depth);
+      val_print(ACS_PRINT_TEST, " %7d", ns);
+      val_print(ACS_PRINT_TEST, " %9d", 1000000000ULL / ns);
+  }
+
+  /* Same span invalidated with per page TLBIs and with one range TLBI */
+  if (caps->s1p && caps->ril && max_batch >= CMDQ_BENCH_RANGE_PAGES) {
+      single_ns = cmdq_bench_batch(q, &cmdq_cmd[CMDQ_CMD_VA], CMDQ_BENCH_RANGE_PAGES);
+      range_ns = cmdq_bench_batch(q, &cmdq_cmd[CMDQ_CMD_RANGE], 1);
+
+      val_print(ACS_PRINT_TEST, "\n       %d pages invalidated in", CMDQ_BENCH_RANGE_PAGES);
+      val_print(ACS_PRINT_TEST, " %d ns by page", single_ns);
+      val_print(ACS_PRINT_TEST, ", %d ns by range", range_ns);
+  }
+}
+
+/**
+  @brief   Run the command queue benchmark on every SMMUv3.
+
+  @return  Number of SMMUs measured.
+**/
+uint32_t
+cmdq_bench_run(void)
+{
+  uint32_t idx;
+  uint32_t measured = 0;
+  SMMU_CAPS *caps;
+  SMMU_CMDQ q;
+
+  for (idx = 0; idx < smmu_caps_num(); idx++) {
+      caps = smmu_caps_get(idx);
+      if (caps->arch_major < 3)
+          continue;
+
+      if (smmu_cmdq_attach(&q, idx))
+          continue;
+
+      cmdq_bench_smmu(&q, caps);
+      smmu_cmdq_detach(&q);
+
+      if (q.error)
+          val_print(ACS_PRINT_WARN, "\n       SMMU %d rejected a benchmark command", idx);
+
+      measured++;
+  }
+
+  return measured;
+}
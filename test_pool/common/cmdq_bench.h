@@ -0,0 +1,31 @@
+/** @file
+ * Copyright (c) 2026, Arm Limited or its affiliates. All rights reserved.
+ * SPDX-License-Identifier : Apache-2.0
+
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ **/
+
+
+#ifndef __CMDQ_BENCH_H__
+#define __CMDQ_BENCH_H__
+
+#include "perf_util.h"
+
+#define CMDQ_BENCH_ROUNDS        32
+#define CMDQ_BENCH_MAX_BATCH     64
+#define CMDQ_BENCH_STREAM_CMDS   256
+#define CMDQ_BENCH_RANGE_PAGES   32     /* 4KB pages covered by one range TLBI */
+
+uint32_t cmdq_bench_run(void);
+
+#endif /* __CMDQ_BENCH_H__ */
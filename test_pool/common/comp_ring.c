@@ -0,0 +1,98 @@
+/** @file
+ * Copyright (c) 2026, Arm Limited or its affiliates. All rights reserved.
+ * SPDX-License-Identifier : Apache-2.0
+
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ **/
+
+#include "val/common/include/acs_val.h"
+
+#include "comp_ring.h"
+
+/* Order the entry payload against the index update that publishes it */
+#define COMP_RING_BARRIER()  __asm__ volatile ("dmb ish" : : : "memory")
+
+void
+comp_ring_init(COMP_RING *ring, COMP_RING_ENTRY *buf, uint32_t size)
+{
+  ring->head    = 0;
+  ring->tail    = 0;
+  ring->dropped = 0;
+  ring->size    = size;
+  ring->entry   = buf;
+}
+
+/**
+  @brief   Producer side, safe to call from an interrupt handler.
+
+  @param   ring       Completion ring
+  @param   int_id     Interrupt ID being completed
+  @param   data       Caller defined payload
+  @param   timestamp  Time of completion
+  @return  0 on success, 1 if the ring was full and the entry dropped.
+**/
+uint32_t
+comp_ring_push(COMP_RING *ring, uint32_t int_id, uint32_t data, uint64_t timestamp)
+{
+  uint32_t head = ring->head;
+  COMP_RING_ENTRY *entry;
+
+  if ((head - ring->tail) >= ring->size) {
+      ring->dropped++;
+      return 1;
+  }
+
+  entry = &ring->entry[head & (ring->size - 1)];
+  entry->timestamp = timestamp;
+  entry->int_id    = int_id;
+  entry->data      = data;
+
+  COMP_RING_BARRIER();
+  ring->head = head + 1;
+
+  return 0;
+}
+
+/**
+  @brief   Consumer side, pops the oldest completion.
+
+  @param   ring   Completion ring
+  @param   entry  Filled with the popped completion
+  @return  1 if an entry was popped, 0 if the ring is empty.
+**/
+uint32_t
+comp_ring_pop(COMP_RING *ring, COMP_RING_ENTRY *entry)
+{
+  uint32_t tail = ring->tail;
+  COMP_RING_ENTRY *slot;
+
+  if (tail == ring->head)
+      return 0;
+
+  COMP_RING_BARRIER();
+  slot = &ring->entry[tail & (ring->size - 1)];
+  entry->timestamp = slot->timestamp;
+  entry->int_id    = slot->int_id;
+  entry->data      = slot->data;
+
+  COMP_RING_BARRIER();
+  ring->tail = tail + 1;
+
+  return 1;
+}
+
+uint32_t
+comp_ring_count(COMP_RING *ring)
+{
+  return ring->head - ring->tail;
+}
@@ -0,0 +1,45 @@
+/** @file
+ * Copyright (c) 2026, Arm Limited or its affiliates. All rights reserved.
+ * SPDX-License-Identifier : Apache-2.0
+
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ **/
+
+#ifndef __COMP_RING_H__
+#define __COMP_RING_H__
+
+/* Completion record pushed by an interrupt handler */
+typedef struct {
+  uint64_t timestamp;
+  uint32_t int_id;
+  uint32_t data;
+} COMP_RING_ENTRY;
+
+/* Single producer (ISR) / single consumer ring. The producer only moves head
+ * and the consumer only moves tail, so no lock is needed between them.
+ * size must be a power of two.
+ */
+typedef struct {
+  volatile uint32_t head;
+  volatile uint32_t tail;
+  volatile uint32_t dropped;
+  uint32_t size;
+  COMP_RING_ENTRY *entry;
+} COMP_RING;
+
+void     comp_ring_init(COMP_RING *ring, COMP_RING_ENTRY *buf, uint32_t size);
+uint32_t comp_ring_push(COMP_RING *ring, uint32_t int_id, uint32_t data, uint64_t timestamp);
+uint32_t comp_ring_pop(COMP_RING *ring, COMP_RING_ENTRY *entry);
+uint32_t comp_ring_count(COMP_RING *ring);
+
+#endif /* __COMP_RING_H__ */
@@ -0,0 +1,393 @@
+/** @file
+ * Copyright (c) 2026, Arm Limited or its affiliates. All rights reserved.
+ * SPDX-License-Identifier : Apache-2.0
+
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ **/
+
+
+#include "val/common/include/acs_val.h"
+#include "val/common/include/acs_pe.h"
+#include "val/common/include/acs_memory.h"
+#include "val/sbsa/include/sbsa_val_interface.h"
+#include "val/sbsa/include/sbsa_acs_memory.h"
+#include "val/sbsa/include/sbsa_acs_mpam.h"
+
+#include "pe_sync.h"
+#include "traffic_gen.h"
+#include "mpam_index.h"
+#include "mpam_msc.h"
+#include "cpor_bench.h"
+
+#define CPOR_BENCH_VICTIM_PARTID  1
+#define CPOR_BENCH_NOISY_PARTID   2
+#define CPOR_BENCH_VICTIM_MON     0
+#define CPOR_BENCH_NOISY_MON      1
+
+static CPOR_SCENARIO cpor_scenario[] = {
+  {"Victim alone    ", 0, 0},
+  {"Shared LLC      ", 1, 0},
+  {"CPOR partitioned", 1, 1}
+};
+
+#define CPOR_BENCH_NUM_SCENARIO  (sizeof(cpor_scenario) / sizeof(cpor_scenario[0]))
+
+static uint32_t cpor_saved_cpbm[2][CPOR_BENCH_MAX_CPBM];
+static uint64_t cpor_stream_buf;
+static uint64_t cpor_stream_size;
+static volatile uint64_t cpor_sink;
+
+/**
+  @brief   Tag the data accesses of the calling PE with a PARTID.
+
+  @return  Previous MPAM2_EL2 value, to be restored by the caller.
+**/
+static
+uint64_t
+cpor_bench_set_partid(uint32_t partid)
+{
+  uint64_t mpam2_el2 = val_mpam_reg_read(MPAM2_EL2);
+  uint64_t value;
+
+  value = (mpam2_el2 & ~(MPAMn_ELx_PARTID_D_MASK << MPAMn_ELx_PARTID_D_SHIFT)) |
+          ((uint64_t)partid << MPAMn_ELx_PARTID_D_SHIFT);
+  value = (value & ~(MPAMn_ELx_PMG_D_MASK << MPAMn_ELx_PMG_D_SHIFT)) |
+          ((uint64_t)DEFAULT_PMG << MPAMn_ELx_PMG_D_SHIFT);
+  val_mpam_reg_write(MPAM2_EL2, value);
+
+  return mpam2_el2;
+}
+
+/**
+  @brief   Noisy neighbour on a secondary PE, streams through a buffer far
+           larger than the LLC until stopped.
+**/
+static
+void
+cpor_bench_noisy(uint32_t slot)
+{
+  TGEN_CFG traffic = {TGEN_OP_COPY, TGEN_PATTERN_SEQ, 0, 0, 1, 0, 0, 0, 0};
+  uint64_t mpam2_el2;
+
+  (void)slot;
+
+  traffic.size = cpor_stream_size / 2;
+  traffic.src  = cpor_stream_buf;
+  traffic.dst  = cpor_stream_buf + traffic.size;
+
+  mpam2_el2 = cpor_bench_set_partid(CPOR_BENCH_NOISY_PARTID);
+
+  while (!pe_sync_stopping())
+      tgen_run(&traffic);
+
+  val_mpam_reg_write(MPAM2_EL2, mpam2_el2);
+}
+
+static
+uint32_t
+cpor_bench_read_csu(uint64_t msc_base, MPAM_RSRC *rsrc, uint32_t mon)
+{
+  uint32_t sel = mon;
+
+  if (rsrc->ris)
+      sel |= MSMON_CFG_MON_SEL_RIS(rsrc->rsrc_index);
+
+  val_mmio_write(msc_base + MSMON_CFG_MON_SEL, sel);
+  return MSMON_CSU_VALUE(val_mmio_read(msc_base + MSMON_CSU));
+}
+
+static
+void
+cpor_bench_part_sel(uint64_t msc_base, MPAM_RSRC *rsrc, uint32_t partid)
+{
+  uint32_t sel = partid;
+
+  if (rsrc->ris)
+      sel |= MPAMCFG_PART_SEL_RIS(rsrc->rsrc_index);
+
+  val_mmio_write(msc_base + MPAMCFG_PART_SEL, sel);
+}
+
+/**
+  @brief   Program the portion bitmaps of both PARTIDs. Partitioned gives the
+           victim the low CPOR_BENCH_VICTIM_PCT of the portions and the noisy
+           neighbour the rest, else both may allocate in the whole cache.
+**/
+static
+void
+cpor_bench_set_cpbm(uint64_t msc_base, MPAM_RSRC *rsrc, uint32_t cpbm_wd, uint32_t partition)
+{
+  uint32_t victim_bits = (cpbm_wd * CPOR_BENCH_VICTIM_PCT) / 100;
+  uint32_t words = (cpbm_wd + 31) / 32;
+  uint32_t word, bit;
+  uint32_t victim, noisy;
+
+  for (word = 0; word < words; word++) {
+      victim = 0;
+      noisy  = 0;
+      for (bit = 0; bit < 32 && (word * 32 + bit) < cpbm_wd; bit++) {
+          if (!partition || (word * 32 + bit) < victim_bits)
+              victim |= 1u << bit;
+          if (!partition || (word * 32 + bit) >= victim_bits)
+              noisy |= 1u << bit;
+      }
+
+      cpor_bench_part_sel(msc_base, rsrc, CPOR_BENCH_VICTIM_PARTID);
+      val_mmio_write(msc_base + MPAMCFG_CPBM + 4 * word, victim);
+      cpor_bench_part_sel(msc_base, rsrc, CPOR_BENCH_NOISY_PARTID);
+      val_mmio_write(msc_base + MPAMCFG_CPBM + 4 * word, noisy);
+  }
+}
+
+static
+void
+cpor_bench_save_cpbm(uint64_t msc_base, MPAM_RSRC *rsrc, uint32_t words, uint32_t restore)
+{
+  uint32_t part, word;
+
+  for (part = 0; part < 2; part++) {
+      cpor_bench_part_sel(msc_base, rsrc, CPOR_BENCH_VICTIM_PARTID + part);
+      for (word = 0; word < words; word++) {
+          if (restore)
+              val_mmio_write(msc_base + MPAMCFG_CPBM + 4 * word, cpor_saved_cpbm[part][word]);
+          else
+              cpor_saved_cpbm[part][word] = val_mmio_read(msc_base + MPAMCFG_CPBM + 4 * word);
+      }
+  }
+}
+
+/**
+  @brief   Sample the victim pointer chase latency and both CSU monitors
+           while the scenario runs.
+**/
+static
+void
+cpor_bench_scenario(CPOR_SCENARIO *scn, uint64_t msc_base, MPAM_RSRC *rsrc,
+                    uint64_t chain, uint64_t chain_size, uint32_t noisy_pe, uint32_t test_num)
+{
+  CPOR_SAMPLE *smp;
+  uint64_t mpam2_el2;
+  uint64_t ptr = chain;
+  uint64_t t0, start, end;
+  uint32_t idx;
+
+  scn->num_samples = 0;
+
+  if (scn->noisy && pe_sync_launch(1, &noisy_pe, cpor_bench_noisy, test_num)) {
+      pe_sync_wait();
+      return;
+  }
+
+  mpam2_el2 = cpor_bench_set_partid(CPOR_BENCH_VICTIM_PARTID);
+
+  /* Warm the victim working set into its portion */
+  ptr = tgen_chase(ptr, chain_size / CPOR_BENCH_LINE_SIZE);
+
+  t0 = perf_get_ticks();
+  for (idx = 0; idx < CPOR_BENCH_SAMPLES; idx++) {
+      start = perf_get_ticks();
+      ptr = tgen_chase(ptr, CPOR_BENCH_WINDOW);
+      end = perf_get_ticks();
+
+      smp = &scn->sample[idx];
+      smp->ticks      = end - t0;
+      smp->load_ps    = (perf_ticks_to_ns(end - start) * 1000) / CPOR_BENCH_WINDOW;
+      smp->victim_csu = cpor_bench_read_csu(msc_base, rsrc, CPOR_BENCH_VICTIM_MON);
+      smp->noisy_csu  = cpor_bench_read_csu(msc_base, rsrc, CPOR_BENCH_NOISY_MON);
+      scn->num_samples++;
+  }
+
+  val_mpam_reg_write(MPAM2_EL2, mpam2_el2);
+  cpor_sink = ptr;
+
+  if (scn->noisy) {
+      pe_sync_stop();
+      pe_sync_wait();
+  }
+}
+
+static
+void
+cpor_bench_report(MPAM_RSRC *rsrc, uint64_t cache_size)
+{
+  CPOR_SCENARIO *scn;
+  CPOR_SAMPLE *smp;
+  PERF_STATS lat;
+  uint64_t victim_csu, noisy_csu;
+  uint32_t idx, num;
+
+  val_print(ACS_PRINT_TEST, "\n       CPOR isolation, MSC %d", rsrc->msc_index);
+  val_print(ACS_PRINT_TEST, " rsrc %d", rsrc->rsrc_index);
+  val_print(ACS_PRINT_TEST, " LLC 0x%llx bytes", cache_size);
+  val_print(ACS_PRINT_TEST, "\n         Scenario          Lat avg ps  Lat max ps"
+                            "  Victim CSU  Noisy CSU", 0);
+
+  for (idx = 0; idx < CPOR_BENCH_NUM_SCENARIO; idx++) {
+      scn = &cpor_scenario[idx];
+      perf_stats_init(&lat);
+      victim_csu = 0;
+      noisy_csu  = 0;
+
+      for (num = 0; num < scn->num_samples; num++) {
+          smp = &scn->sample[num];
+          perf_stats_add(&lat, smp->load_ps);
+          victim_csu += smp->victim_csu;
+          noisy_csu  += smp->noisy_csu;
+      }
+
+      val_print(ACS_PRINT_TEST, "\n         ", 0);
+      val_print(ACS_PRINT_TEST, scn->name, 0);
+      if (scn->num_samples == 0) {
+          val_print(ACS_PRINT_TEST, "  not run", 0);
+          continue;
+      }
+
+      val_print(ACS_PRINT_TEST, "  %10d", perf_stats_avg(&lat));
+      val_print(ACS_PRINT_TEST, "  %10d", lat.max);
+      val_print(ACS_PRINT_TEST, "  %10d", victim_csu / scn->num_samples);
+      val_print(ACS_PRINT_TEST, "  %9d", noisy_csu / scn->num_samples);
+  }
+
+  /* Time series, one line per sample */
+  for (idx = 0; idx < CPOR_BENCH_NUM_SCENARIO; idx++) {
+      scn = &cpor_scenario[idx];
+      val_print(ACS_PRINT_INFO, "\n       ", 0);
+      val_print(ACS_PRINT_INFO, scn->name, 0);
+      val_print(ACS_PRINT_INFO, " time series: us, lat ps, victim CSU, noisy CSU", 0);
+
+      for (num = 0; num < scn->num_samples; num++) {
+          smp = &scn->sample[num];
+          val_print(ACS_PRINT_INFO, "\n         %8d", perf_ticks_to_ns(smp->ticks) / 1000);
+          val_print(ACS_PRINT_INFO, "  %8d", smp->load_ps);
+          val_print(ACS_PRINT_INFO, "  %10d", smp->victim_csu);
+          val_print(ACS_PRINT_INFO, "  %10d", smp->noisy_csu);
+      }
+  }
+}
+
+/**
+  @brief   Run a latency sensitive pointer chase sized to its LLC portion
+           beside a noisy neighbour streaming far more than the LLC, each
+           with its own PARTID. The victim latency and the CSU occupancy of
+           both PARTIDs are sampled alone, sharing the LLC and with disjoint
+           CPOR portions. Results are informational only.
+
+  @param   test_num  Test the secondary PE status is reported against
+**/
+void
+cpor_bench_run(uint32_t test_num)
+{
+  MPAM_RSRC *llc_rsrc;
+  MPAM_RSRC *mon_rsrc = NULL;
+  uint64_t msc_base;
+  uint64_t cache_id, cache_size;
+  uint64_t chain, chain_size;
+  uint32_t llc_index;
+  uint32_t rsrc_cnt;
+  uint32_t cpbm_wd = 0;
+  uint32_t noisy_pe;
+  uint32_t idx;
+
+  llc_index = val_cache_get_llc_index();
+  if (llc_index == CACHE_TABLE_EMPTY)
+      return;
+
+  cache_id   = val_cache_get_info(CACHE_ID, llc_index);
+  cache_size = val_cache_get_info(CACHE_SIZE, llc_index);
+  if (cache_id == INVALID_CACHE_INFO || cache_size == INVALID_CACHE_INFO || cache_size == 0)
+      return;
+
+  /* The first LLC resource with CPOR and two CSU monitors is measured */
+  rsrc_cnt = mpam_index_find(MPAM_RSRC_TYPE_PE_CACHE, cache_id, &llc_rsrc);
+  for (idx = 0; idx < rsrc_cnt; idx++) {
+      if (llc_rsrc[idx].cpor && llc_rsrc[idx].csumon && llc_rsrc[idx].csumon_count >= 2 &&
+          llc_rsrc[idx].max_partid >= CPOR_BENCH_NOISY_PARTID) {
+          mon_rsrc = &llc_rsrc[idx];
+          break;
+      }
+  }
+
+  if (mon_rsrc == NULL || pe_sync_select(1, &noisy_pe) == 0) {
+      val_print(ACS_PRINT_TEST, "\n       CPOR bench needs an LLC MSC with CPOR, 2 CSU monitors"
+                                " and a secondary PE", 0);
+      return;
+  }
+
+  msc_base = val_mpam_get_info(MPAM_MSC_BASE_ADDR, mon_rsrc->msc_index, 0);
+  if (mon_rsrc->ris)
+      val_mpam_memory_configure_ris_sel(mon_rsrc->msc_index, mon_rsrc->rsrc_index);
+
+  cpbm_wd = MPAMF_CPOR_IDR_CPBM_WD(val_mmio_read(msc_base + MPAMF_CPOR_IDR));
+  if (cpbm_wd < 2 || cpbm_wd > CPOR_BENCH_MAX_CPBM * 32) {
+      val_print(ACS_PRINT_TEST, "\n       CPOR bench unsupported CPBM width %d", cpbm_wd);
+      return;
+  }
+
+  /* Victim working set fits well inside its portion */
+  chain_size = ((cache_size * CPOR_BENCH_VICTIM_PCT) / 100) * 3 / 4;
+  chain_size &= ~((uint64_t)CPOR_BENCH_LINE_SIZE - 1);
+
+  cpor_stream_size = 4 * cache_size;
+  if (cpor_stream_size > CPOR_BENCH_MAX_STREAM)
+      cpor_stream_size = CPOR_BENCH_MAX_STREAM;
+
+  chain = (uint64_t)val_aligned_alloc(MEM_ALIGN_4K, chain_size);
+  cpor_stream_buf = 0;
+  while (cpor_stream_size > cache_size) {
+      cpor_stream_buf = (uint64_t)val_aligned_alloc(MEM_ALIGN_4K, cpor_stream_size);
+      if (cpor_stream_buf)
+          break;
+      cpor_stream_size /= 2;
+  }
+
+  if (chain == 0 || cpor_stream_buf == 0) {
+      val_print(ACS_PRINT_TEST, "\n       CPOR bench buffer allocation failed", 0);
+      if (chain)
+          val_memory_free_aligned((void *)chain);
+      if (cpor_stream_buf)
+          val_memory_free_aligned((void *)cpor_stream_buf);
+      return;
+  }
+
+  val_data_cache_ops_by_va((addr_t)&cpor_stream_buf, CLEAN_AND_INVALIDATE);
+  val_data_cache_ops_by_va((addr_t)&cpor_stream_size, CLEAN_AND_INVALIDATE);
+  tgen_chain_build(chain, chain_size);
+
+  cpor_bench_save_cpbm(msc_base, mon_rsrc, (cpbm_wd + 31) / 32, 0);
+
+  /* One CSU monitor per PARTID, left selected and enabled */
+  val_mpam_configure_csu_mon(mon_rsrc->msc_index, CPOR_BENCH_VICTIM_PARTID, DEFAULT_PMG,
+                             CPOR_BENCH_VICTIM_MON);
+  val_mpam_csumon_enable(mon_rsrc->msc_index);
+  val_mpam_configure_csu_mon(mon_rsrc->msc_index, CPOR_BENCH_NOISY_PARTID, DEFAULT_PMG,
+                             CPOR_BENCH_NOISY_MON);
+  val_mpam_csumon_enable(mon_rsrc->msc_index);
+
+  for (idx = 0; idx < CPOR_BENCH_NUM_SCENARIO; idx++) {
+      cpor_bench_set_cpbm(msc_base, mon_rsrc, cpbm_wd, cpor_scenario[idx].partition);
+      cpor_bench_scenario(&cpor_scenario[idx], msc_base, mon_rsrc, chain, chain_size,
+                          noisy_pe, test_num);
+  }
+
+  cpor_bench_read_csu(msc_base, mon_rsrc, CPOR_BENCH_NOISY_MON);
+  val_mpam_csumon_disable(mon_rsrc->msc_index);
+  cpor_bench_read_csu(msc_base, mon_rsrc, CPOR_BENCH_VICTIM_MON);
+  val_mpam_csumon_disable(mon_rsrc->msc_index);
+
+  cpor_bench_save_cpbm(msc_base, mon_rsrc, (cpbm_wd + 31) / 32, 1);
+
+  val_memory_free_aligned((void *)chain);
+  val_memory_free_aligned((void *)cpor_stream_buf);
+
+  cpor_bench_report(mon_rsrc, cache_size);
+}
@@ -0,0 +1,49 @@
+/** @file
+ * Copyright (c) 2026, Arm Limited or its affiliates. All rights reserved.
+ * SPDX-License-Identifier : Apache-2.0
+
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ **/
+
+
+#ifndef __CPOR_BENCH_H__
+#define __CPOR_BENCH_H__
+
+#include "perf_util.h"
+
+#define CPOR_BENCH_SAMPLES      32
+#define CPOR_BENCH_WINDOW       4096        /* Pointer chase loads per sample */
+#define CPOR_BENCH_LINE_SIZE    64
+#define CPOR_BENCH_MAX_STREAM   0x4000000   /* Noisy neighbour buffer cap, 64 MB */
+#define CPOR_BENCH_MAX_CPBM     32          /* 32 bit words of CPBM saved, 1024 portions */
+#define CPOR_BENCH_VICTIM_PCT   50          /* LLC portion given to the victim */
+
+/* One sampling window of the victim */
+typedef struct {
+  uint64_t ticks;          /* End of the window, from the start of the run */
+  uint64_t load_ps;        /* Average pointer chase load latency in ps */
+  uint32_t victim_csu;     /* Occupancy of the victim PARTID in bytes */
+  uint32_t noisy_csu;      /* Occupancy of the noisy neighbour PARTID in bytes */
+} CPOR_SAMPLE;
+
+typedef struct {
+  char8_t     *name;
+  uint32_t    noisy;       /* Noisy neighbour running */
+  uint32_t    partition;   /* Disjoint portions programmed */
+  uint32_t    num_samples;
+  CPOR_SAMPLE sample[CPOR_BENCH_SAMPLES];
+} CPOR_SCENARIO;
+
+void cpor_bench_run(uint32_t test_num);
+
+#endif /* __CPOR_BENCH_H__ */
@@ -0,0 +1,374 @@
+/** @file
+ * Copyright (c) 2026, Arm Limited or its affiliates. All rights reserved.
+ * SPDX-License-Identifier : Apache-2.0
+
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ **/
+
+#include "val/common/include/acs_val.h"
+#include "val/sbsa/include/sbsa_val_interface.h"
+
+#include "val/sbsa/include/sbsa_acs_pe.h"
+#include "val/sbsa/include/sbsa_acs_smmu.h"
+#include "val/common/include/acs_pgt.h"
+#include "val/common/include/acs_pe.h"
+#include "val/sbsa/include/sbsa_acs_iovirt.h"
+#include "val/common/include/acs_iovirt.h"
+#include "val/sbsa/include/sbsa_acs_memory.h"
+#include "val/common/include/acs_pcie_enumeration.h"
+#include "val/sbsa/include/sbsa_acs_pcie.h"
+#include "val/sbsa/include/sbsa_acs_exerciser.h"
+
+#include "smmu_caps.h"
+#include "smmu_ctx.h"
+#include "route_map.h"
+#include "dma_bench.h"
+
+/* Stage 1 descriptors select the memory type through MAIR, stage 2 ones
+ * encode it directly in MemAttr.
+ */
+#define S1_ATTR_INDX_SHIFT   2
+#define S1_ATTR_INDX_MASK    0x7ull
+#define S2_MEMATTR_SHIFT     2
+#define S2_MEMATTR_MASK      0xFull
+#define S2_MEMATTR_NORMAL_WB 0xFull
+#define S2_MEMATTR_DEVICE    0x0ull
+#define S2AP_SHIFT           6
+#define S2AP_MASK            0x3ull
+#define S2AP_RW              0x3ull
+#define MAIR_DEVICE_nGnRnE   0x00
+
+#define DMA_BENCH_MAX_RESULTS  (DMA_XLAT_MAX * 2 * DMA_TARGET_MAX)
+
+static DMA_BENCH_RESULT result[DMA_BENCH_MAX_RESULTS];
+
+static char8_t *xlat_name[DMA_XLAT_MAX] = {"bypass ", "stage 1", "stage 2"};
+static char8_t *target_name[DMA_TARGET_MAX] = {"normal", "device"};
+
+/**
+  @brief   Return the MAIR index of a Device-nGnRnE attribute, -1 if none.
+**/
+static
+int32_t
+dma_bench_device_attr_index(uint64_t mair)
+{
+  uint32_t idx;
+
+  for (idx = 0; idx < 8; idx++) {
+      if (((mair >> (idx * 8)) & 0xFF) == MAIR_DEVICE_nGnRnE)
+          return idx;
+  }
+
+  return -1;
+}
+
+/**
+  @brief   Build the descriptor attributes of the test buffer for a given
+           translation stage and target memory type.
+
+  @param   s1_attr   Stage 1 attributes of the buffer in the PE page tables
+  @param   xlat      Translation stage
+  @param   target    Memory type seen by the DMA
+  @param   dev_indx  MAIR index of Device-nGnRnE
+  @return  Descriptor attributes.
+**/
+uint64_t
+dma_bench_attr(uint64_t s1_attr, uint32_t xlat, uint32_t target, int32_t dev_indx)
+{
+  uint64_t attr = s1_attr;
+
+  if (xlat == DMA_XLAT_STAGE2) {
+      attr &= ~((S2_MEMATTR_MASK << S2_MEMATTR_SHIFT) | (S2AP_MASK << S2AP_SHIFT));
+      attr |= (S2AP_RW << S2AP_SHIFT);
+      attr |= ((target == DMA_TARGET_DEVICE) ? S2_MEMATTR_DEVICE : S2_MEMATTR_NORMAL_WB)
+              << S2_MEMATTR_SHIFT;
+      return attr;
+  }
+
+  if (target == DMA_TARGET_DEVICE) {
+      attr &= ~(S1_ATTR_INDX_MASK << S1_ATTR_INDX_SHIFT);
+      attr |= ((uint64_t)dev_indx << S1_ATTR_INDX_SHIFT);
+  }
+
+  return attr | PGT_STAGE1_AP_RW;
+}
+
+/**
+  @brief   Time back to back DMAs between the exerciser and memory. A
+           direction stops at its first failed DMA, so only completed
+           transfers are counted.
+
+  @param   instance  Exerciser instance
+  @param   addr      Bus address of the buffer as seen by the exerciser
+  @param   len       Length of each DMA
+  @param   res       Result row to update
+**/
+static
+void
+dma_bench_measure(uint32_t instance, uint64_t addr, uint32_t len, DMA_BENCH_RESULT *res)
+{
+  uint32_t iter;
+  uint64_t start;
+  uint64_t end;
+
+  val_exerciser_set_param(DMA_ATTRIBUTES, addr, len, instance);
+  for (iter = 0; iter < DMA_BENCH_ITERATIONS; iter++) {
+      start = perf_get_ticks();
+      if (val_exerciser_ops(START_DMA, EDMA_TO_DEVICE, instance)) {
+          val_print(ACS_PRINT_DEBUG, "\n       DMA read failed for exerciser %d", instance);
+          break;
+      }
+      end = perf_get_ticks();
+      perf_stats_add(&res->read_ns, perf_ticks_to_ns(end - start));
+  }
+
+  val_exerciser_set_param(DMA_ATTRIBUTES, addr, len, instance);
+  for (iter = 0; iter < DMA_BENCH_ITERATIONS; iter++) {
+      start = perf_get_ticks();
+      if (val_exerciser_ops(START_DMA, EDMA_FROM_DEVICE, instance)) {
+          val_print(ACS_PRINT_DEBUG, "\n       DMA write failed for exerciser %d", instance);
+          break;
+      }
+      end = perf_get_ticks();
+      perf_stats_add(&res->write_ns, perf_ticks_to_ns(end - start));
+  }
+}
+
+static
+DMA_BENCH_RESULT *
+dma_bench_result(uint32_t *num_res, uint32_t xlat, uint32_t ats, uint32_t target)
+{
+  DMA_BENCH_RESULT *res = &result[(*num_res)++];
+
+  val_memory_set(res, sizeof(DMA_BENCH_RESULT), 0);
+  res->xlat = xlat;
+  res->ats = ats;
+  res->target = target;
+  perf_stats_init(&res->read_ns);
+  perf_stats_init(&res->write_ns);
+
+  return res;
+}
+
+static
+void
+dma_bench_report(uint32_t instance, uint32_t rc_index, uint32_t len, uint32_t num_res)
+{
+  uint32_t idx;
+  uint64_t avg;
+  DMA_BENCH_RESULT *res;
+
+  val_print(ACS_PRINT_TEST, "\n       DMA bandwidth, exerciser %d", instance);
+  val_print(ACS_PRINT_TEST, " RC %d", rc_index);
+  val_print(ACS_PRINT_TEST, ", %d bytes per DMA", len);
+  val_print(ACS_PRINT_TEST,
+            "\n       Translation  ATS  Target   Rd MB/s  Rd ns    Wr MB/s  Wr ns", 0);
+
+  for (idx = 0; idx < num_res; idx++) {
+      res = &result[idx];
+
+      val_print(ACS_PRINT_TEST, "\n       ", 0);
+      val_print(ACS_PRINT_TEST, xlat_name[res->xlat], 0);
+      val_print(ACS_PRINT_TEST, res->ats ? "      on   " : "      off  ", 0);
+      val_print(ACS_PRINT_TEST, target_name[res->target], 0);
+
+      avg = perf_stats_avg(&res->read_ns);
+      val_print(ACS_PRINT_TEST, "   %8d", avg ? ((uint64_t)len * 1000) / avg : 0);
+      val_print(ACS_PRINT_TEST, " %8d", avg);
+
+      avg = perf_stats_avg(&res->write_ns);
+      val_print(ACS_PRINT_TEST, " %8d", avg ? ((uint64_t)len * 1000) / avg : 0);
+      val_print(ACS_PRINT_TEST, " %8d", avg);
+  }
+}
+
+/**
+  @brief   Measure one exerciser across the translation regimes, ATS modes
+           and target memory types it supports.
+
+  @return  Number of rows measured.
+**/
+static
+uint32_t
+dma_bench_exerciser(uint32_t instance, void *buf_virt, uint64_t buf_phys, uint32_t len,
+                    pgt_descriptor_t *pgt_tmpl, uint64_t s1_attr, int32_t dev_indx)
+{
+  uint32_t e_bdf;
+  uint32_t erp_bdf;
+  uint32_t rc_index = ACS_INVALID_INDEX;
+  uint32_t cap_base;
+  uint32_t reg_value;
+  uint32_t device_id, its_id;
+  uint32_t xlat, ats, target;
+  uint32_t ats_supported = 0;
+  SMMU_CAPS *caps;
+  uint32_t num_res = 0;
+  uint64_t iova;
+  uint64_t addr;
+  uint64_t translated_addr;
+  uint64_t m_vir_addr;
+  memory_region_descriptor_t mem_desc;
+  pgt_descriptor_t pgt_desc;
+  smmu_master_attributes_t master;
+  DMA_BENCH_RESULT *res;
+
+  e_bdf = val_exerciser_get_bdf(instance);
+
+  if (!val_pcie_get_rootport(e_bdf, &erp_bdf))
+      rc_index = val_iovirt_get_rc_index(PCIE_EXTRACT_BDF_SEG(erp_bdf));
+
+  /* Bypass: the exerciser DMAs straight to the physical address */
+  val_memory_set(&master, sizeof(master), 0);
+  master.smmu_index = route_map_smmu_index(e_bdf);
+  if (master.smmu_index != ACS_INVALID_INDEX)
+      val_smmu_disable(master.smmu_index);
+
+  res = dma_bench_result(&num_res, DMA_XLAT_BYPASS, 0, DMA_TARGET_NORMAL);
+  dma_bench_measure(instance, buf_phys, len, res);
+
+  if (route_map_smmu_arch(e_bdf) != 3)
+      goto report;
+
+  val_smmu_enable(master.smmu_index);
+
+  if (route_map_device_info(e_bdf, &device_id, &master.streamid, &its_id))
+      goto report;
+
+  if ((rc_index != ACS_INVALID_INDEX) &&
+      val_iovirt_get_pcie_rc_info(RC_ATS_ATTRIBUTE, rc_index) &&
+      (val_pcie_find_capability(e_bdf, PCIE_ECAP, ECID_ATS, &cap_base) == PCIE_SUCCESS))
+      ats_supported = 1;
+
+  caps = smmu_caps_get(master.smmu_index);
+  if (caps == NULL)
+      goto report;
+
+  pgt_desc = *pgt_tmpl;
+  pgt_desc.ias = val_smmu_get_info(SMMU_IN_ADDR_SIZE, master.smmu_index);
+  pgt_desc.oas = val_smmu_get_info(SMMU_OUT_ADDR_SIZE, master.smmu_index);
+  if ((pgt_desc.ias == 0) || (pgt_desc.oas == 0))
+      goto report;
+
+  /* Same IOVA scheme as e002/e003: a per exerciser alias of the buffer */
+  iova = (uint64_t)buf_virt + instance * (len * 2);
+
+  for (xlat = DMA_XLAT_STAGE1; xlat < DMA_XLAT_MAX; xlat++) {
+      if (!((xlat == DMA_XLAT_STAGE1) ? caps->s1p : caps->s2p))
+          continue;
+
+      for (target = 0; target < DMA_TARGET_MAX; target++) {
+          if ((target == DMA_TARGET_DEVICE) && (xlat == DMA_XLAT_STAGE1) && (dev_indx < 0))
+              continue;
+
+          val_memory_set(&mem_desc, sizeof(mem_desc), 0);
+          mem_desc.virtual_address = iova;
+          mem_desc.physical_address = buf_phys;
+          mem_desc.length = len * 2;
+          mem_desc.attributes = dma_bench_attr(s1_attr, xlat, target, dev_indx);
+
+          master.stage2 = (xlat == DMA_XLAT_STAGE2);
+          pgt_desc.stage = (xlat == DMA_XLAT_STAGE2) ? PGT_STAGE2 : PGT_STAGE1;
+
+          if (smmu_ctx_map(&master, &mem_desc, &pgt_desc) == NULL) {
+              val_print(ACS_PRINT_DEBUG, "\n       SMMU mapping failed, skipping xlat %d", xlat);
+              continue;
+          }
+
+          for (ats = 0; ats <= ats_supported; ats++) {
+              addr = iova;
+
+              if (ats) {
+                  val_pcie_read_cfg(e_bdf, cap_base + ATS_CTRL, &reg_value);
+                  val_pcie_write_cfg(e_bdf, cap_base + ATS_CTRL, reg_value | ATS_CACHING_EN);
+
+                  val_exerciser_set_param(DMA_ATTRIBUTES, iova, len, instance);
+                  m_vir_addr = iova;
+                  if (val_exerciser_ops(ATS_TXN_REQ, iova, instance) ||
+                      val_exerciser_get_param(ATS_RES_ATTRIBUTES, &translated_addr, &m_vir_addr,
+                                              instance)) {
+                      val_print(ACS_PRINT_DEBUG, "\n       ATS request failed, exerciser %d",
+                                instance);
+                      val_pcie_write_cfg(e_bdf, cap_base + ATS_CTRL, reg_value & ATS_CACHING_DIS);
+                      continue;
+                  }
+
+                  val_exerciser_set_param(CFG_TXN_ATTRIBUTES, TXN_ADDR_TYPE, AT_TRANSLATED,
+                                          instance);
+                  addr = translated_addr;
+              }
+
+              res = dma_bench_result(&num_res, xlat, ats, target);
+              dma_bench_measure(instance, addr, len, res);
+
+              if (ats) {
+                  val_exerciser_set_param(CFG_TXN_ATTRIBUTES, TXN_ADDR_TYPE, AT_UNTRANSLATED,
+                                          instance);
+                  val_pcie_read_cfg(e_bdf, cap_base + ATS_CTRL, &reg_value);
+                  val_pcie_write_cfg(e_bdf, cap_base + ATS_CTRL, reg_value & ATS_CACHING_DIS);
+              }
+          }
+      }
+  }
+
+  /* The pool lives until the exerciser module ends */
+  smmu_ctx_unmap_all();
+
+report:
+  if (master.smmu_index != ACS_INVALID_INDEX)
+      val_smmu_enable(master.smmu_index);
+
+  dma_bench_report(instance, rc_index, len, num_res);
+  return num_res;
+}
+
+/**
+  @brief   Exerciser DMA bandwidth and latency benchmark. Every exerciser is
+           measured with the SMMU bypassed and, where supported, with stage 1
+           and stage 2 translation, ATS on and off, and a Normal cacheable or
+           Device view of the target buffer. A comparison table is printed
+           per exerciser, tagged with its root complex.
+
+  @return  Number of exercisers measured.
+**/
+uint32_t
+dma_bench_run(void)
+{
+  uint32_t instance;
+  uint32_t num_exercisers;
+  uint32_t measured = 0;
+  uint32_t len;
+  int32_t dev_indx;
+  SMMU_CTX_BUF buf;
+
+  num_exercisers = val_exerciser_get_info(EXERCISER_NUM_CARDS);
+  if (num_exercisers == 0)
+      return 0;
+
+  if (smmu_ctx_buf_alloc(&buf, DMA_BENCH_NUM_PAGES))
+      return 0;
+
+  len = (val_memory_page_size() * DMA_BENCH_NUM_PAGES) / 2;
+  dev_indx = dma_bench_device_attr_index(buf.pgt_desc.mair);
+
+  for (instance = 0; instance < num_exercisers; instance++) {
+      if (val_exerciser_init(instance))
+          continue;
+
+      dma_bench_exerciser(instance, buf.buf_virt, buf.buf_phys, len, &buf.pgt_desc,
+                          buf.s1_attr, dev_indx);
+      measured++;
+  }
+
+  smmu_ctx_buf_free(&buf);
+  return measured;
+}
@@ -0,0 +1,51 @@
+/** @file
+ * Copyright (c) 2026, Arm Limited or its affiliates. All rights reserved.
+ * SPDX-License-Identifier : Apache-2.0
+
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ **/
+
+#ifndef __DMA_BENCH_H__
+#define __DMA_BENCH_H__
+
+#include "perf_util.h"
+
+#define DMA_BENCH_NUM_PAGES  16
+#define DMA_BENCH_ITERATIONS 64
+
+typedef enum {
+  DMA_XLAT_BYPASS = 0,
+  DMA_XLAT_STAGE1,
+  DMA_XLAT_STAGE2,
+  DMA_XLAT_MAX
+} DMA_BENCH_XLAT;
+
+typedef enum {
+  DMA_TARGET_NORMAL = 0,   /* Normal Write-Back cacheable */
+  DMA_TARGET_DEVICE,       /* Device-nGnRnE */
+  DMA_TARGET_MAX
+} DMA_BENCH_TARGET;
+
+/* One row of the comparison table */
+typedef struct {
+  uint32_t xlat;
+  uint32_t ats;
+  uint32_t target;
+  PERF_STATS read_ns;      /* Per START_DMA EDMA_TO_DEVICE, memory is read */
+  PERF_STATS write_ns;     /* Per START_DMA EDMA_FROM_DEVICE, memory is written */
+} DMA_BENCH_RESULT;
+
+uint64_t dma_bench_attr(uint64_t s1_attr, uint32_t xlat, uint32_t target, int32_t dev_indx);
+uint32_t dma_bench_run(void);
+
+#endif /* __DMA_BENCH_H__ */
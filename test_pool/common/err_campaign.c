@@ -0,0 +1,233 @@
+/** @file
+ * Copyright (c) 2026, Arm Limited or its affiliates. All rights reserved.
+ * SPDX-License-Identifier : Apache-2.0
+
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ **/
+
+#include "val/common/include/acs_val.h"
+#include "val/sbsa/include/sbsa_val_interface.h"
+
+#include "val/common/include/acs_pcie_enumeration.h"
+#include "val/sbsa/include/sbsa_acs_pcie.h"
+#include "val/sbsa/include/sbsa_acs_exerciser.h"
+
+#include "comp_ring.h"
+#include "err_campaign.h"
+
+/* Completions are pushed here by the test ISR and drained by the campaign */
+static COMP_RING       err_ring;
+static COMP_RING_ENTRY err_ring_buf[ERR_CAMPAIGN_RING_SIZE];
+
+/**
+  @brief   Resolve the AER/DPC register blocks of an exerciser and its root
+           port once, so each injected error only costs the register reads.
+           Offsets of capabilities which are not present are left as 0.
+
+  @param   camp      Campaign to initialise
+  @param   instance  Exerciser instance
+  @param   e_bdf     Exerciser BDF
+  @param   erp_bdf   Root port BDF of the exerciser
+  @param   int_id    Interrupt ID the ISR reports on error detection
+  @return  0
+**/
+uint32_t
+err_campaign_init(ERR_CAMPAIGN *camp, uint32_t instance, uint32_t e_bdf,
+                  uint32_t erp_bdf, uint32_t int_id)
+{
+  camp->instance      = instance;
+  camp->e_bdf         = e_bdf;
+  camp->erp_bdf       = erp_bdf;
+  camp->int_id        = int_id;
+  camp->num_events    = 0;
+  camp->aer_offset    = 0;
+  camp->rp_aer_offset = 0;
+  camp->pciecs_base   = 0;
+  camp->rp_dpc_base   = 0;
+
+  if (val_pcie_find_capability(e_bdf, PCIE_ECAP, ECID_AER, &camp->aer_offset) != PCIE_SUCCESS)
+      camp->aer_offset = 0;
+
+  if (val_pcie_find_capability(erp_bdf, PCIE_ECAP, ECID_AER, &camp->rp_aer_offset)
+      != PCIE_SUCCESS)
+      camp->rp_aer_offset = 0;
+
+  if (val_pcie_find_capability(e_bdf, PCIE_CAP, CID_PCIECS, &camp->pciecs_base) != PCIE_SUCCESS)
+      camp->pciecs_base = 0;
+
+  if (val_pcie_find_capability(erp_bdf, PCIE_ECAP, ECID_DPC, &camp->rp_dpc_base) != PCIE_SUCCESS)
+      camp->rp_dpc_base = 0;
+
+  perf_stats_init(&camp->latency);
+  comp_ring_init(&err_ring, err_ring_buf, ERR_CAMPAIGN_RING_SIZE);
+
+  return 0;
+}
+
+/**
+  @brief   Append an error code to the campaign.
+
+  @return  Queued event, NULL if the campaign is full.
+**/
+ERR_EVENT *
+err_campaign_queue(ERR_CAMPAIGN *camp, uint32_t err_code)
+{
+  ERR_EVENT *evt;
+
+  if (camp->num_events >= ERR_CAMPAIGN_MAX_EVENTS) {
+      val_print(ACS_PRINT_WARN, "\n       Error campaign full, dropping code %d", err_code);
+      return NULL;
+  }
+
+  evt = &camp->event[camp->num_events++];
+  val_memory_set(evt, sizeof(ERR_EVENT), 0);
+  evt->err_code = err_code;
+
+  return evt;
+}
+
+/**
+  @brief   Clear the per-event results so the queued codes can be replayed
+           with a different mask/severity setup.
+**/
+void
+err_campaign_reset(ERR_CAMPAIGN *camp)
+{
+  uint32_t idx;
+  uint32_t err_code;
+
+  for (idx = 0; idx < camp->num_events; idx++) {
+      err_code = camp->event[idx].err_code;
+      val_memory_set(&camp->event[idx], sizeof(ERR_EVENT), 0);
+      camp->event[idx].err_code = err_code;
+  }
+
+  perf_stats_init(&camp->latency);
+}
+
+/**
+  @brief   Called just before the error is injected. Drops completions left
+           over from a previous event and timestamps the injection.
+**/
+void
+err_campaign_arm(ERR_CAMPAIGN *camp, ERR_EVENT *evt)
+{
+  COMP_RING_ENTRY stale;
+
+  (void)camp;
+
+  while (comp_ring_pop(&err_ring, &stale))
+      ;
+
+  evt->irq_received = 0;
+  evt->inject_ts = perf_get_ticks();
+}
+
+/**
+  @brief   Wait for the ISR to report the campaign interrupt.
+
+  @param   camp     Campaign
+  @param   evt      Event being waited on
+  @param   timeout  Number of polls before giving up
+  @return  0 if the interrupt was received, 1 on timeout.
+**/
+uint32_t
+err_campaign_wait(ERR_CAMPAIGN *camp, ERR_EVENT *evt, uint32_t timeout)
+{
+  COMP_RING_ENTRY entry;
+
+  while (timeout-- > 0) {
+      if (!comp_ring_pop(&err_ring, &entry))
+          continue;
+
+      if (entry.int_id != camp->int_id)
+          continue;
+
+      evt->irq_received = 1;
+      evt->detect_ts = entry.timestamp;
+      perf_stats_add(&camp->latency, perf_ticks_to_ns(evt->detect_ts - evt->inject_ts));
+      return 0;
+  }
+
+  return 1;
+}
+
+/**
+  @brief   Read every AER/DPC status register of interest in one pass.
+**/
+void
+err_campaign_snapshot(ERR_CAMPAIGN *camp, ERR_SNAPSHOT *snap)
+{
+  val_memory_set(snap, sizeof(ERR_SNAPSHOT), 0);
+
+  if (camp->aer_offset) {
+      val_pcie_read_cfg(camp->e_bdf, camp->aer_offset + AER_UNCORR_STATUS_OFFSET,
+                        &snap->ep_uncorr_status);
+      val_pcie_read_cfg(camp->e_bdf, camp->aer_offset + AER_CORR_STATUS_OFFSET,
+                        &snap->ep_corr_status);
+  }
+
+  if (camp->pciecs_base)
+      val_pcie_read_cfg(camp->e_bdf, camp->pciecs_base + DCTLR_OFFSET,
+                        &snap->ep_dev_ctl_status);
+
+  if (camp->rp_aer_offset) {
+      val_pcie_read_cfg(camp->erp_bdf, camp->rp_aer_offset + AER_ROOT_ERR_OFFSET,
+                        &snap->rp_root_err_status);
+      val_pcie_read_cfg(camp->erp_bdf, camp->rp_aer_offset + AER_ROOT_ERR_SOURCE_ID,
+                        &snap->rp_err_source_id);
+  }
+
+  if (camp->rp_dpc_base)
+      val_pcie_read_cfg(camp->erp_bdf, camp->rp_dpc_base + DPC_STATUS_OFFSET,
+                        &snap->rp_dpc_status);
+}
+
+/**
+  @brief   To be called from the test interrupt handler. Only records the
+           completion, all register accesses happen outside interrupt context.
+**/
+void
+err_campaign_isr(uint32_t int_id)
+{
+  comp_ring_push(&err_ring, int_id, 0, perf_get_ticks());
+}
+
+/**
+  @brief   Print per error detection latency and a summary for the campaign.
+**/
+void
+err_campaign_report(ERR_CAMPAIGN *camp)
+{
+  uint32_t idx;
+  ERR_EVENT *evt;
+
+  val_print(ACS_PRINT_INFO, "\n       Error campaign for BDF 0x%x", camp->e_bdf);
+
+  for (idx = 0; idx < camp->num_events; idx++) {
+      evt = &camp->event[idx];
+      val_print(ACS_PRINT_INFO, "\n         Err code %2d", evt->err_code);
+      val_print(ACS_PRINT_INFO, " type %d", evt->err_type);
+
+      if (evt->irq_received)
+          val_print(ACS_PRINT_INFO, " detection latency %d ns",
+                    perf_ticks_to_ns(evt->detect_ts - evt->inject_ts));
+      else
+          val_print(ACS_PRINT_INFO, " no interrupt", 0);
+  }
+
+  if (err_ring.dropped)
+      val_print(ACS_PRINT_WARN, "\n       Completions dropped : %d", err_ring.dropped);
+
+  perf_stats_print(ACS_PRINT_DEBUG, "\n       Detection latency (ns)", &camp->latency);
+}
@@ -0,0 +1,70 @@
+/** @file
+ * Copyright (c) 2026, Arm Limited or its affiliates. All rights reserved.
+ * SPDX-License-Identifier : Apache-2.0
+
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ **/
+
+#ifndef __ERR_CAMPAIGN_H__
+#define __ERR_CAMPAIGN_H__
+
+#include "perf_util.h"
+
+#define ERR_CAMPAIGN_MAX_EVENTS  64
+#define ERR_CAMPAIGN_RING_SIZE   64
+
+/* AER and DPC registers of an exerciser and its root port, read in one pass */
+typedef struct {
+  uint32_t ep_uncorr_status;
+  uint32_t ep_corr_status;
+  uint32_t ep_dev_ctl_status;
+  uint32_t rp_root_err_status;
+  uint32_t rp_err_source_id;
+  uint32_t rp_dpc_status;
+} ERR_SNAPSHOT;
+
+typedef struct {
+  uint32_t err_code;       /* Error code queued for injection */
+  uint32_t err_type;       /* Correctable/Uncorrectable, as reported by the exerciser */
+  uint32_t err_value;      /* Error returned by the INJECT_ERROR operation */
+  uint32_t irq_received;
+  uint64_t inject_ts;
+  uint64_t detect_ts;
+  ERR_SNAPSHOT snap;
+} ERR_EVENT;
+
+typedef struct {
+  uint32_t instance;
+  uint32_t e_bdf;
+  uint32_t erp_bdf;
+  uint32_t aer_offset;     /* AER capability of the exerciser */
+  uint32_t rp_aer_offset;  /* AER capability of the root port */
+  uint32_t pciecs_base;    /* PCIe capability of the exerciser */
+  uint32_t rp_dpc_base;    /* DPC capability of the root port, 0 if absent */
+  uint32_t int_id;         /* Interrupt expected on error detection */
+  uint32_t num_events;
+  ERR_EVENT event[ERR_CAMPAIGN_MAX_EVENTS];
+  PERF_STATS latency;
+} ERR_CAMPAIGN;
+
+uint32_t   err_campaign_init(ERR_CAMPAIGN *camp, uint32_t instance, uint32_t e_bdf,
+                             uint32_t erp_bdf, uint32_t int_id);
+ERR_EVENT *err_campaign_queue(ERR_CAMPAIGN *camp, uint32_t err_code);
+void       err_campaign_reset(ERR_CAMPAIGN *camp);
+void       err_campaign_arm(ERR_CAMPAIGN *camp, ERR_EVENT *evt);
+uint32_t   err_campaign_wait(ERR_CAMPAIGN *camp, ERR_EVENT *evt, uint32_t timeout);
+void       err_campaign_snapshot(ERR_CAMPAIGN *camp, ERR_SNAPSHOT *snap);
+void       err_campaign_isr(uint32_t int_id);
+void       err_campaign_report(ERR_CAMPAIGN *camp);
+
+#endif /* __ERR_CAMPAIGN_H__ */
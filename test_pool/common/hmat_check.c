@@ -0,0 +1,251 @@
+/** @file
+ * Copyright (c) 2026, Arm Limited or its affiliates. All rights reserved.
+ * SPDX-License-Identifier : Apache-2.0
+
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ **/
+
+
+#include "val/common/include/acs_val.h"
+#include "val/common/include/acs_pe.h"
+#include "val/common/include/acs_memory.h"
+#include "val/sbsa/include/sbsa_val_interface.h"
+#include "val/sbsa/include/sbsa_acs_pe.h"
+#include "val/sbsa/include/sbsa_acs_memory.h"
+
+#include "traffic_gen.h"
+#include "numa_bench.h"
+#include "hmat_check.h"
+
+static HMAT_CHECK hmat_check;
+static TGEN_CFG   hmat_cfg[HMAT_CHECK_MAX_PE];
+static uint32_t   hmat_pe_list[HMAT_CHECK_MAX_PE];
+
+/**
+  @brief   Stream the configurations of hmat_cfg from every PE of the list
+           together, once untimed and once timed.
+
+  @return  Aggregate MB/s, 0 if some PE did not complete.
+**/
+static
+uint64_t
+hmat_check_stream(uint32_t num_pe, uint32_t test_num)
+{
+  uint64_t bytes = 0;
+  uint64_t ticks = 0;
+  uint64_t ns;
+  uint32_t slot;
+
+  if (tgen_run_multi(num_pe, hmat_pe_list, hmat_cfg, test_num) ||
+      tgen_run_multi(num_pe, hmat_pe_list, hmat_cfg, test_num))
+      return 0;
+
+  /* All PEs are released together, the slowest one bounds the transfer */
+  for (slot = 0; slot < num_pe; slot++) {
+      bytes += tgen_bytes(&hmat_cfg[slot]);
+      if (hmat_cfg[slot].ticks > ticks)
+          ticks = hmat_cfg[slot].ticks;
+  }
+
+  ns = perf_ticks_to_ns(ticks);
+
+  return ns ? (bytes * 1000) / ns : 0;
+}
+
+/**
+  @brief   Percentage a measured value is off the claimed one.
+
+  @return  Deviation in percent, 0 if nothing is claimed.
+**/
+uint32_t
+hmat_check_dev(uint64_t claim, uint64_t meas)
+{
+  uint64_t diff;
+
+  if (claim == 0)
+      return 0;
+
+  diff = (meas > claim) ? meas - claim : claim - meas;
+
+  return (uint32_t)((diff * 100) / claim);
+}
+
+/**
+  @brief   Check the HMAT bandwidth of one memory domain. The initiator
+           domain with the best single PE read bandwidth in the matrix is
+           taken as the closest one, and its secondary PEs stream to the
+           memory domain together, since the HMAT advertises what the
+           domain sustains rather than what one PE achieves. The matrix cell
+           is used as is when the domain has no other PE.
+
+  @param   check     Results, the entry is appended
+  @param   matrix    Measured matrix from numa_bench_run
+  @param   mem       Memory domain index in the matrix
+  @param   test_num  Test the secondary PE status is reported against
+**/
+void
+hmat_check_domain(HMAT_CHECK *check, NUMA_MATRIX *matrix, uint32_t mem, uint32_t test_num)
+{
+  uint32_t my_index = val_pe_get_index_mpid(val_pe_get_mpid());
+  uint32_t num_pe = val_pe_get_num();
+  uint32_t init, best = 0;
+  uint32_t pe, slot, count = 0;
+  uint64_t mbps;
+  TGEN_CFG read = {TGEN_OP_READ, TGEN_PATTERN_SEQ, 0, 0, 1, 0, 0, HMAT_CHECK_BUF_SIZE, 0};
+  void *buf;
+  NUMA_CELL *cell;
+  HMAT_CHECK_ENTRY *entry;
+
+  if (check->num_entry >= NUMA_BENCH_MAX_DOMAIN)
+      return;
+
+  entry = &check->entry[check->num_entry++];
+  val_memory_set(entry, sizeof(HMAT_CHECK_ENTRY), 0);
+  entry->mem_domain = matrix->mem_domain[mem];
+  entry->has_claim = !numa_bench_hmat_bw(entry->mem_domain, &entry->claim_bw);
+
+  for (init = 1; init < matrix->num_init; init++) {
+      if (matrix->cell[init][mem].measured &&
+          (matrix->cell[init][mem].read_mbps > matrix->cell[best][mem].read_mbps))
+          best = init;
+  }
+
+  cell = &matrix->cell[best][mem];
+  entry->init_domain = matrix->init_domain[best];
+  entry->num_pe      = 1;
+  entry->meas_read   = cell->read_mbps;
+  entry->meas_write  = cell->write_mbps;
+  entry->load_ps     = cell->load_ps;
+
+  for (pe = 0; pe < num_pe && count < HMAT_CHECK_MAX_PE; pe++) {
+      if (pe == my_index)
+          continue;
+      if (val_srat_get_info(SRAT_GICC_PROX_DOMAIN, val_pe_get_uid(pe)) == entry->init_domain)
+          hmat_pe_list[count++] = pe;
+  }
+
+  if (count > matrix->mem_len[mem] / HMAT_CHECK_BUF_SIZE)
+      count = matrix->mem_len[mem] / HMAT_CHECK_BUF_SIZE;
+
+  if (count > 1) {
+      buf = (void *)val_mem_alloc_at_address(matrix->mem_base[mem],
+                                             (uint64_t)count * HMAT_CHECK_BUF_SIZE);
+      if (buf == NULL) {
+          val_print(ACS_PRINT_WARN, "\n       HMAT check buffers unavailable in domain %d",
+                    entry->mem_domain);
+      } else {
+          for (slot = 0; slot < count; slot++) {
+              hmat_cfg[slot] = read;
+              hmat_cfg[slot].src = (uint64_t)buf + slot * HMAT_CHECK_BUF_SIZE;
+          }
+
+          mbps = hmat_check_stream(count, test_num);
+          if (mbps) {
+              entry->meas_read = mbps;
+              entry->num_pe = count;
+          }
+
+          for (slot = 0; slot < count; slot++) {
+              hmat_cfg[slot].op = TGEN_OP_WRITE;
+              hmat_cfg[slot].nontemporal = 1;
+              hmat_cfg[slot].dst = hmat_cfg[slot].src;
+              hmat_cfg[slot].src = 0;
+          }
+
+          mbps = hmat_check_stream(count, test_num);
+          if (mbps && (entry->num_pe == count))
+              entry->meas_write = mbps;
+
+          val_mem_free_at_address((uint64_t)buf, (uint64_t)count * HMAT_CHECK_BUF_SIZE);
+      }
+  }
+
+  if (!entry->has_claim)
+      return;
+
+  /* VAL reports the HMAT read and write bandwidth combined */
+  entry->dev = hmat_check_dev(entry->claim_bw, entry->meas_read + entry->meas_write);
+  if (entry->dev > check->tol_pct) {
+      entry->flagged = 1;
+      check->num_flagged++;
+  }
+}
+
+/**
+  @brief   Print the claimed and measured bandwidth of every memory domain
+           and warn for the ones off by more than the tolerance.
+**/
+void
+hmat_check_report(HMAT_CHECK *check)
+{
+  uint32_t idx;
+  HMAT_CHECK_ENTRY *entry;
+
+  val_print(ACS_PRINT_TEST, "\n       HMAT bandwidth claims, tolerance %d%%", check->tol_pct);
+  val_print(ACS_PRINT_TEST, "\n       Mem dom Init dom PEs  Meas rd  Meas wr HMAT rd+wr Dev%%"
+                            "  Lat ns", 0);
+
+  for (idx = 0; idx < check->num_entry; idx++) {
+      entry = &check->entry[idx];
+      val_print(ACS_PRINT_TEST, "\n       %7d", entry->mem_domain);
+      val_print(ACS_PRINT_TEST, " %8d", entry->init_domain);
+      val_print(ACS_PRINT_TEST, " %3d", entry->num_pe);
+
+      val_print(ACS_PRINT_TEST, " %8d", entry->meas_read);
+      val_print(ACS_PRINT_TEST, " %8d", entry->meas_write);
+
+      if (entry->has_claim) {
+          val_print(ACS_PRINT_TEST, " %9d", entry->claim_bw);
+          val_print(ACS_PRINT_TEST, " %4d", entry->dev);
+      } else {
+          val_print(ACS_PRINT_TEST, "         -    -", 0);
+      }
+
+      val_print(ACS_PRINT_TEST, " %7d", entry->load_ps / 1000);
+  }
+
+  for (idx = 0; idx < check->num_entry; idx++) {
+      entry = &check->entry[idx];
+      if (!entry->flagged)
+          continue;
+
+      val_print(ACS_PRINT_WARN, "\n       HMAT bandwidth of memory domain %d", entry->mem_domain);
+      val_print(ACS_PRINT_WARN, " off by more than %d%%", check->tol_pct);
+  }
+
+  val_print(ACS_PRINT_TEST, "\n       HMAT entries off the measurement : %d", check->num_flagged);
+}
+
+/**
+  @brief   Check the HMAT bandwidth of every memory domain of the matrix
+           against the measured one. Results are informational.
+
+  @param   matrix    Measured matrix from numa_bench_run
+  @param   test_num  Test the secondary PE status is reported against
+  @return  Number of memory domains off by more than the tolerance.
+**/
+uint32_t
+hmat_check_run(NUMA_MATRIX *matrix, uint32_t test_num)
+{
+  uint32_t mem;
+
+  val_memory_set(&hmat_check, sizeof(HMAT_CHECK), 0);
+  hmat_check.tol_pct = g_sbsa_hmat_tol ? g_sbsa_hmat_tol : HMAT_CHECK_DEFAULT_TOL;
+
+  for (mem = 0; mem < matrix->num_mem; mem++)
+      hmat_check_domain(&hmat_check, matrix, mem, test_num);
+
+  hmat_check_report(&hmat_check);
+
+  return hmat_check.num_flagged;
+}
@@ -0,0 +1,58 @@
+/** @file
+ * Copyright (c) 2026, Arm Limited or its affiliates. All rights reserved.
+ * SPDX-License-Identifier : Apache-2.0
+
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ **/
+
+
+#ifndef __HMAT_CHECK_H__
+#define __HMAT_CHECK_H__
+
+#include "perf_util.h"
+#include "numa_bench.h"
+
+#define HMAT_CHECK_DEFAULT_TOL  20          /* Percent, when -hmat_tol is not given */
+#define HMAT_CHECK_MAX_PE       16          /* Streaming PEs per initiator domain */
+#define HMAT_CHECK_BUF_SIZE     0x800000    /* Streamed by each PE, 8 MB */
+
+/* HMAT bandwidth of one memory domain against the bandwidth measured from
+ * the initiator domain closest to it.
+ */
+typedef struct {
+  uint64_t mem_domain;
+  uint64_t init_domain;    /* Initiator domain the streams ran from */
+  uint32_t num_pe;         /* PEs streaming together, 1 if only the matrix cell was used */
+  uint32_t has_claim;      /* The HMAT describes the memory domain */
+  uint64_t claim_bw;       /* HMAT read plus write bandwidth, MB/s */
+  uint64_t meas_read;      /* Aggregate streaming read bandwidth, MB/s */
+  uint64_t meas_write;     /* Aggregate non-temporal write bandwidth, MB/s */
+  uint64_t load_ps;        /* Pointer chase latency from the matrix, for reference */
+  uint32_t dev;            /* Percent read plus write is off the claim */
+  uint32_t flagged;        /* Off by more than the tolerance */
+} HMAT_CHECK_ENTRY;
+
+typedef struct {
+  uint32_t tol_pct;
+  uint32_t num_entry;
+  uint32_t num_flagged;
+  HMAT_CHECK_ENTRY entry[NUMA_BENCH_MAX_DOMAIN];
+} HMAT_CHECK;
+
+uint32_t hmat_check_dev(uint64_t claim, uint64_t meas);
+void     hmat_check_domain(HMAT_CHECK *check, NUMA_MATRIX *matrix, uint32_t mem,
+                           uint32_t test_num);
+void     hmat_check_report(HMAT_CHECK *check);
+uint32_t hmat_check_run(NUMA_MATRIX *matrix, uint32_t test_num);
+
+#endif /* __HMAT_CHECK_H__ */
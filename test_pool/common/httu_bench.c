@@ -0,0 +1,410 @@
+/** @file
+ * Copyright (c) 2026, Arm Limited or its affiliates. All rights reserved.
+ * SPDX-License-Identifier : Apache-2.0
+
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ **/
+
+
+#include "val/common/include/acs_val.h"
+#include "val/sbsa/include/sbsa_val_interface.h"
+
+#include "val/sbsa/include/sbsa_acs_pe.h"
+#include "val/sbsa/include/sbsa_acs_smmu.h"
+#include "val/common/include/acs_pgt.h"
+#include "val/common/include/acs_pe.h"
+#include "val/sbsa/include/sbsa_acs_iovirt.h"
+#include "val/common/include/acs_iovirt.h"
+#include "val/sbsa/include/sbsa_acs_memory.h"
+#include "val/common/include/acs_pcie_enumeration.h"
+#include "val/sbsa/include/sbsa_acs_pcie.h"
+#include "val/sbsa/include/sbsa_acs_exerciser.h"
+
+#include "smmu_caps.h"
+#include "smmu_ctx.h"
+#include "route_map.h"
+#include "smmu_cmdq.h"
+#include "pmcg.h"
+#include "dma_bench.h"
+#include "httu_bench.h"
+
+/* Translation table descriptor bits */
+#define HTTU_DESC_AP_RO       (1ULL << 7)    /* Stage 1 AP[2] */
+#define HTTU_DESC_S2AP_W      (1ULL << 7)    /* Stage 2 S2AP[1] */
+#define HTTU_DESC_AF          (1ULL << 10)
+#define HTTU_DESC_DBM         (1ULL << 51)
+
+/* HTTU enables, CD double word 0 and STE double word 2 */
+#define HTTU_CD_HD            (1ULL << 42)
+#define HTTU_CD_HA            (1ULL << 43)
+#define HTTU_STE_S2HD         (1ULL << 55)
+#define HTTU_STE_S2HA         (1ULL << 56)
+
+#define HTTU_SMMU_STRTAB_BASE      0x80
+#define HTTU_SMMU_STRTAB_BASE_CFG  0x88
+#define HTTU_ADDR_MASK             0x000FFFFFFFFFFFC0ULL
+#define HTTU_STE_SIZE              64
+
+/* PMCG counters used per pass */
+#define HTTU_CTR_TXN          0
+#define HTTU_CTR_TLB_MISS     1
+#define HTTU_CTR_WALK         2
+#define HTTU_CTR_MASK         0x7
+
+static char8_t *mode_name[HTTU_MODE_MAX] = {"off         ", "on, 1st pass", "on, 2nd pass"};
+
+/**
+  @brief   Return the STE of a stream, walking a two level stream table
+           when STRTAB_BASE_CFG.FMT says so.
+
+  @return  STE pointer, NULL if the stream has no STE.
+**/
+static
+uint64_t *
+httu_bench_ste(uint64_t smmu_base, uint32_t sid)
+{
+  uint64_t strtab, l1_desc, ste_pa;
+  uint32_t cfg, split, span;
+
+  strtab = val_mmio_read64(smmu_base + HTTU_SMMU_STRTAB_BASE) & HTTU_ADDR_MASK;
+  cfg = val_mmio_read(smmu_base + HTTU_SMMU_STRTAB_BASE_CFG);
+
+  if ((sid >> VAL_EXTRACT_BITS(cfg, 0, 5)) != 0)
+      return NULL;
+
+  if (VAL_EXTRACT_BITS(cfg, 16, 17) == 0) {
+      ste_pa = strtab + (uint64_t)sid * HTTU_STE_SIZE;
+  } else {
+      split = VAL_EXTRACT_BITS(cfg, 6, 10);
+      l1_desc = ((uint64_t *)val_memory_phys_to_virt(strtab))[sid >> split];
+      span = VAL_EXTRACT_BITS(l1_desc, 0, 4);
+      if (span == 0 || (sid & ((1u << split) - 1)) >= (1u << (span - 1)))
+          return NULL;
+
+      ste_pa = (l1_desc & HTTU_ADDR_MASK) +
+               (uint64_t)(sid & ((1u << split) - 1)) * HTTU_STE_SIZE;
+  }
+
+  return (uint64_t *)val_memory_phys_to_virt(ste_pa);
+}
+
+/**
+  @brief   Turn on hardware flag updates for a stream mapped by val. val
+           programs neither CD.HA/HD nor STE.S2HA/S2HD, so the structures
+           are patched in place and their cached copies invalidated.
+
+  @param   master  Mapped stream
+  @param   caps    Capabilities of its SMMU
+  @return  0 on success, 1 otherwise.
+**/
+static
+uint32_t
+httu_bench_enable(smmu_master_attributes_t *master, SMMU_CAPS *caps)
+{
+  uint64_t *ste, *cd;
+  uint32_t hd = (caps->httu == 2);
+  SMMU_CMDQ q;
+
+  ste = httu_bench_ste(caps->base, master->streamid);
+  if (ste == NULL)
+      return 1;
+
+  if (master->stage2) {
+      ste[2] |= HTTU_STE_S2HA | (hd ? HTTU_STE_S2HD : 0);
+      val_data_cache_ops_by_va((addr_t)ste, CLEAN_AND_INVALIDATE);
+  } else {
+      cd = (uint64_t *)val_memory_phys_to_virt(ste[0] & HTTU_ADDR_MASK);
+      if (cd == NULL)
+          return 1;
+
+      cd[0] |= HTTU_CD_HA | (hd ? HTTU_CD_HD : 0);
+      val_data_cache_ops_by_va((addr_t)cd, CLEAN_AND_INVALIDATE);
+  }
+
+  if (smmu_cmdq_attach(&q, master->smmu_index))
+      return 1;
+
+  smmu_cmdq_push(&q, SMMU_CMDQ_OP_CFGI_STE | SMMU_CMDQ_SID(master->streamid), SMMU_CMDQ_LEAF);
+  smmu_cmdq_push(&q, SMMU_CMDQ_OP_CFGI_CD | SMMU_CMDQ_SID(master->streamid), SMMU_CMDQ_LEAF);
+  smmu_cmdq_push(&q, SMMU_CMDQ_OP_TLBI_NSNH_ALL, 0);
+  smmu_cmdq_push(&q, SMMU_CMDQ_OP_SYNC, 0);
+  smmu_cmdq_doorbell(&q);
+  smmu_cmdq_drain(&q);
+  smmu_cmdq_detach(&q);
+
+  return q.error ? 1 : 0;
+}
+
+/**
+  @brief   Descriptor attributes for the HTTU on mapping: Access flag clear
+           and, with dirty state support, writable-clean (DBM and read only)
+           so the first write of each page needs a hardware update.
+**/
+static
+uint64_t
+httu_bench_attr(uint64_t s1_attr, uint32_t xlat, uint32_t hd)
+{
+  uint64_t attr;
+
+  attr = dma_bench_attr(s1_attr, xlat, DMA_TARGET_NORMAL, -1) & ~HTTU_DESC_AF;
+  if (!hd)
+      return attr;
+
+  attr |= HTTU_DESC_DBM;
+  if (xlat == DMA_XLAT_STAGE2)
+      return attr & ~HTTU_DESC_S2AP_W;
+
+  return attr | HTTU_DESC_AP_RO;
+}
+
+/**
+  @brief   Count the pages whose descriptors the SMMU updated.
+**/
+static
+uint32_t
+httu_bench_updated(pgt_descriptor_t *pgt_desc, uint64_t iova, uint32_t page_size,
+                   uint32_t xlat, uint32_t hd)
+{
+  uint32_t page;
+  uint32_t updated = 0;
+  uint64_t attr;
+
+  for (page = 0; page < HTTU_BENCH_NUM_PAGES; page++) {
+      if (val_pgt_get_attributes(*pgt_desc, iova + (uint64_t)page * page_size, &attr))
+          continue;
+
+      if (!(attr & HTTU_DESC_AF))
+          continue;
+
+      if (hd && ((xlat == DMA_XLAT_STAGE2) ? !(attr & HTTU_DESC_S2AP_W) :
+                                             (attr & HTTU_DESC_AP_RO)))
+          continue;
+
+      updated++;
+  }
+
+  return updated;
+}
+
+/**
+  @brief   Write HTTU_BENCH_DMA_LEN bytes to every page of the region with
+           cold SMMU TLBs, sampling the PMCG over the pass. The pass stops at
+           the first failed DMA.
+**/
+static
+void
+httu_bench_pass(uint32_t instance, uint32_t smmu_index, uint64_t iova, uint32_t page_size,
+                PMCG_CTX *pmcg, HTTU_BENCH_RESULT *res)
+{
+  uint32_t page;
+  uint64_t start;
+
+  smmu_cmdq_issue(smmu_index, SMMU_CMDQ_OP_TLBI_NSNH_ALL, 0);
+
+  if (pmcg)
+      pmcg_start(pmcg, HTTU_CTR_MASK);
+
+  start = perf_get_ticks();
+  for (page = 0; page < HTTU_BENCH_NUM_PAGES; page++) {
+      val_exerciser_set_param(DMA_ATTRIBUTES, iova + (uint64_t)page * page_size,
+                              HTTU_BENCH_DMA_LEN, instance);
+      if (val_exerciser_ops(START_DMA, EDMA_FROM_DEVICE, instance)) {
+          val_print(ACS_PRINT_DEBUG, "\n       DMA write failed for exerciser %d", instance);
+          break;
+      }
+  }
+  res->pages = page;
+  res->ns = perf_ticks_to_ns(perf_get_ticks() - start);
+
+  if (pmcg) {
+      pmcg_stop(pmcg);
+      res->txn      = pmcg_read(pmcg, HTTU_CTR_TXN);
+      res->tlb_miss = pmcg_read(pmcg, HTTU_CTR_TLB_MISS);
+      res->walk     = pmcg_read(pmcg, HTTU_CTR_WALK);
+  }
+}
+
+static
+void
+httu_bench_report(uint32_t instance, uint32_t smmu_index, uint32_t xlat,
+                  HTTU_BENCH_RESULT *res, uint32_t num_res)
+{
+  uint32_t mode;
+
+  val_print(ACS_PRINT_TEST, "\n       HTTU, exerciser %d", instance);
+  val_print(ACS_PRINT_TEST, " SMMU %d", smmu_index);
+  val_print(ACS_PRINT_TEST, (xlat == DMA_XLAT_STAGE2) ? " stage 2" : " stage 1", 0);
+  val_print(ACS_PRINT_TEST, ", %d pages", HTTU_BENCH_NUM_PAGES);
+  val_print(ACS_PRINT_TEST,
+            "\n       Mode          ns/page   MB/s     Txns  TLB miss    Walks  Updated", 0);
+
+  for (mode = 0; mode < num_res; mode++) {
+      val_print(ACS_PRINT_TEST, "\n       ", 0);
+      val_print(ACS_PRINT_TEST, mode_name[mode], 0);
+      val_print(ACS_PRINT_TEST, " %8d", res[mode].pages ? res[mode].ns / res[mode].pages : 0);
+      val_print(ACS_PRINT_TEST, " %6d", res[mode].ns ?
+                ((uint64_t)res[mode].pages * HTTU_BENCH_DMA_LEN * 1000) / res[mode].ns : 0);
+      val_print(ACS_PRINT_TEST, " %8d", res[mode].txn);
+      val_print(ACS_PRINT_TEST, " %9d", res[mode].tlb_miss);
+      val_print(ACS_PRINT_TEST, " %8d", res[mode].walk);
+      val_print(ACS_PRINT_TEST, " %8d", res[mode].updated);
+  }
+}
+
+/**
+  @brief   Measure one exerciser with HTTU off and on, for each translation
+           stage its SMMU supports.
+
+  @return  1 if the exerciser was measured, 0 otherwise.
+**/
+static
+uint32_t
+httu_bench_exerciser(uint32_t instance, void *buf_virt, uint64_t buf_phys, uint32_t page_size,
+                     pgt_descriptor_t *pgt_tmpl, uint64_t s1_attr)
+{
+  uint32_t e_bdf;
+  uint32_t device_id, its_id;
+  uint32_t xlat, mode, hd;
+  uint32_t num_res;
+  uint32_t was_enabled;
+  uint64_t iova;
+  SMMU_CAPS *caps;
+  SMMU_CTX *ctx = NULL;
+  PMCG_CTX pmcg;
+  PMCG_CTX *pmcg_ptr = NULL;
+  memory_region_descriptor_t mem_desc;
+  pgt_descriptor_t pgt_desc;
+  smmu_master_attributes_t master;
+  HTTU_BENCH_RESULT res[HTTU_MODE_MAX];
+
+  e_bdf = val_exerciser_get_bdf(instance);
+
+  val_memory_set(&master, sizeof(master), 0);
+  master.smmu_index = route_map_smmu_index(e_bdf);
+  caps = smmu_caps_get(master.smmu_index);
+  if (caps == NULL || caps->arch_major < 3 || caps->httu == 0)
+      return 0;
+
+  if (route_map_device_info(e_bdf, &device_id, &master.streamid, &its_id))
+      return 0;
+
+  pgt_desc = *pgt_tmpl;
+  pgt_desc.ias = val_smmu_get_info(SMMU_IN_ADDR_SIZE, master.smmu_index);
+  pgt_desc.oas = val_smmu_get_info(SMMU_OUT_ADDR_SIZE, master.smmu_index);
+  if ((pgt_desc.ias == 0) || (pgt_desc.oas == 0))
+      return 0;
+
+  /* Left as found on exit */
+  was_enabled = smmu_caps_enabled(master.smmu_index);
+  val_smmu_enable(master.smmu_index);
+
+  /* Walk counts need three counters, the bandwidth figures do not */
+  if (!pmcg_find(caps->base, 0, &pmcg) && pmcg.num_ctr >= 3) {
+      pmcg_config(&pmcg, HTTU_CTR_TXN, PMCG_EVT_TRANSACTION, master.streamid, 0);
+      pmcg_config(&pmcg, HTTU_CTR_TLB_MISS, PMCG_EVT_TLB_MISS, master.streamid, 0);
+      pmcg_config(&pmcg, HTTU_CTR_WALK, PMCG_EVT_TT_WALK, master.streamid, 0);
+      pmcg_ptr = &pmcg;
+  }
+
+  hd = (caps->httu == 2);
+  iova = (uint64_t)buf_virt + (uint64_t)instance * HTTU_BENCH_NUM_PAGES * page_size;
+
+  for (xlat = DMA_XLAT_STAGE1; xlat < DMA_XLAT_MAX; xlat++) {
+      if (!((xlat == DMA_XLAT_STAGE1) ? caps->s1p : caps->s2p))
+          continue;
+
+      master.stage2 = (xlat == DMA_XLAT_STAGE2);
+      pgt_desc.stage = (xlat == DMA_XLAT_STAGE2) ? PGT_STAGE2 : PGT_STAGE1;
+      val_memory_set(res, sizeof(res), 0);
+      num_res = 0;
+
+      for (mode = 0; mode < HTTU_MODE_MAX; mode++) {
+          /* The steady state pass reuses the mapping of the first pass */
+          if (mode != HTTU_MODE_STEADY) {
+              smmu_ctx_unmap_all();
+
+              val_memory_set(&mem_desc, sizeof(mem_desc), 0);
+              mem_desc.virtual_address = iova;
+              mem_desc.physical_address = buf_phys;
+              mem_desc.length = (uint64_t)HTTU_BENCH_NUM_PAGES * page_size;
+              mem_desc.attributes = (mode == HTTU_MODE_OFF) ?
+                                    dma_bench_attr(s1_attr, xlat, DMA_TARGET_NORMAL, -1) :
+                                    httu_bench_attr(s1_attr, xlat, hd);
+
+              ctx = smmu_ctx_map(&master, &mem_desc, &pgt_desc);
+              if (ctx == NULL)
+                  break;
+
+              if ((mode == HTTU_MODE_FIRST) && httu_bench_enable(&master, caps)) {
+                  val_print(ACS_PRINT_DEBUG, "\n       HTTU enable failed, SMMU %d",
+                            master.smmu_index);
+                  break;
+              }
+          }
+
+          httu_bench_pass(instance, master.smmu_index, iova, page_size, pmcg_ptr, &res[mode]);
+          if (mode != HTTU_MODE_OFF)
+              res[mode].updated = httu_bench_updated(&ctx->pgt_desc, iova, page_size, xlat, hd);
+          num_res++;
+      }
+
+      if (num_res)
+          httu_bench_report(instance, master.smmu_index, xlat, res, num_res);
+  }
+
+  /* Page tables hold hardware updated flags, never hand them out again */
+  smmu_ctx_pool_destroy();
+
+  if (!was_enabled)
+      val_smmu_disable(master.smmu_index);
+
+  return 1;
+}
+
+/**
+  @brief   HTTU cost benchmark. Every exerciser behind an SMMU with HTTU
+           writes to each page of a region mapped with HTTU off (flags set
+           by software) and on (flags set by the SMMU on first access). The
+           table per translation stage reports DMA bandwidth and the PMCG
+           transaction, TLB miss and table walk counts of each pass.
+
+  @return  Number of exercisers measured.
+**/
+uint32_t
+httu_bench_run(void)
+{
+  uint32_t instance;
+  uint32_t num_exercisers;
+  uint32_t measured = 0;
+  uint32_t page_size;
+  SMMU_CTX_BUF buf;
+
+  num_exercisers = val_exerciser_get_info(EXERCISER_NUM_CARDS);
+  if (num_exercisers == 0)
+      return 0;
+
+  page_size = val_memory_page_size();
+  if (smmu_ctx_buf_alloc(&buf, HTTU_BENCH_NUM_PAGES))
+      return 0;
+
+  for (instance = 0; instance < num_exercisers; instance++) {
+      if (val_exerciser_init(instance))
+          continue;
+
+      measured += httu_bench_exerciser(instance, buf.buf_virt, buf.buf_phys, page_size,
+                                       &buf.pgt_desc, buf.s1_attr);
+  }
+
+  smmu_ctx_buf_free(&buf);
+  return measured;
+}
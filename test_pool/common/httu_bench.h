@@ -0,0 +1,45 @@
+/** @file
+ * Copyright (c) 2026, Arm Limited or its affiliates. All rights reserved.
+ * SPDX-License-Identifier : Apache-2.0
+
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ **/
+
+
+#ifndef __HTTU_BENCH_H__
+#define __HTTU_BENCH_H__
+
+#include "perf_util.h"
+
+#define HTTU_BENCH_NUM_PAGES  256
+#define HTTU_BENCH_DMA_LEN    64      /* Bytes written to each page per pass */
+
+typedef enum {
+  HTTU_MODE_OFF = 0,       /* Flags preset by software, HTTU disabled */
+  HTTU_MODE_FIRST,         /* HTTU enabled, every page needs a flag update */
+  HTTU_MODE_STEADY,        /* HTTU enabled, flags already updated */
+  HTTU_MODE_MAX
+} HTTU_BENCH_MODE;
+
+typedef struct {
+  uint32_t pages;          /* Pages written before the first failed DMA */
+  uint64_t ns;             /* Time to touch them */
+  uint64_t txn;            /* PMCG counts over the pass, StreamID filtered */
+  uint64_t tlb_miss;
+  uint64_t walk;
+  uint32_t updated;        /* Pages whose AF/dirty state the SMMU updated */
+} HTTU_BENCH_RESULT;
+
+uint32_t httu_bench_run(void);
+
+#endif /* __HTTU_BENCH_H__ */
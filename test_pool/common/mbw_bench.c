@@ -0,0 +1,339 @@
+/** @file
+ * Copyright (c) 2026, Arm Limited or its affiliates. All rights reserved.
+ * SPDX-License-Identifier : Apache-2.0
+
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ **/
+
+
+#include "val/common/include/acs_val.h"
+#include "val/common/include/acs_pe.h"
+#include "val/common/include/acs_memory.h"
+#include "val/sbsa/include/sbsa_val_interface.h"
+#include "val/sbsa/include/sbsa_acs_memory.h"
+#include "val/sbsa/include/sbsa_acs_mpam.h"
+
+#include "perf_util.h"
+#include "pe_sync.h"
+#include "traffic_gen.h"
+#include "mpam_index.h"
+#include "mpam_msc.h"
+#include "mbw_bench.h"
+
+/* Unlimited reference, two MBW_MAX caps and one MBW_MIN guarantee */
+static MBW_CLASS mbw_class[MBW_BENCH_NUM_CLASS] = {
+  {100,  0},
+  { 50,  0},
+  { 25,  0},
+  {100, 50}
+};
+
+/* Written by the secondary PE owning the slot, one cache line each */
+typedef struct {
+  uint64_t start;
+  uint64_t end;
+  uint64_t bytes;
+  uint32_t partid;
+  uint32_t pad[9];
+} MBW_SLOT;
+
+static MBW_SLOT mbw_slot[MBW_BENCH_MAX_PE] __attribute__((aligned(64)));
+static uint64_t mbw_buf_base;
+
+/**
+  @brief   Runs on each secondary PE. Tags its traffic with the slot PARTID
+           and copies its own buffer pair MBW_BENCH_ITER times.
+**/
+static
+void
+mbw_bench_work(uint32_t slot)
+{
+  MBW_SLOT *res = &mbw_slot[slot];
+  uint64_t mpam2_el2, mpam2_el2_temp;
+  TGEN_CFG traffic = {TGEN_OP_COPY, TGEN_PATTERN_SEQ, 0, 0, 0, 0, 0, 0, 0};
+
+  mpam2_el2 = val_mpam_reg_read(MPAM2_EL2);
+  mpam2_el2_temp = mpam2_el2;
+
+  mpam2_el2 = (mpam2_el2 & ~(MPAMn_ELx_PARTID_D_MASK << MPAMn_ELx_PARTID_D_SHIFT)) |
+              ((uint64_t)res->partid << MPAMn_ELx_PARTID_D_SHIFT);
+  mpam2_el2 = (mpam2_el2 & ~(MPAMn_ELx_PMG_D_MASK << MPAMn_ELx_PMG_D_SHIFT)) |
+              ((uint64_t)DEFAULT_PMG << MPAMn_ELx_PMG_D_SHIFT);
+  val_mpam_reg_write(MPAM2_EL2, mpam2_el2);
+
+  traffic.src  = mbw_buf_base + (uint64_t)slot * 2 * MBW_BENCH_BUF_SIZE;
+  traffic.dst  = traffic.src + MBW_BENCH_BUF_SIZE;
+  traffic.size = MBW_BENCH_BUF_SIZE;
+  traffic.iter = MBW_BENCH_ITER;
+
+  res->start = perf_get_ticks();
+  res->bytes = tgen_run(&traffic);
+  res->end   = res->start + traffic.ticks;
+  val_data_cache_ops_by_va((addr_t)res, CLEAN_AND_INVALIDATE);
+
+  val_mpam_reg_write(MPAM2_EL2, mpam2_el2_temp);
+}
+
+/**
+  @brief   Convert a percentage into the MBW_MIN/MBW_MAX fixed point fraction,
+           keeping the BWA_WD implemented bits only.
+**/
+static
+uint32_t
+mbw_bench_portion(uint32_t pct, uint32_t bwa_wd)
+{
+  uint32_t value = (pct * 0xFFFF) / 100;
+
+  if (bwa_wd == 0 || bwa_wd > 16)
+      bwa_wd = 16;
+
+  return value & (0xFFFF << (16 - bwa_wd)) & 0xFFFF;
+}
+
+static
+void
+mbw_bench_part_sel(uint64_t msc_base, MPAM_RSRC *rsrc, uint32_t partid)
+{
+  uint32_t sel = partid;
+
+  if (rsrc->ris)
+      sel |= MPAMCFG_PART_SEL_RIS(rsrc->rsrc_index);
+
+  val_mmio_write(msc_base + MPAMCFG_PART_SEL, sel);
+}
+
+/**
+  @brief   Program the portions of every class, or lift them when limit is 0.
+**/
+static
+void
+mbw_bench_configure(uint64_t msc_base, MPAM_RSRC *rsrc, uint32_t mbw_idr,
+                    uint32_t num_class, uint32_t limit)
+{
+  MBW_CLASS *cls;
+  uint32_t bwa_wd = MPAMF_MBW_IDR_BWA_WD(mbw_idr);
+  uint32_t idx;
+
+  for (idx = 0; idx < num_class; idx++) {
+      cls = &mbw_class[idx];
+      mbw_bench_part_sel(msc_base, rsrc, cls->partid);
+
+      if (mbw_idr & MPAMF_MBW_IDR_HAS_MAX)
+          val_mmio_write(msc_base + MPAMCFG_MBW_MAX,
+                         mbw_bench_portion(limit ? cls->max_pct : 100, bwa_wd) |
+                         (limit ? MPAMCFG_MBW_MAX_HARDLIM : 0));
+
+      if (mbw_idr & MPAMF_MBW_IDR_HAS_MIN)
+          val_mmio_write(msc_base + MPAMCFG_MBW_MIN,
+                         mbw_bench_portion(limit ? cls->min_pct : 0, bwa_wd));
+  }
+}
+
+/**
+  @brief   Launch the traffic on all PEs at once and sum the per PE bandwidth
+           of each class.
+
+  @return  0 on success, 1 if the PEs could not be run.
+**/
+static
+uint32_t
+mbw_bench_measure(uint32_t num_pe, uint32_t *pe_list, uint32_t num_class, uint32_t test_num,
+                  uint32_t limit)
+{
+  MBW_SLOT *res;
+  uint64_t ns;
+  uint64_t mbps;
+  uint32_t slot;
+
+  for (slot = 0; slot < num_pe; slot++) {
+      val_memory_set(&mbw_slot[slot], sizeof(MBW_SLOT), 0);
+      mbw_slot[slot].partid = mbw_class[slot % num_class].partid;
+      val_data_cache_ops_by_va((addr_t)&mbw_slot[slot], CLEAN_AND_INVALIDATE);
+  }
+
+  if (pe_sync_launch(num_pe, pe_list, mbw_bench_work, test_num) || pe_sync_wait())
+      return 1;
+
+  for (slot = 0; slot < num_pe; slot++) {
+      res = &mbw_slot[slot];
+      val_data_cache_ops_by_va((addr_t)res, CLEAN_AND_INVALIDATE);
+
+      ns = perf_ticks_to_ns(res->end - res->start);
+      if (ns == 0)
+          continue;
+
+      /* bytes per ns is GB/s */
+      mbps = (res->bytes * 1000) / ns;
+      if (limit)
+          mbw_class[slot % num_class].mbps += mbps;
+      else
+          mbw_class[slot % num_class].base_mbps += mbps;
+  }
+
+  return 0;
+}
+
+static
+void
+mbw_bench_report(MPAM_RSRC *rsrc, uint32_t num_class, uint64_t ref_mbps)
+{
+  MBW_CLASS *cls;
+  uint64_t pct;
+  uint32_t idx;
+
+  val_print(ACS_PRINT_TEST, "\n       MBW partitioning, MSC %d", rsrc->msc_index);
+  val_print(ACS_PRINT_TEST, " rsrc %d", rsrc->rsrc_index);
+  val_print(ACS_PRINT_TEST, " reference %d MB/s", ref_mbps);
+  val_print(ACS_PRINT_TEST, "\n         PARTID  MAX%%  MIN%%  PEs  Unlimited MB/s  Limited MB/s"
+                            "  Achieved%%", 0);
+
+  for (idx = 0; idx < num_class; idx++) {
+      cls = &mbw_class[idx];
+      pct = ref_mbps ? (cls->mbps * 100) / ref_mbps : 0;
+
+      val_print(ACS_PRINT_TEST, "\n         %6d", cls->partid);
+      val_print(ACS_PRINT_TEST, "  %4d", cls->max_pct);
+      val_print(ACS_PRINT_TEST, "  %4d", cls->min_pct);
+      val_print(ACS_PRINT_TEST, "  %3d", cls->num_pe);
+      val_print(ACS_PRINT_TEST, "  %14d", cls->base_mbps);
+      val_print(ACS_PRINT_TEST, "  %12d", cls->mbps);
+      val_print(ACS_PRINT_TEST, "  %9d", pct);
+
+      if (cls->max_pct < 100 && pct > cls->max_pct)
+          val_print(ACS_PRINT_TEST, "  above MAX", 0);
+      if (cls->min_pct && pct < cls->min_pct)
+          val_print(ACS_PRINT_TEST, "  below MIN", 0);
+  }
+}
+
+/**
+  @brief   Measure one memory resource with MBW partitioning, first with no
+           limit and then with the class portions programmed.
+**/
+static
+void
+mbw_bench_rsrc(MPAM_RSRC *rsrc, uint32_t test_num)
+{
+  uint32_t pe_list[MBW_BENCH_MAX_PE];
+  uint64_t msc_base;
+  uint64_t addr_base, addr_len;
+  uint64_t ref_mbps = 0;
+  uint64_t mscbw;
+  uint32_t mbw_idr;
+  uint32_t num_pe;
+  uint32_t num_class;
+  uint32_t idx;
+  uint32_t status;
+  void *buf;
+
+  msc_base = val_mpam_get_info(MPAM_MSC_BASE_ADDR, rsrc->msc_index, 0);
+
+  if (rsrc->ris)
+      val_mpam_memory_configure_ris_sel(rsrc->msc_index, rsrc->rsrc_index);
+
+  if (!(val_mmio_read64(msc_base + MPAMF_IDR) & MPAMF_IDR_HAS_MBW_PART))
+      return;
+
+  mbw_idr = val_mmio_read(msc_base + MPAMF_MBW_IDR);
+  if (!(mbw_idr & (MPAMF_MBW_IDR_HAS_MAX | MPAMF_MBW_IDR_HAS_MIN)))
+      return;
+
+  /* PARTID 0 is left to the default traffic */
+  num_class = MBW_BENCH_NUM_CLASS;
+  if (rsrc->max_partid < num_class)
+      num_class = rsrc->max_partid;
+
+  addr_base = val_mpam_memory_get_base(rsrc->msc_index, rsrc->rsrc_index);
+  addr_len  = val_mpam_memory_get_size(rsrc->msc_index, rsrc->rsrc_index);
+  if (addr_base == SRAT_INVALID_INFO || addr_len == SRAT_INVALID_INFO)
+      return;
+
+  num_pe = pe_sync_select(MBW_BENCH_MAX_PE, pe_list);
+  if (num_pe > addr_len / (2 * MBW_BENCH_BUF_SIZE))
+      num_pe = addr_len / (2 * MBW_BENCH_BUF_SIZE);
+
+  if (num_pe < num_class || num_class == 0) {
+      val_print(ACS_PRINT_TEST, "\n       MBW bench needs %d secondary PEs", num_class);
+      return;
+  }
+
+  buf = (void *)val_mem_alloc_at_address(addr_base, (uint64_t)num_pe * 2 * MBW_BENCH_BUF_SIZE);
+  if (buf == NULL)
+      return;
+  mbw_buf_base = (uint64_t)buf;
+
+  for (idx = 0; idx < num_class; idx++) {
+      mbw_class[idx].partid    = idx + 1;
+      mbw_class[idx].num_pe    = (num_pe / num_class) + (idx < (num_pe % num_class));
+      mbw_class[idx].base_mbps = 0;
+      mbw_class[idx].mbps      = 0;
+
+      mbw_bench_part_sel(msc_base, rsrc, mbw_class[idx].partid);
+      mbw_class[idx].saved_max = val_mmio_read(msc_base + MPAMCFG_MBW_MAX);
+      mbw_class[idx].saved_min = val_mmio_read(msc_base + MPAMCFG_MBW_MIN);
+  }
+
+  mbw_bench_configure(msc_base, rsrc, mbw_idr, num_class, 0);
+  status = mbw_bench_measure(num_pe, pe_list, num_class, test_num, 0);
+
+  if (!status) {
+      mbw_bench_configure(msc_base, rsrc, mbw_idr, num_class, 1);
+      status = mbw_bench_measure(num_pe, pe_list, num_class, test_num, 1);
+  }
+
+  for (idx = 0; idx < num_class; idx++) {
+      mbw_bench_part_sel(msc_base, rsrc, mbw_class[idx].partid);
+      if (mbw_idr & MPAMF_MBW_IDR_HAS_MAX)
+          val_mmio_write(msc_base + MPAMCFG_MBW_MAX, mbw_class[idx].saved_max);
+      if (mbw_idr & MPAMF_MBW_IDR_HAS_MIN)
+          val_mmio_write(msc_base + MPAMCFG_MBW_MIN, mbw_class[idx].saved_min);
+  }
+
+  val_mem_free_at_address(mbw_buf_base, (uint64_t)num_pe * 2 * MBW_BENCH_BUF_SIZE);
+
+  if (status) {
+      val_print(ACS_PRINT_TEST, "\n       MBW bench could not run on all PEs", 0);
+      return;
+  }
+
+  /* Portions are a fraction of the MSC bandwidth, from HMAT if described,
+     else taken as the unlimited bandwidth of all classes together */
+  mscbw = val_mpam_msc_get_mscbw(rsrc->msc_index, rsrc->rsrc_index);
+  if (mscbw != HMAT_INVALID_INFO && mscbw != 0)
+      ref_mbps = mscbw;
+  else
+      for (idx = 0; idx < num_class; idx++)
+          ref_mbps += mbw_class[idx].base_mbps;
+
+  mbw_bench_report(rsrc, num_class, ref_mbps);
+}
+
+/**
+  @brief   Drive streaming traffic from several PEs, each class of PEs with
+           its own PARTID, and report the bandwidth achieved by every PARTID
+           against the MBW_MAX/MBW_MIN portions programmed on the memory MSCs.
+           Results are informational only.
+
+  @param   test_num  Test the secondary PE status is reported against
+**/
+void
+mbw_bench_run(uint32_t test_num)
+{
+  MPAM_RSRC *rsrc;
+  uint32_t rsrc_cnt;
+  uint32_t idx;
+
+  rsrc_cnt = mpam_index_type(MPAM_RSRC_TYPE_MEMORY, &rsrc);
+  for (idx = 0; idx < rsrc_cnt; idx++)
+      mbw_bench_rsrc(&rsrc[idx], test_num);
+}
@@ -0,0 +1,43 @@
+/** @file
+ * Copyright (c) 2026, Arm Limited or its affiliates. All rights reserved.
+ * SPDX-License-Identifier : Apache-2.0
+
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ **/
+
+
+#ifndef __MBW_BENCH_H__
+#define __MBW_BENCH_H__
+
+#include "perf_util.h"
+
+#define MBW_BENCH_MAX_PE      16
+#define MBW_BENCH_BUF_SIZE    0x100000   /* Per PE copy size, 1 MB */
+#define MBW_BENCH_ITER        16
+#define MBW_BENCH_NUM_CLASS   4
+
+/* One PARTID with its bandwidth portions and what its PEs achieved */
+typedef struct {
+  uint32_t max_pct;        /* MBW_MAX, percent of the MSC bandwidth */
+  uint32_t min_pct;        /* MBW_MIN, 0 for none */
+  uint32_t partid;
+  uint32_t num_pe;
+  uint64_t base_mbps;      /* Achieved with no limit programmed */
+  uint64_t mbps;           /* Achieved with the limits programmed */
+  uint32_t saved_max;      /* Register values restored after the run */
+  uint32_t saved_min;
+} MBW_CLASS;
+
+void mbw_bench_run(uint32_t test_num);
+
+#endif /* __MBW_BENCH_H__ */
@@ -0,0 +1,358 @@
+/** @file
+ * Copyright (c) 2026, Arm Limited or its affiliates. All rights reserved.
+ * SPDX-License-Identifier : Apache-2.0
+
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ **/
+
+
+#include "val/common/include/acs_val.h"
+#include "val/common/include/acs_pe.h"
+#include "val/common/include/acs_memory.h"
+#include "val/sbsa/include/sbsa_val_interface.h"
+
+#include "val/sbsa/include/sbsa_acs_pe.h"
+#include "val/sbsa/include/sbsa_acs_pmu.h"
+#include "val/sbsa/include/sbsa_acs_memory.h"
+#include "val/sbsa/include/sbsa_acs_exerciser.h"
+
+#include "pe_sync.h"
+#include "traffic_gen.h"
+#include "apmt_prof.h"
+#include "pcie_mon_bench.h"
+#include "mix_traffic.h"
+
+static PMU_EVENT_TYPE_e mix_event[MIX_MAX_MON] = {PMU_EVENT_TRAFFIC_1, PMU_EVENT_TRAFFIC_2};
+static char8_t *mix_name[] = {"CPU read ", "CPU write", "PCIe DMA "};
+
+static MIX_TRAFFIC mix_traffic;
+static uint32_t    mix_slot[MIX_MAX_CLASS];     /* Class run by each launched slot */
+static uint32_t    mix_pe_list[MIX_MAX_CLASS];
+
+static
+void
+mix_traffic_publish(void *addr, uint32_t size)
+{
+  uint64_t va;
+
+  for (va = (uint64_t)addr & ~((uint64_t)TGEN_LINE_SIZE - 1); va < (uint64_t)addr + size;
+       va += TGEN_LINE_SIZE)
+      val_data_cache_ops_by_va((addr_t)va, CLEAN_AND_INVALIDATE);
+}
+
+/**
+  @brief   Size of the CPU class buffers, several times the LLC so the
+           traffic reaches the memory side monitors rather than hitting in
+           the cache.
+**/
+static
+uint64_t
+mix_traffic_buf_size(void)
+{
+  uint32_t llc_index = val_cache_get_llc_index();
+  uint64_t cache_size = 0;
+  uint64_t size;
+
+  if (llc_index != CACHE_TABLE_EMPTY)
+      cache_size = val_cache_get_info(CACHE_SIZE, llc_index);
+
+  if (cache_size == INVALID_CACHE_INFO || cache_size == 0)
+      return MIX_BUF_DEF_SIZE;
+
+  size = MIX_BUF_LLC_MULT * cache_size;
+  if (size > MIX_BUF_MAX_SIZE)
+      size = MIX_BUF_MAX_SIZE;
+
+  return (size + MIX_CHUNK_SIZE - 1) & ~((uint64_t)MIX_CHUNK_SIZE - 1);
+}
+
+/**
+  @brief   Run the class of the slot until the primary PE stops the window.
+           CPU classes walk their buffer a chunk at a time, wrapping at the
+           end. DMA classes alternate reads and writes of memory.
+**/
+static
+void
+mix_traffic_work(uint32_t slot)
+{
+  MIX_CLASS *cls = &mix_traffic.cls[mix_slot[slot]];
+  TGEN_CFG cfg = {TGEN_OP_READ, TGEN_PATTERN_SEQ, 0, 0, 1, 0, 0, MIX_CHUNK_SIZE, 0};
+  uint64_t start = perf_get_ticks();
+  uint64_t bytes = 0;
+  uint64_t offset = 0;
+
+  if (cls->type == MIX_CPU_WRITE)
+      cfg.op = TGEN_OP_WRITE;
+
+  while (!pe_sync_stopping()) {
+      if (cls->type == MIX_PCIE_DMA) {
+          bytes += pcie_mon_drive(&cls->dma, PCIE_MON_DIR_READ, 1);
+          bytes += pcie_mon_drive(&cls->dma, PCIE_MON_DIR_WRITE, 1);
+          continue;
+      }
+
+      if (cls->type == MIX_CPU_READ)
+          cfg.src = cls->buf + offset;
+      else
+          cfg.dst = cls->buf + offset;
+
+      bytes += tgen_run(&cfg);
+      offset += MIX_CHUNK_SIZE;
+      if (offset >= cls->buf_size)
+          offset = 0;
+  }
+
+  cls->run_bytes = bytes;
+  cls->run_ticks = perf_get_ticks() - start;
+  mix_traffic_publish(cls, sizeof(MIX_CLASS));
+}
+
+/**
+  @brief   Release the PEs of the selected classes together, let them run
+           for MIX_WINDOW_NS, then stop them together and read the monitors.
+
+  @param   mix         Classes and monitors
+  @param   class_mask  Bit n set runs cls[n]
+  @param   count       Monitor counts over the window
+  @param   test_num    Test the secondary PE status is reported against
+  @return  0 on success, 1 if some PE did not run or complete.
+**/
+uint32_t
+mix_traffic_window(MIX_TRAFFIC *mix, uint32_t class_mask, uint64_t *count, uint32_t test_num)
+{
+  uint32_t idx, mon;
+  uint32_t num = 0;
+  uint64_t before[MIX_MAX_MON];
+  uint64_t start;
+
+  for (idx = 0; idx < mix->num_class; idx++) {
+      if (!(class_mask & (1 << idx)))
+          continue;
+
+      mix->cls[idx].run_bytes = 0;
+      mix->cls[idx].run_ticks = 0;
+      mix_traffic_publish(&mix->cls[idx], sizeof(MIX_CLASS));
+      mix_slot[num] = idx;
+      mix_pe_list[num++] = mix->cls[idx].pe_index;
+  }
+  mix_traffic_publish(mix_slot, sizeof(mix_slot));
+
+  for (mon = 0; mon < mix->num_mon; mon++) {
+      val_pmu_disable_monitor(mix->node_index, mon);
+      val_pmu_enable_monitor(mix->node_index, mon);
+      before[mon] = val_pmu_read_count(mix->node_index, mon);
+  }
+
+  if (pe_sync_launch(num, mix_pe_list, mix_traffic_work, test_num)) {
+      pe_sync_wait();
+      return 1;
+  }
+
+  start = pe_sync_start_ticks();
+  while (perf_ticks_to_ns(perf_get_ticks() - start) < MIX_WINDOW_NS)
+      ;
+
+  pe_sync_stop();
+  if (pe_sync_wait())
+      return 1;
+
+  for (mon = 0; mon < mix->num_mon; mon++)
+      count[mon] = (val_pmu_read_count(mix->node_index, mon) - before[mon]) & mix->wrap;
+
+  for (idx = 0; idx < mix->num_class; idx++)
+      mix_traffic_publish(&mix->cls[idx], sizeof(MIX_CLASS));
+
+  return 0;
+}
+
+/**
+  @brief   Print the bandwidth of every class alone and mixed, the counts
+           each class alone contributes per KB, and the mixed counts against
+           their expected value.
+**/
+void
+mix_traffic_report(MIX_TRAFFIC *mix)
+{
+  uint32_t idx, mon;
+  uint64_t ns;
+  MIX_CLASS *cls;
+
+  val_print(ACS_PRINT_TEST, "\n       Mixed traffic attribution, node %d", mix->node_index);
+  val_print(ACS_PRINT_TEST, "\n       Class      PE  Alone MB/s  Mixed MB/s", 0);
+  for (mon = 0; mon < mix->num_mon; mon++)
+      val_print(ACS_PRINT_TEST, "  ev%2d per KB", mix_event[mon]);
+
+  for (idx = 0; idx < mix->num_class; idx++) {
+      cls = &mix->cls[idx];
+      val_print(ACS_PRINT_TEST, "\n       ", 0);
+      val_print(ACS_PRINT_TEST, mix_name[cls->type], 0);
+      val_print(ACS_PRINT_TEST, " %4d", cls->pe_index);
+
+      ns = perf_ticks_to_ns(cls->alone_ticks);
+      val_print(ACS_PRINT_TEST, " %11d", ns ? (cls->alone_bytes * 1000) / ns : 0);
+      ns = perf_ticks_to_ns(cls->mixed_ticks);
+      val_print(ACS_PRINT_TEST, " %11d", ns ? (cls->mixed_bytes * 1000) / ns : 0);
+
+      for (mon = 0; mon < mix->num_mon; mon++)
+          val_print(ACS_PRINT_TEST, " %12d", cls->alone_bytes ?
+                    (cls->alone_count[mon] * 1024) / cls->alone_bytes : 0);
+  }
+
+  for (mon = 0; mon < mix->num_mon; mon++) {
+      val_print(ACS_PRINT_TEST, "\n       Event 0x%x mixed", mix_event[mon]);
+      val_print(ACS_PRINT_TEST, " %d", mix->mixed_count[mon]);
+      val_print(ACS_PRINT_TEST, ", expected %d", mix->expected[mon]);
+      val_print(ACS_PRINT_TEST, ", off by %d per mille", mix->dev_pm[mon]);
+
+      if (mix->dev_pm[mon] > MIX_TOL_PM)
+          val_print(ACS_PRINT_WARN, "\n       Event 0x%x misattributes overlapping traffic",
+                    mix_event[mon]);
+  }
+}
+
+/**
+  @brief   Attribution of overlapping traffic classes by the multiple traffic
+           type monitors of a node. CPU reads, CPU writes and, when there is
+           an exerciser, PCIe DMA each run on their own PE, first alone then
+           all together with a common start and stop. Results are
+           informational.
+
+  @param   node_index  APMT node of the multiple traffic interface
+  @param   num_mon     Monitors of the node
+  @param   test_num    Test the secondary PE status is reported against
+  @return  Number of monitors off their expected count.
+**/
+uint32_t
+mix_traffic_run(uint32_t node_index, uint32_t num_mon, uint32_t test_num)
+{
+  MIX_TRAFFIC *mix = &mix_traffic;
+  uint32_t pe_list[MIX_MAX_CLASS];
+  uint32_t num_pe, idx, mon;
+  uint32_t mixed_mask = 0;
+  uint64_t diff;
+  uint64_t cpu_size = mix_traffic_buf_size();
+  void *buf[MIX_MAX_CLASS] = {NULL};
+  uint32_t buf_pages[MIX_MAX_CLASS] = {0};
+  uint32_t dma = 0;
+  MIX_CLASS *cls;
+
+  val_memory_set(mix, sizeof(MIX_TRAFFIC), 0);
+  mix->node_index = node_index;
+  mix->num_mon = (num_mon > MIX_MAX_MON) ? MIX_MAX_MON : num_mon;
+  mix->wrap = apmt_prof_wrap(node_index);
+
+  num_pe = pe_sync_select(MIX_MAX_CLASS, pe_list);
+  if (num_pe < 2) {
+      val_print(ACS_PRINT_TEST, "\n       Mixed traffic needs 2 secondary PEs", 0);
+      return 0;
+  }
+
+  for (mon = 0; mon < mix->num_mon; mon++) {
+      if (val_pmu_configure_monitor(node_index, mix_event[mon], mon)) {
+          val_print(ACS_PRINT_TEST, "\n       Mixed traffic event 0x%x unsupported",
+                    mix_event[mon]);
+          return 0;
+      }
+  }
+
+  if ((num_pe > MIX_PCIE_DMA) && val_exerciser_get_info(EXERCISER_NUM_CARDS) &&
+      !val_exerciser_init(0))
+      dma = 1;
+
+  for (idx = 0; idx < MIX_PCIE_DMA + dma; idx++) {
+      cls = &mix->cls[mix->num_class];
+      buf_pages[idx] = (idx == MIX_PCIE_DMA) ? MIX_DMA_PAGES :
+                       (uint32_t)(cpu_size / val_memory_page_size());
+      buf[idx] = val_memory_alloc_pages(buf_pages[idx]);
+      if (buf[idx] == NULL) {
+          dma = (idx == MIX_PCIE_DMA) ? 0 : dma;
+          continue;
+      }
+
+      cls->type = idx;
+      cls->pe_index = pe_list[idx];
+      cls->buf = (uint64_t)buf[idx];
+      cls->buf_size = cpu_size;
+      if (idx == MIX_PCIE_DMA) {
+          cls->dma.type = PCIE_MON_SRC_EXERCISER;
+          cls->dma.instance = 0;
+          cls->dma.phys = (uint64_t)val_memory_virt_to_phys(buf[idx]);
+          cls->dma.len = val_memory_page_size() * MIX_DMA_PAGES;
+          pcie_mon_bypass(0, 1);
+      }
+      mix->num_class++;
+  }
+
+  if (mix->num_class < 2)
+      goto free_buf;
+
+  for (idx = 0; idx < mix->num_class; idx++) {
+      cls = &mix->cls[idx];
+      if (mix_traffic_window(mix, 1 << idx, cls->alone_count, test_num))
+          goto free_buf;
+
+      cls->alone_bytes = cls->run_bytes;
+      cls->alone_ticks = cls->run_ticks;
+
+      /* A class that moved nothing alone, such as a failing DMA, has no
+       * counts per byte to scale and is left out of the mixed window.
+       */
+      if (cls->alone_bytes)
+          mixed_mask |= (1 << idx);
+  }
+
+  if ((mixed_mask & (mixed_mask - 1)) == 0) {
+      val_print(ACS_PRINT_TEST, "\n       Mixed traffic needs 2 classes moving data", 0);
+      goto free_buf;
+  }
+
+  if (mix_traffic_window(mix, mixed_mask, mix->mixed_count, test_num))
+      goto free_buf;
+
+  for (idx = 0; idx < mix->num_class; idx++) {
+      if (!(mixed_mask & (1 << idx)))
+          continue;
+
+      cls = &mix->cls[idx];
+      cls->mixed_bytes = cls->run_bytes;
+      cls->mixed_ticks = cls->run_ticks;
+
+      for (mon = 0; mon < mix->num_mon; mon++)
+          mix->expected[mon] += (cls->alone_count[mon] * cls->mixed_bytes) / cls->alone_bytes;
+  }
+
+  for (mon = 0; mon < mix->num_mon; mon++) {
+      diff = (mix->mixed_count[mon] > mix->expected[mon]) ?
+             mix->mixed_count[mon] - mix->expected[mon] :
+             mix->expected[mon] - mix->mixed_count[mon];
+      mix->dev_pm[mon] = mix->expected[mon] ? (uint32_t)((diff * 1000) / mix->expected[mon]) :
+                         (mix->mixed_count[mon] ? 1000 : 0);
+      if (mix->dev_pm[mon] > MIX_TOL_PM)
+          mix->num_flagged++;
+  }
+
+  mix_traffic_report(mix);
+
+free_buf:
+  val_pmu_disable_all_monitors(node_index);
+
+  if (dma)
+      pcie_mon_bypass(0, 0);
+
+  for (idx = 0; idx < MIX_MAX_CLASS; idx++) {
+      if (buf[idx] != NULL)
+          val_memory_free_pages(buf[idx], buf_pages[idx]);
+  }
+
+  return mix->num_flagged;
+}
@@ -0,0 +1,77 @@
+/** @file
+ * Copyright (c) 2026, Arm Limited or its affiliates. All rights reserved.
+ * SPDX-License-Identifier : Apache-2.0
+
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ **/
+
+
+#ifndef __MIX_TRAFFIC_H__
+#define __MIX_TRAFFIC_H__
+
+#include "perf_util.h"
+#include "pcie_mon_bench.h"
+
+#define MIX_MAX_CLASS    3
+#define MIX_MAX_MON      2            /* PMU_EVENT_TRAFFIC_1 and PMU_EVENT_TRAFFIC_2 */
+#define MIX_BUF_LLC_MULT 4            /* LLCs spanned by a CPU buffer, so it streams from memory */
+#define MIX_BUF_MAX_SIZE 0x4000000    /* CPU buffer cap, 64 MB */
+#define MIX_BUF_DEF_SIZE 0x2000000    /* CPU buffer when the LLC size is unknown, 32 MB */
+#define MIX_DMA_PAGES    16
+#define MIX_CHUNK_SIZE   0x10000      /* Bytes per tgen_run between stop checks */
+#define MIX_WINDOW_NS    2000000      /* Time every window runs before the stop */
+#define MIX_TOL_PM       100          /* Per mille a mixed count may be off its expected */
+
+typedef enum {
+  MIX_CPU_READ = 0,
+  MIX_CPU_WRITE,
+  MIX_PCIE_DMA
+} MIX_CLASS_TYPE;
+
+/* One traffic class, run by its own PE */
+typedef struct {
+  uint32_t type;                        /* MIX_* */
+  uint32_t pe_index;
+  uint64_t buf;                         /* CPU classes */
+  uint64_t buf_size;                    /* Multiple of MIX_CHUNK_SIZE */
+  PCIE_MON_SRC dma;                     /* DMA class */
+  uint64_t run_bytes;                   /* Set by the PE at the end of a window */
+  uint64_t run_ticks;
+  uint64_t alone_bytes;                 /* Window with the class running alone */
+  uint64_t alone_ticks;
+  uint64_t alone_count[MIX_MAX_MON];
+  uint64_t mixed_bytes;                 /* Window with every class running */
+  uint64_t mixed_ticks;
+} MIX_CLASS;
+
+/* The counts of a monitor with every class running are expected to be the
+ * sum of the counts of each class alone, scaled by the bytes it moved.
+ */
+typedef struct {
+  uint32_t node_index;
+  uint32_t num_mon;
+  uint64_t wrap;
+  uint32_t num_class;
+  MIX_CLASS cls[MIX_MAX_CLASS];
+  uint64_t mixed_count[MIX_MAX_MON];
+  uint64_t expected[MIX_MAX_MON];
+  uint32_t dev_pm[MIX_MAX_MON];
+  uint32_t num_flagged;
+} MIX_TRAFFIC;
+
+uint32_t mix_traffic_window(MIX_TRAFFIC *mix, uint32_t class_mask, uint64_t *count,
+                            uint32_t test_num);
+void     mix_traffic_report(MIX_TRAFFIC *mix);
+uint32_t mix_traffic_run(uint32_t node_index, uint32_t num_mon, uint32_t test_num);
+
+#endif /* __MIX_TRAFFIC_H__ */
@@ -0,0 +1,205 @@
+/** @file
+ * Copyright (c) 2026, Arm Limited or its affiliates. All rights reserved.
+ * SPDX-License-Identifier : Apache-2.0
+
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ **/
+
+
+#include "val/sbsa/include/sbsa_val_interface.h"
+#include "val/common/include/acs_val.h"
+#include "val/common/include/acs_common.h"
+#include "val/sbsa/include/sbsa_acs_mpam.h"
+
+#include "mpam_index.h"
+
+/* Sorted by type then desc1, resources of a key keep the MSC table order */
+static MPAM_RSRC mpam_rsrc[MPAM_INDEX_MAX_RSRC];
+static uint32_t  mpam_num_rsrc;
+static uint32_t  mpam_num_msc;
+static uint32_t  mpam_num_dropped;   /* Resources not indexed because the index was full */
+static uint32_t  mpam_built;
+
+static
+int32_t
+mpam_index_cmp(uint32_t type, uint64_t desc1, MPAM_RSRC *rsrc)
+{
+  if (type != rsrc->type)
+      return (type < rsrc->type) ? -1 : 1;
+
+  if (desc1 != rsrc->desc1)
+      return (desc1 < rsrc->desc1) ? -1 : 1;
+
+  return 0;
+}
+
+/**
+  @brief   Insert a node at its sorted position, after any node of the same
+           key so the MSC table order is kept.
+**/
+static
+void
+mpam_index_insert(MPAM_RSRC *rsrc)
+{
+  uint32_t pos = mpam_num_rsrc;
+
+  while (pos > 0 && mpam_index_cmp(rsrc->type, rsrc->desc1, &mpam_rsrc[pos - 1]) < 0) {
+      mpam_rsrc[pos] = mpam_rsrc[pos - 1];
+      pos--;
+  }
+
+  mpam_rsrc[pos] = *rsrc;
+  mpam_num_rsrc++;
+}
+
+/**
+  @brief   Walk the MPAM info table once and read the MSC features of every
+           resource node.
+**/
+static
+void
+mpam_index_build(void)
+{
+  uint32_t msc_index, rsrc_index;
+  uint32_t rsrc_cnt;
+  uint32_t ris;
+  MPAM_RSRC rsrc;
+
+  mpam_built = 1;
+  mpam_num_rsrc = 0;
+  mpam_num_dropped = 0;
+  mpam_num_msc = val_mpam_get_msc_count();
+
+  for (msc_index = 0; msc_index < mpam_num_msc; msc_index++) {
+      rsrc_cnt = val_mpam_get_info(MPAM_MSC_RSRC_COUNT, msc_index, 0);
+      ris = val_mpam_msc_supports_ris(msc_index);
+
+      for (rsrc_index = 0; rsrc_index < rsrc_cnt; rsrc_index++) {
+          if (mpam_num_rsrc >= MPAM_INDEX_MAX_RSRC) {
+              if (mpam_num_dropped == 0)
+                  val_print(ACS_PRINT_WARN, "\n       MPAM index full at MSC %d", msc_index);
+              mpam_num_dropped++;
+              continue;
+          }
+
+          val_memory_set(&rsrc, sizeof(rsrc), 0);
+          rsrc.msc_index  = msc_index;
+          rsrc.rsrc_index = rsrc_index;
+          rsrc.type  = val_mpam_get_info(MPAM_MSC_RSRC_TYPE, msc_index, rsrc_index);
+          rsrc.desc1 = val_mpam_get_info(MPAM_MSC_RSRC_DESC1, msc_index, rsrc_index);
+          rsrc.desc2 = val_mpam_get_info(MPAM_MSC_RSRC_DESC2, msc_index, rsrc_index);
+          rsrc.nrdy  = val_mpam_get_info(MPAM_MSC_NRDY, msc_index, 0);
+          rsrc.ris   = ris;
+
+          /* Point the ID registers at this resource */
+          if (ris)
+              val_mpam_memory_configure_ris_sel(msc_index, rsrc_index);
+
+          rsrc.cpor       = val_mpam_supports_cpor(msc_index);
+          rsrc.csumon     = val_mpam_supports_csumon(msc_index);
+          rsrc.mbwumon    = val_mpam_msc_supports_mbwumon(msc_index);
+          rsrc.max_pmg    = val_mpam_get_max_pmg(msc_index);
+          rsrc.max_partid = val_mpam_get_max_partid(msc_index);
+          if (rsrc.csumon)
+              rsrc.csumon_count = val_mpam_get_csumon_count(msc_index);
+
+          mpam_index_insert(&rsrc);
+      }
+  }
+}
+
+/**
+  @brief   Number of MSCs in the MPAM info table.
+**/
+uint32_t
+mpam_index_num_msc(void)
+{
+  if (!mpam_built)
+      mpam_index_build();
+
+  return mpam_num_msc;
+}
+
+/**
+  @brief   Number of resource nodes left out of the index because it was full.
+           Tests that need every node of the table skip when this is not 0.
+**/
+uint32_t
+mpam_index_dropped(void)
+{
+  if (!mpam_built)
+      mpam_index_build();
+
+  return mpam_num_dropped;
+}
+
+/**
+  @brief   Find the resource nodes of a type with a given descriptor 1, the
+           PE cache of a cache ID or the memory of a proximity domain.
+
+  @param   type   MPAM_RSRC_TYPE_*
+  @param   desc1  Locator descriptor 1
+  @param   first  Set to the first matching node
+  @return  Number of consecutive matching nodes.
+**/
+uint32_t
+mpam_index_find(uint32_t type, uint64_t desc1, MPAM_RSRC **first)
+{
+  uint32_t lo = 0, hi, mid;
+  uint32_t count = 0;
+
+  if (!mpam_built)
+      mpam_index_build();
+
+  hi = mpam_num_rsrc;
+  while (lo < hi) {
+      mid = (lo + hi) / 2;
+      if (mpam_index_cmp(type, desc1, &mpam_rsrc[mid]) > 0)
+          lo = mid + 1;
+      else
+          hi = mid;
+  }
+
+  *first = &mpam_rsrc[lo];
+  while ((lo + count) < mpam_num_rsrc &&
+         mpam_index_cmp(type, desc1, &mpam_rsrc[lo + count]) == 0)
+      count++;
+
+  return count;
+}
+
+/**
+  @brief   Find every resource node of a type.
+
+  @return  Number of consecutive nodes starting at first.
+**/
+uint32_t
+mpam_index_type(uint32_t type, MPAM_RSRC **first)
+{
+  uint32_t idx;
+  uint32_t count = 0;
+
+  if (!mpam_built)
+      mpam_index_build();
+
+  for (idx = 0; idx < mpam_num_rsrc; idx++) {
+      if (mpam_rsrc[idx].type != type)
+          continue;
+
+      if (count == 0)
+          *first = &mpam_rsrc[idx];
+      count++;
+  }
+
+  return count;
+}
@@ -0,0 +1,48 @@
+/** @file
+ * Copyright (c) 2026, Arm Limited or its affiliates. All rights reserved.
+ * SPDX-License-Identifier : Apache-2.0
+
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ **/
+
+
+#ifndef __MPAM_INDEX_H__
+#define __MPAM_INDEX_H__
+
+#define MPAM_INDEX_MAX_RSRC  1024
+
+/* One MSC resource node with the MSC features seen through it. With RIS the
+ * MSC ID registers describe the selected resource, so features are per node.
+ */
+typedef struct {
+  uint32_t msc_index;
+  uint32_t rsrc_index;
+  uint32_t type;           /* MPAM_RSRC_TYPE_* */
+  uint64_t desc1;          /* Cache ID for PE caches, proximity domain for memory */
+  uint64_t desc2;
+  uint32_t ris;
+  uint32_t cpor;
+  uint32_t csumon;
+  uint32_t csumon_count;
+  uint32_t mbwumon;
+  uint32_t max_pmg;
+  uint32_t max_partid;
+  uint64_t nrdy;           /* MPAM_MSC_NRDY */
+} MPAM_RSRC;
+
+uint32_t mpam_index_num_msc(void);
+uint32_t mpam_index_dropped(void);
+uint32_t mpam_index_find(uint32_t type, uint64_t desc1, MPAM_RSRC **first);
+uint32_t mpam_index_type(uint32_t type, MPAM_RSRC **first);
+
+#endif /* __MPAM_INDEX_H__ */
@@ -0,0 +1,48 @@
+/** @file
+ * Copyright (c) 2026, Arm Limited or its affiliates. All rights reserved.
+ * SPDX-License-Identifier : Apache-2.0
+
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ **/
+
+
+#ifndef __MPAM_MSC_H__
+#define __MPAM_MSC_H__
+
+/* MSC memory mapped registers not covered by the val MPAM interface */
+#define MPAMF_IDR                0x0000
+#define MPAMF_CPOR_IDR           0x0030
+#define MPAMF_MBW_IDR            0x0040
+#define MPAMCFG_PART_SEL         0x0100
+#define MPAMCFG_MBW_MIN          0x0200
+#define MPAMCFG_MBW_MAX          0x0208
+#define MSMON_CFG_MON_SEL        0x0800
+#define MSMON_CSU                0x0840
+#define MPAMCFG_CPBM             0x1000
+
+#define MPAMF_IDR_HAS_MBW_PART   (1u << 26)
+
+#define MPAMF_CPOR_IDR_CPBM_WD(v) ((v) & 0xFFFF)
+
+#define MPAMF_MBW_IDR_BWA_WD(v)  ((v) & 0x3F)
+#define MPAMF_MBW_IDR_HAS_MIN    (1u << 10)
+#define MPAMF_MBW_IDR_HAS_MAX    (1u << 11)
+
+#define MPAMCFG_PART_SEL_RIS(r)  (((uint32_t)(r) & 0xF) << 24)
+#define MPAMCFG_MBW_MAX_HARDLIM  (1u << 31)
+
+#define MSMON_CFG_MON_SEL_RIS(r) (((uint32_t)(r) & 0xF) << 24)
+#define MSMON_CSU_VALUE(v)       ((v) & 0x7FFFFFFF)
+#define MSMON_CSU_NRDY           (1u << 31)
+
+#endif /* __MPAM_MSC_H__ */
@@ -0,0 +1,321 @@
+/** @file
+ * Copyright (c) 2026, Arm Limited or its affiliates. All rights reserved.
+ * SPDX-License-Identifier : Apache-2.0
+
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ **/
+
+#include "val/common/include/acs_val.h"
+#include "val/common/include/acs_pe.h"
+#include "val/common/include/acs_iovirt.h"
+#include "val/sbsa/include/sbsa_val_interface.h"
+
+#include "val/common/include/acs_pcie_enumeration.h"
+#include "val/sbsa/include/sbsa_acs_pcie.h"
+#include "val/sbsa/include/sbsa_acs_exerciser.h"
+
+#include "comp_ring.h"
+#include "route_map.h"
+#include "msi_bench.h"
+
+#define MSI_BENCH_TIMEOUT  0x100000
+
+static COMP_RING        msi_ring;
+static COMP_RING_ENTRY  msi_ring_buf[MSI_BENCH_RING_SIZE];
+static uint64_t         fire_ts[MSI_BENCH_MAX_VECTORS];
+static uint32_t         pending;    /* Vectors fired and not yet completed */
+
+static MSI_BENCH_RESULT its_result[MSI_BENCH_MAX_ITS];
+static MSI_BENCH_RESULT pe_result[MSI_BENCH_MAX_PE];
+static MSI_BENCH_RESULT step_result[MSI_BENCH_MAX_STEPS];
+static PERF_STATS       step_drain[MSI_BENCH_MAX_STEPS];
+
+/**
+  @brief   Common body of the per vector handlers. Only the arrival time and
+           the receiving PE are recorded, latencies are computed by the caller.
+**/
+static
+void
+msi_bench_complete(uint32_t vector)
+{
+  uint32_t pe_index = val_pe_get_index_mpid(val_pe_get_mpid());
+
+  comp_ring_push(&msi_ring, vector, pe_index, perf_get_ticks());
+  val_gic_end_of_interrupt(MSI_BENCH_LPI_BASE + vector);
+}
+
+/* val_gic_install_isr handlers take no argument, so each vector gets its own */
+#define MSI_BENCH_ISR(n) \
+  static void msi_bench_isr_##n(void) { msi_bench_complete(n); }
+
+MSI_BENCH_ISR(0)  MSI_BENCH_ISR(1)  MSI_BENCH_ISR(2)  MSI_BENCH_ISR(3)
+MSI_BENCH_ISR(4)  MSI_BENCH_ISR(5)  MSI_BENCH_ISR(6)  MSI_BENCH_ISR(7)
+MSI_BENCH_ISR(8)  MSI_BENCH_ISR(9)  MSI_BENCH_ISR(10) MSI_BENCH_ISR(11)
+MSI_BENCH_ISR(12) MSI_BENCH_ISR(13) MSI_BENCH_ISR(14) MSI_BENCH_ISR(15)
+
+static void (*msi_bench_isr[MSI_BENCH_MAX_VECTORS])(void) = {
+  msi_bench_isr_0,  msi_bench_isr_1,  msi_bench_isr_2,  msi_bench_isr_3,
+  msi_bench_isr_4,  msi_bench_isr_5,  msi_bench_isr_6,  msi_bench_isr_7,
+  msi_bench_isr_8,  msi_bench_isr_9,  msi_bench_isr_10, msi_bench_isr_11,
+  msi_bench_isr_12, msi_bench_isr_13, msi_bench_isr_14, msi_bench_isr_15
+};
+
+static
+void
+msi_bench_result_init(MSI_BENCH_RESULT *result, uint32_t num)
+{
+  uint32_t idx;
+
+  for (idx = 0; idx < num; idx++) {
+      perf_stats_init(&result[idx].latency);
+      perf_hist_init(&result[idx].hist);
+  }
+}
+
+static
+void
+msi_bench_result_add(MSI_BENCH_RESULT *result, uint64_t latency_ns)
+{
+  perf_stats_add(&result->latency, latency_ns);
+  perf_hist_add(&result->hist, latency_ns);
+}
+
+/**
+  @brief   Wait for the MSIs still outstanding from the previous burst and
+           drop their completions, so late arrivals are not counted against
+           the next burst.
+**/
+static
+void
+msi_bench_drain(void)
+{
+  uint32_t timeout = MSI_BENCH_TIMEOUT;
+  COMP_RING_ENTRY entry;
+
+  while (pending && (--timeout > 0)) {
+      if (comp_ring_pop(&msi_ring, &entry) && (entry.int_id < MSI_BENCH_MAX_VECTORS))
+          pending &= ~(1u << entry.int_id);
+  }
+
+  while (comp_ring_pop(&msi_ring, &entry))
+      ;
+
+  pending = 0;
+}
+
+/**
+  @brief   Fire one MSI on each of the first num_vec vectors of an exerciser
+           and collect the completions.
+
+  @param   instance  Exerciser instance
+  @param   its_id    ITS the exerciser MSIs are translated by
+  @param   num_vec   Number of active vectors
+  @param   step      Index of num_vec in the scaling table
+  @param   gap       Delay between two MSIs in system counter ticks
+  @return  Number of MSIs which did not arrive before the timeout.
+**/
+static
+uint32_t
+msi_bench_burst(uint32_t instance, uint32_t its_id, uint32_t num_vec,
+                uint32_t step, uint64_t gap)
+{
+  uint32_t vec;
+  uint32_t received = 0;
+  uint32_t timeout = MSI_BENCH_TIMEOUT;
+  uint64_t start;
+  uint64_t last = 0;
+  uint64_t latency;
+  COMP_RING_ENTRY entry;
+
+  msi_bench_drain();
+
+  start = perf_get_ticks();
+
+  for (vec = 0; vec < num_vec; vec++) {
+      if (gap)
+          while ((perf_get_ticks() - start) < (gap * vec))
+              ;
+
+      fire_ts[vec] = perf_get_ticks();
+      pending |= (1u << vec);
+      val_exerciser_ops(GENERATE_MSI, vec, instance);
+  }
+
+  while ((received < num_vec) && (--timeout > 0)) {
+      if (!comp_ring_pop(&msi_ring, &entry))
+          continue;
+
+      if ((entry.int_id >= num_vec) || !(pending & (1u << entry.int_id)))
+          continue;
+
+      pending &= ~(1u << entry.int_id);
+      received++;
+      last = entry.timestamp;
+      latency = perf_ticks_to_ns(entry.timestamp - fire_ts[entry.int_id]);
+
+      msi_bench_result_add(&its_result[its_id], latency);
+      msi_bench_result_add(&step_result[step], latency);
+      if (entry.data < MSI_BENCH_MAX_PE)
+          msi_bench_result_add(&pe_result[entry.data], latency);
+  }
+
+  if (received)
+      perf_stats_add(&step_drain[step], perf_ticks_to_ns(last - start));
+
+  return num_vec - received;
+}
+
+static
+void
+msi_bench_report(void)
+{
+  uint32_t idx;
+  uint64_t avg;
+
+  val_print(ACS_PRINT_TEST, "\n       MSI delivery latency per ITS (ns)", 0);
+  for (idx = 0; idx < MSI_BENCH_MAX_ITS; idx++) {
+      if (its_result[idx].latency.count == 0)
+          continue;
+
+      val_print(ACS_PRINT_TEST, "\n       ITS %d", idx);
+      perf_stats_print(ACS_PRINT_TEST, "", &its_result[idx].latency);
+      perf_hist_print(ACS_PRINT_INFO, &its_result[idx].hist);
+  }
+
+  val_print(ACS_PRINT_TEST, "\n       MSI delivery latency per target PE (ns)", 0);
+  for (idx = 0; idx < MSI_BENCH_MAX_PE; idx++) {
+      if (pe_result[idx].latency.count == 0)
+          continue;
+
+      val_print(ACS_PRINT_TEST, "\n       PE %d", idx);
+      perf_stats_print(ACS_PRINT_TEST, "", &pe_result[idx].latency);
+  }
+
+  val_print(ACS_PRINT_TEST, "\n       MSI delivery vs active vectors", 0);
+  for (idx = 0; idx < MSI_BENCH_MAX_STEPS; idx++) {
+      if (step_result[idx].latency.count == 0)
+          continue;
+
+      val_print(ACS_PRINT_TEST, "\n       Vectors %2d", 1 << idx);
+      val_print(ACS_PRINT_TEST, " avg latency %d ns", perf_stats_avg(&step_result[idx].latency));
+      val_print(ACS_PRINT_TEST, " max %d ns", step_result[idx].latency.max);
+
+      avg = perf_stats_avg(&step_drain[idx]);
+      val_print(ACS_PRINT_TEST, " burst drained in %d ns", avg);
+      if (avg)
+          val_print(ACS_PRINT_TEST, " (%d MSI/ms)", ((uint64_t)(1 << idx) * 1000000) / avg);
+  }
+}
+
+/**
+  @brief   MSI/LPI delivery benchmark. Every exerciser fires MSIs to a growing
+           number of vectors; each MSI is timestamped at generation and in its
+           ISR and the latency distribution is reported per ITS, per PE which
+           took the interrupt, and per number of active vectors.
+
+  @param   cfg  Benchmark parameters
+  @return  Number of MSIs lost, 0 if every MSI was delivered.
+**/
+uint32_t
+msi_bench_run(MSI_BENCH_CFG *cfg)
+{
+  uint32_t instance;
+  uint32_t num_ex;
+  uint32_t e_bdf;
+  uint32_t msi_cap_offset;
+  uint32_t reg_value;
+  uint32_t device_id;
+  uint32_t stream_id;
+  uint32_t its_id;
+  uint32_t max_vec;
+  uint32_t num_vec;
+  uint32_t mapped;
+  uint32_t step;
+  uint32_t round;
+  uint32_t lost = 0;
+  uint64_t gap;
+
+  comp_ring_init(&msi_ring, msi_ring_buf, MSI_BENCH_RING_SIZE);
+  msi_bench_result_init(its_result, MSI_BENCH_MAX_ITS);
+  msi_bench_result_init(pe_result, MSI_BENCH_MAX_PE);
+  msi_bench_result_init(step_result, MSI_BENCH_MAX_STEPS);
+  for (step = 0; step < MSI_BENCH_MAX_STEPS; step++)
+      perf_stats_init(&step_drain[step]);
+
+  gap = ((uint64_t)cfg->gap_ns * perf_get_freq()) / 1000000000ULL;
+
+  num_ex = val_exerciser_get_info(EXERCISER_NUM_CARDS);
+  for (instance = 0; instance < num_ex; instance++) {
+      if (val_exerciser_init(instance))
+          continue;
+
+      e_bdf = val_exerciser_get_bdf(instance);
+
+      if (val_pcie_find_capability(e_bdf, PCIE_CAP, CID_MSIX, &msi_cap_offset)) {
+          val_print(ACS_PRINT_DEBUG, "\n       No MSI-X Capability for Bdf 0x%x", e_bdf);
+          continue;
+      }
+
+      if (route_map_device_info(e_bdf, &device_id, &stream_id, &its_id)) {
+          val_print(ACS_PRINT_ERR, "\n       iovirt_get_device failed for bdf 0x%x", e_bdf);
+          continue;
+      }
+
+      if (its_id >= MSI_BENCH_MAX_ITS) {
+          val_print(ACS_PRINT_WARN, "\n       ITS %d not benchmarked", its_id);
+          continue;
+      }
+
+      /* MSI-X table size is encoded as N-1 in Message Control */
+      val_pcie_read_cfg(e_bdf, msi_cap_offset, &reg_value);
+      max_vec = ((reg_value >> 16) & 0x7FF) + 1;
+      if (max_vec > cfg->max_vectors)
+          max_vec = cfg->max_vectors;
+      if (max_vec > MSI_BENCH_MAX_VECTORS)
+          max_vec = MSI_BENCH_MAX_VECTORS;
+
+      for (mapped = 0; mapped < max_vec; mapped++) {
+          if (val_gic_request_msi(e_bdf, device_id, its_id, MSI_BENCH_LPI_BASE + mapped, mapped))
+              break;
+
+          if (val_gic_install_isr(MSI_BENCH_LPI_BASE + mapped, msi_bench_isr[mapped])) {
+              val_gic_free_msi(e_bdf, device_id, its_id, MSI_BENCH_LPI_BASE + mapped, mapped);
+              break;
+          }
+      }
+
+      val_print(ACS_PRINT_DEBUG, "\n       Exerciser %d", instance);
+      val_print(ACS_PRINT_DEBUG, " vectors mapped %d", mapped);
+
+      for (num_vec = 1, step = 0; (num_vec <= mapped) && (step < MSI_BENCH_MAX_STEPS);
+           num_vec <<= 1, step++) {
+          for (round = 0; round < cfg->rounds; round++)
+              lost += msi_bench_burst(instance, its_id, num_vec, step, gap);
+      }
+
+      msi_bench_drain();
+
+      while (mapped-- != 0)
+          val_gic_free_msi(e_bdf, device_id, its_id, MSI_BENCH_LPI_BASE + mapped, mapped);
+  }
+
+  msi_bench_report();
+
+  if (lost)
+      val_print(ACS_PRINT_WARN, "\n       MSIs not delivered : %d", lost);
+
+  if (msi_ring.dropped)
+      val_print(ACS_PRINT_WARN, "\n       Completions dropped : %d", msi_ring.dropped);
+
+  return lost;
+}
@@ -0,0 +1,43 @@
+/** @file
+ * Copyright (c) 2026, Arm Limited or its affiliates. All rights reserved.
+ * SPDX-License-Identifier : Apache-2.0
+
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ **/
+
+#ifndef __MSI_BENCH_H__
+#define __MSI_BENCH_H__
+
+#include "perf_util.h"
+
+#define MSI_BENCH_MAX_VECTORS  16
+#define MSI_BENCH_MAX_STEPS    5    /* 1, 2, 4, 8, 16 active vectors */
+#define MSI_BENCH_MAX_ITS      16
+#define MSI_BENCH_MAX_PE       256
+#define MSI_BENCH_LPI_BASE     0x2080
+#define MSI_BENCH_RING_SIZE    64
+
+typedef struct {
+  uint32_t max_vectors;   /* Vectors exercised per exerciser, capped by its MSI-X table */
+  uint32_t rounds;        /* Bursts fired for each active vector count */
+  uint32_t gap_ns;        /* Delay between two MSIs of a burst, 0 for back to back */
+} MSI_BENCH_CFG;
+
+typedef struct {
+  PERF_STATS latency;     /* Generation to ISR entry, ns */
+  PERF_HIST  hist;
+} MSI_BENCH_RESULT;
+
+uint32_t msi_bench_run(MSI_BENCH_CFG *cfg);
+
+#endif /* __MSI_BENCH_H__ */
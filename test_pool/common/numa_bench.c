@@ -0,0 +1,370 @@
+/** @file
+ * Copyright (c) 2026, Arm Limited or its affiliates. All rights reserved.
+ * SPDX-License-Identifier : Apache-2.0
+
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ **/
+
+
+#include "val/common/include/acs_val.h"
+#include "val/common/include/acs_pe.h"
+#include "val/common/include/acs_memory.h"
+#include "val/sbsa/include/sbsa_val_interface.h"
+#include "val/sbsa/include/sbsa_acs_pe.h"
+#include "val/sbsa/include/sbsa_acs_pmu.h"
+#include "val/sbsa/include/sbsa_acs_memory.h"
+#include "val/sbsa/include/sbsa_acs_mpam.h"
+
+#include "pe_sync.h"
+#include "traffic_gen.h"
+#include "mpam_index.h"
+#include "numa_bench.h"
+
+/* Work handed to the initiator PE of a cell */
+typedef struct {
+  uint64_t src;
+  uint64_t dst;
+  uint64_t chain;
+  NUMA_CELL *cell;
+} NUMA_JOB;
+
+static NUMA_JOB numa_job;
+static NUMA_MATRIX numa_matrix;
+
+static
+void
+numa_bench_publish(void *addr, uint32_t size)
+{
+  uint64_t va;
+
+  for (va = (uint64_t)addr & ~((uint64_t)TGEN_LINE_SIZE - 1); va < (uint64_t)addr + size;
+       va += TGEN_LINE_SIZE)
+      val_data_cache_ops_by_va((addr_t)va, CLEAN_AND_INVALIDATE);
+}
+
+static
+uint64_t
+numa_bench_mbps(uint64_t bytes, uint64_t ticks)
+{
+  uint64_t ns = perf_ticks_to_ns(ticks);
+
+  return ns ? (bytes * 1000) / ns : 0;
+}
+
+/**
+  @brief   Stream and chase the buffers of the job on the calling PE. Each
+           access pattern runs once untimed first so the TLBs are warm.
+**/
+static
+void
+numa_bench_cell(NUMA_JOB *job)
+{
+  NUMA_CELL *cell = job->cell;
+  TGEN_CFG read = {TGEN_OP_READ, TGEN_PATTERN_SEQ, 0, 0, 1, 0, 0, NUMA_BENCH_BUF_SIZE, 0};
+  TGEN_CFG write = {TGEN_OP_WRITE, TGEN_PATTERN_SEQ, 0, 1, 1, 0, 0, NUMA_BENCH_BUF_SIZE, 0};
+  uint64_t ptr;
+  uint64_t start;
+  uint64_t bytes;
+
+  read.src = job->src;
+  write.dst = job->dst;
+
+  bytes = tgen_run(&read);
+  bytes += tgen_run(&read);
+  cell->read_mbps = numa_bench_mbps(tgen_bytes(&read), read.ticks);
+
+  bytes += tgen_run(&write);
+  bytes += tgen_run(&write);
+  cell->write_mbps = numa_bench_mbps(tgen_bytes(&write), write.ticks);
+
+  ptr = tgen_chase(job->chain, NUMA_BENCH_CHASE_LOADS);
+  start = perf_get_ticks();
+  tgen_chase(ptr, NUMA_BENCH_CHASE_LOADS);
+  cell->load_ps = (perf_ticks_to_ns(perf_get_ticks() - start) * 1000) / NUMA_BENCH_CHASE_LOADS;
+  bytes += 2ULL * NUMA_BENCH_CHASE_LOADS * TGEN_LINE_SIZE;
+
+  cell->bytes = bytes;
+  cell->measured = 1;
+}
+
+static
+void
+numa_bench_work(uint32_t slot)
+{
+  (void)slot;
+
+  numa_bench_cell(&numa_job);
+  numa_bench_publish(numa_job.cell, sizeof(NUMA_CELL));
+}
+
+/**
+  @brief   Bandwidth the HMAT advertises for a memory proximity domain, as
+           VAL reports it for the MPAM memory resource of the domain. VAL
+           gives read and write bandwidth combined.
+
+  @param   mem_domain  Memory proximity domain
+  @param   bw          Advertised read plus write bandwidth
+  @return  0 on success, 1 if no MPAM memory resource or HMAT entry
+           describes the domain.
+**/
+uint32_t
+numa_bench_hmat_bw(uint64_t mem_domain, uint64_t *bw)
+{
+  MPAM_RSRC *rsrc;
+
+  if (mpam_index_find(MPAM_RSRC_TYPE_MEMORY, mem_domain, &rsrc) == 0)
+      return 1;
+
+  *bw = val_mpam_msc_get_mscbw(rsrc->msc_index, rsrc->rsrc_index);
+
+  return (*bw == HMAT_INVALID_INFO);
+}
+
+/**
+  @brief   Find the initiator domains from the SRAT GICC entries, the
+           calling PE first, and the memory domains large enough to hold the
+           benchmark buffers from the SRAT memory ranges.
+
+  @return  Number of cells in the matrix.
+**/
+uint32_t
+numa_bench_discover(NUMA_MATRIX *matrix)
+{
+  uint32_t my_index = val_pe_get_index_mpid(val_pe_get_mpid());
+  uint32_t num_pe = val_pe_get_num();
+  uint32_t pe, idx;
+  uint64_t range, num_mem_range;
+  uint64_t domain, base, len;
+
+  val_memory_set(matrix, sizeof(NUMA_MATRIX), 0);
+
+  for (pe = 0; pe < num_pe && matrix->num_init < NUMA_BENCH_MAX_DOMAIN; pe++) {
+      /* Slot 0 is the calling PE, the others in index order */
+      idx = (pe == 0) ? my_index : ((pe <= my_index) ? pe - 1 : pe);
+      domain = val_srat_get_info(SRAT_GICC_PROX_DOMAIN, val_pe_get_uid(idx));
+      if (domain == SRAT_INVALID_INFO)
+          continue;
+
+      for (range = 0; range < matrix->num_init; range++) {
+          if (matrix->init_domain[range] == domain)
+              break;
+      }
+      if (range < matrix->num_init)
+          continue;
+
+      matrix->init_domain[matrix->num_init] = domain;
+      matrix->init_pe[matrix->num_init] = idx;
+      matrix->num_init++;
+  }
+
+  num_mem_range = val_srat_get_info(SRAT_MEM_NUM_MEM_RANGE, 0);
+  if (num_mem_range == SRAT_INVALID_INFO)
+      num_mem_range = 0;
+
+  for (range = 0; range < num_mem_range && matrix->num_mem < NUMA_BENCH_MAX_DOMAIN; range++) {
+      domain = val_srat_get_prox_domain(range);
+      if (domain == SRAT_INVALID_INFO)
+          continue;
+
+      base = val_srat_get_info(SRAT_MEM_BASE_ADDR, domain);
+      len = val_srat_get_info(SRAT_MEM_ADDR_LEN, domain);
+      if ((base == SRAT_INVALID_INFO) || (len == SRAT_INVALID_INFO) ||
+          (len <= 2 * NUMA_BENCH_BUF_SIZE + NUMA_BENCH_CHAIN_SIZE))
+          continue;
+
+      for (idx = 0; idx < matrix->num_mem; idx++) {
+          if (matrix->mem_domain[idx] == domain)
+              break;
+      }
+      if (idx < matrix->num_mem)
+          continue;
+
+      matrix->mem_domain[matrix->num_mem] = domain;
+      matrix->mem_base[matrix->num_mem] = base;
+      matrix->mem_len[matrix->num_mem] = len;
+      matrix->num_mem++;
+  }
+
+  return matrix->num_init * matrix->num_mem;
+}
+
+/**
+  @brief   Measure every cell of the matrix. The initiator PE of a remote
+           domain runs the job through pe_sync while the calling PE waits.
+           The total bandwidth monitor of the memory domain's APMT node, when
+           there is one, counts the traffic of each cell.
+
+  @param   matrix    Matrix from numa_bench_discover
+  @param   test_num  Test the secondary PE status is reported against
+**/
+void
+numa_bench_measure(NUMA_MATRIX *matrix, uint32_t test_num)
+{
+  uint32_t init, mem;
+  uint32_t node_index;
+  uint32_t apmt;
+  uint64_t before;
+  void *src_buf, *dest_buf, *chain_buf;
+  NUMA_CELL *cell;
+
+  for (mem = 0; mem < matrix->num_mem; mem++) {
+      src_buf = (void *)val_mem_alloc_at_address(matrix->mem_base[mem], NUMA_BENCH_BUF_SIZE);
+      dest_buf = (void *)val_mem_alloc_at_address(matrix->mem_base[mem] + NUMA_BENCH_BUF_SIZE,
+                                                  NUMA_BENCH_BUF_SIZE);
+      chain_buf = (void *)val_mem_alloc_at_address(matrix->mem_base[mem] +
+                                                   2 * NUMA_BENCH_BUF_SIZE,
+                                                   NUMA_BENCH_CHAIN_SIZE);
+
+      if ((src_buf != NULL) && (dest_buf != NULL) && (chain_buf != NULL)) {
+          numa_job.src = (uint64_t)src_buf;
+          numa_job.dst = (uint64_t)dest_buf;
+          numa_job.chain = tgen_chain_build((uint64_t)chain_buf, NUMA_BENCH_CHAIN_SIZE);
+
+          node_index = val_pmu_get_node_index(matrix->mem_domain[mem]);
+          apmt = (node_index != PMU_INVALID_INDEX) &&
+                 (val_pmu_get_monitor_count(node_index) >= 1) &&
+                 !val_pmu_configure_monitor(node_index, PMU_EVENT_IB_TOTAL_BW, 0);
+
+          for (init = 0; init < matrix->num_init; init++) {
+              cell = &matrix->cell[init][mem];
+              numa_job.cell = cell;
+              numa_bench_publish(&numa_job, sizeof(numa_job));
+              numa_bench_publish(cell, sizeof(NUMA_CELL));
+
+              if (apmt) {
+                  val_pmu_disable_monitor(node_index, 0);
+                  val_pmu_enable_monitor(node_index, 0);
+              }
+              before = apmt ? val_pmu_read_count(node_index, 0) : 0;
+
+              if (init == 0) {
+                  numa_bench_cell(&numa_job);
+              } else if (pe_sync_launch(1, &matrix->init_pe[init], numa_bench_work, test_num) ||
+                         pe_sync_wait()) {
+                  val_print(ACS_PRINT_WARN, "\n       NUMA bench PE %d did not complete",
+                            matrix->init_pe[init]);
+                  continue;
+              }
+
+              numa_bench_publish(cell, sizeof(NUMA_CELL));
+              if (apmt) {
+                  cell->apmt_bytes = val_pmu_read_count(node_index, 0) - before;
+                  cell->apmt_valid = 1;
+              }
+          }
+
+          if (apmt)
+              val_pmu_disable_all_monitors(node_index);
+      } else {
+          val_print(ACS_PRINT_WARN, "\n       NUMA bench buffers unavailable in domain %d",
+                    matrix->mem_domain[mem]);
+      }
+
+      if (src_buf != NULL)
+          val_mem_free_at_address((uint64_t)src_buf, NUMA_BENCH_BUF_SIZE);
+      if (dest_buf != NULL)
+          val_mem_free_at_address((uint64_t)dest_buf, NUMA_BENCH_BUF_SIZE);
+      if (chain_buf != NULL)
+          val_mem_free_at_address((uint64_t)chain_buf, NUMA_BENCH_CHAIN_SIZE);
+  }
+}
+
+static
+void
+numa_bench_print_row(NUMA_MATRIX *matrix, uint32_t init, uint32_t what)
+{
+  uint32_t mem;
+  NUMA_CELL *cell;
+
+  val_print(ACS_PRINT_TEST, "\n       PE dom %4d |", matrix->init_domain[init]);
+  for (mem = 0; mem < matrix->num_mem; mem++) {
+      cell = &matrix->cell[init][mem];
+      if (!cell->measured || (what == 3 && !cell->apmt_valid)) {
+          val_print(ACS_PRINT_TEST, "        -", 0);
+          continue;
+      }
+
+      switch (what) {
+      case 0:
+          val_print(ACS_PRINT_TEST, " %8d", cell->read_mbps);
+          break;
+      case 1:
+          val_print(ACS_PRINT_TEST, " %8d", cell->write_mbps);
+          break;
+      case 2:
+          val_print(ACS_PRINT_TEST, " %8d", cell->load_ps / 1000);
+          break;
+      default:
+          val_print(ACS_PRINT_TEST, " %7d%%",
+                    cell->bytes ? (cell->apmt_bytes * 100) / cell->bytes : 0);
+          break;
+      }
+  }
+}
+
+/**
+  @brief   Print the measured matrices, the APMT count as a percentage of
+           the bytes requested, and the HMAT advertised bandwidth of each
+           memory domain below the measured ones.
+**/
+void
+numa_bench_report(NUMA_MATRIX *matrix)
+{
+  uint32_t what, init, mem;
+  uint64_t hmat_bw;
+
+  for (what = 0; what < 4; what++) {
+      if (what == 0)
+          val_print(ACS_PRINT_TEST, "\n       NUMA read MB/s", 0);
+      else if (what == 1)
+          val_print(ACS_PRINT_TEST, "\n       NUMA NT write MB/s", 0);
+      else if (what == 2)
+          val_print(ACS_PRINT_TEST, "\n       NUMA load latency ns", 0);
+      else
+          val_print(ACS_PRINT_TEST, "\n       NUMA APMT count / requested bytes", 0);
+      val_print(ACS_PRINT_TEST, "\n       Mem dom     |", 0);
+      for (mem = 0; mem < matrix->num_mem; mem++)
+          val_print(ACS_PRINT_TEST, " %8d", matrix->mem_domain[mem]);
+
+      for (init = 0; init < matrix->num_init; init++)
+          numa_bench_print_row(matrix, init, what);
+  }
+
+  val_print(ACS_PRINT_TEST, "\n       HMAT rd+wr  |", 0);
+  for (mem = 0; mem < matrix->num_mem; mem++) {
+      if (numa_bench_hmat_bw(matrix->mem_domain[mem], &hmat_bw))
+          val_print(ACS_PRINT_TEST, "        -", 0);
+      else
+          val_print(ACS_PRINT_TEST, " %8d", hmat_bw);
+  }
+}
+
+/**
+  @brief   Measure and print the NUMA matrix. Results are informational.
+
+  @param   test_num  Test the secondary PE status is reported against
+  @return  The measured matrix, NULL if there was nothing to measure.
+**/
+NUMA_MATRIX *
+numa_bench_run(uint32_t test_num)
+{
+  if (numa_bench_discover(&numa_matrix) == 0) {
+      val_print(ACS_PRINT_TEST, "\n       NUMA bench found no initiator/memory domain pair", 0);
+      return NULL;
+  }
+
+  numa_bench_measure(&numa_matrix, test_num);
+  numa_bench_report(&numa_matrix);
+
+  return &numa_matrix;
+}
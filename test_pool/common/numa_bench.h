@@ -0,0 +1,60 @@
+/** @file
+ * Copyright (c) 2026, Arm Limited or its affiliates. All rights reserved.
+ * SPDX-License-Identifier : Apache-2.0
+
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ **/
+
+
+#ifndef __NUMA_BENCH_H__
+#define __NUMA_BENCH_H__
+
+#include "perf_util.h"
+
+#define NUMA_BENCH_MAX_DOMAIN   8
+#define NUMA_BENCH_BUF_SIZE     0x2000000   /* Streamed buffers, 32 MB each */
+#define NUMA_BENCH_CHAIN_SIZE   0x1000000   /* Pointer chase working set, 16 MB */
+#define NUMA_BENCH_CHASE_LOADS  0x10000
+
+/* One initiator domain accessing one memory domain */
+typedef struct {
+  uint64_t read_mbps;      /* Streaming read bandwidth */
+  uint64_t write_mbps;     /* Streaming non-temporal write bandwidth */
+  uint64_t load_ps;        /* Pointer chase latency per load */
+  uint64_t bytes;          /* Bytes the streams and the chase requested from memory */
+  uint64_t apmt_bytes;     /* Counted by the memory node total bandwidth monitor */
+  uint32_t apmt_valid;     /* The memory domain has a usable APMT node */
+  uint32_t measured;
+} NUMA_CELL;
+
+/* Measured NxM matrix, initiator proximity domains by memory proximity domains.
+ * Each initiator domain is represented by its first PE.
+ */
+typedef struct {
+  uint32_t num_init;
+  uint64_t init_domain[NUMA_BENCH_MAX_DOMAIN];
+  uint32_t init_pe[NUMA_BENCH_MAX_DOMAIN];
+  uint32_t num_mem;
+  uint64_t mem_domain[NUMA_BENCH_MAX_DOMAIN];
+  uint64_t mem_base[NUMA_BENCH_MAX_DOMAIN];
+  uint64_t mem_len[NUMA_BENCH_MAX_DOMAIN];
+  NUMA_CELL cell[NUMA_BENCH_MAX_DOMAIN][NUMA_BENCH_MAX_DOMAIN];
+} NUMA_MATRIX;
+
+uint32_t     numa_bench_hmat_bw(uint64_t mem_domain, uint64_t *bw);
+uint32_t     numa_bench_discover(NUMA_MATRIX *matrix);
+void         numa_bench_measure(NUMA_MATRIX *matrix, uint32_t test_num);
+void         numa_bench_report(NUMA_MATRIX *matrix);
+NUMA_MATRIX *numa_bench_run(uint32_t test_num);
+
+#endif /* __NUMA_BENCH_H__ */
@@ -0,0 +1,400 @@
+/** @file
+ * Copyright (c) 2026, Arm Limited or its affiliates. All rights reserved.
+ * SPDX-License-Identifier : Apache-2.0
+
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ **/
+
+
+#include "val/common/include/acs_val.h"
+#include "val/sbsa/include/sbsa_val_interface.h"
+
+#include "val/sbsa/include/sbsa_acs_pmu.h"
+#include "val/sbsa/include/sbsa_acs_smmu.h"
+#include "val/sbsa/include/sbsa_acs_memory.h"
+#include "val/common/include/acs_pcie_enumeration.h"
+#include "val/sbsa/include/sbsa_acs_pcie.h"
+#include "val/sbsa/include/sbsa_acs_exerciser.h"
+
+#include "route_map.h"
+#include "smmu_caps.h"
+#include "apmt_prof.h"
+#include "pcie_mon_bench.h"
+
+/* Monitors programmed for each traffic source, total, read then write */
+static PMU_EVENT_TYPE_e src_event[][PCIE_MON_NUM_MON] = {
+  {PMU_EVENT_IB_TOTAL_BW, PMU_EVENT_IB_READ_BW, PMU_EVENT_IB_WRITE_BW},
+  {PMU_EVENT_OB_TOTAL_BW, PMU_EVENT_OB_READ_BW, PMU_EVENT_OB_WRITE_BW}
+};
+
+static PCIE_MON_RESULT pcie_mon_result;
+static APMT_PROF       pcie_mon_prof;
+static uint64_t        pcie_mon_smmu_off;   /* Bit per SMMU disabled by pcie_mon_bypass */
+
+/**
+  @brief   Drive a known volume through a root complex.
+
+  @param   src  Traffic source
+  @param   dir  PCIE_MON_DIR_READ or PCIE_MON_DIR_WRITE
+  @param   ops  DMAs, or passes over the config space of every function
+  @return  Bytes transferred, up to the first failed DMA.
+**/
+uint64_t
+pcie_mon_drive(PCIE_MON_SRC *src, uint32_t dir, uint32_t ops)
+{
+  uint64_t bytes = 0;
+  uint32_t idx;
+  uint32_t reg_value;
+  pcie_device_bdf_table *bdf_tbl_ptr;
+
+  if (src->type == PCIE_MON_SRC_EXERCISER) {
+      val_exerciser_set_param(DMA_ATTRIBUTES, src->phys, src->len, src->instance);
+      while (ops--) {
+          if (val_exerciser_ops(START_DMA, (dir == PCIE_MON_DIR_READ) ? EDMA_TO_DEVICE :
+                                EDMA_FROM_DEVICE, src->instance)) {
+              val_print(ACS_PRINT_DEBUG, "\n       DMA failed for exerciser %d", src->instance);
+              break;
+          }
+          bytes += src->len;
+      }
+      return bytes;
+  }
+
+  /* Writes go to the read-only vendor ID, so they have no side effect */
+  bdf_tbl_ptr = val_pcie_bdf_table_ptr();
+  while (ops--) {
+      for (idx = 0; idx < bdf_tbl_ptr->num_entries; idx++) {
+          if (dir == PCIE_MON_DIR_READ)
+              val_pcie_read_cfg(bdf_tbl_ptr->device[idx].bdf, TYPE01_VIDR, &reg_value);
+          else
+              val_pcie_write_cfg(bdf_tbl_ptr->device[idx].bdf, TYPE01_VIDR, 0xFFFFFFFF);
+          bytes += src->len;
+      }
+  }
+
+  return bytes;
+}
+
+/* Restart the monitors of the node from zero */
+static
+void
+pcie_mon_reset(uint32_t node_index)
+{
+  uint32_t mon;
+
+  for (mon = 0; mon < PCIE_MON_NUM_MON; mon++) {
+      val_pmu_disable_monitor(node_index, mon);
+      val_pmu_enable_monitor(node_index, mon);
+  }
+}
+
+/**
+  @brief   Poll the total bandwidth monitor until it stays unchanged for
+           PCIE_MON_STABLE_POLLS reads.
+
+  @param   node_index  APMT node
+  @param   value       Counter value on entry, the settled value on return
+  @return  Ticks when the counter last changed, the entry time if it did not.
+**/
+static
+uint64_t
+pcie_mon_settle(uint32_t node_index, uint64_t *value)
+{
+  uint64_t changed = perf_get_ticks();
+  uint64_t count;
+  uint32_t poll, stable = 0;
+
+  for (poll = 0; poll < PCIE_MON_UPDATE_POLLS && stable < PCIE_MON_STABLE_POLLS; poll++) {
+      count = val_pmu_read_count(node_index, 0);
+      if (count != *value) {
+          *value = count;
+          changed = perf_get_ticks();
+          stable = 0;
+      } else {
+          stable++;
+      }
+  }
+
+  return changed;
+}
+
+/**
+  @brief   Measure the monitors of a root complex node with its traffic
+           source: counter read cost, delay from an operation completing
+           to the counter settling, and the counts of bursts of growing
+           size against the bytes transferred. The counters are let settle
+           after each burst so late updates are not lost.
+
+  @param   res  node_index, src and wrap set by the caller
+**/
+void
+pcie_mon_node(PCIE_MON_RESULT *res)
+{
+  uint32_t node_index = res->node_index;
+  uint32_t point, mon, idx;
+  uint64_t start, done;
+  uint64_t count;
+  uint64_t before[PCIE_MON_NUM_MON];
+  uint64_t mbps, max_mbps = 0;
+  uint64_t ns;
+  PCIE_MON_POINT *pt;
+
+  pcie_mon_reset(node_index);
+
+  start = perf_get_ticks();
+  for (idx = 0; idx < PCIE_MON_READ_SAMPLES; idx++)
+      val_pmu_read_count(node_index, 0);
+  res->read_cost_ns = perf_ticks_to_ns(perf_get_ticks() - start) / PCIE_MON_READ_SAMPLES;
+
+  count = val_pmu_read_count(node_index, 0);
+  pcie_mon_drive(&res->src, PCIE_MON_DIR_READ, 1);
+  done = perf_get_ticks();
+  start = pcie_mon_settle(node_index, &count);
+  res->update_ns = (start > done) ? perf_ticks_to_ns(start - done) : 0;
+
+  for (point = 0; point < PCIE_MON_POINTS; point++) {
+      pt = &res->point[point];
+      pcie_mon_reset(node_index);
+      for (mon = 0; mon < PCIE_MON_NUM_MON; mon++)
+          before[mon] = val_pmu_read_count(node_index, mon);
+
+      start = perf_get_ticks();
+      pt->expected = pcie_mon_drive(&res->src, PCIE_MON_DIR_READ, PCIE_MON_BASE_OPS << point);
+      pt->expected += pcie_mon_drive(&res->src, PCIE_MON_DIR_WRITE, PCIE_MON_BASE_OPS << point);
+      pt->ticks = perf_get_ticks() - start;
+
+      count = before[0];
+      pcie_mon_settle(node_index, &count);
+
+      pt->counted = (count - before[0]) & res->wrap;
+      pt->read = (val_pmu_read_count(node_index, 1) - before[1]) & res->wrap;
+      pt->write = (val_pmu_read_count(node_index, 2) - before[2]) & res->wrap;
+
+      ns = perf_ticks_to_ns(pt->ticks);
+      mbps = ns ? (pt->expected * 1000) / ns : 0;
+      if (mbps > max_mbps)
+          max_mbps = mbps;
+  }
+
+  /* Bytes per us is MB/s, so the wrap time in us is the range over it */
+  res->wrap_ms = max_mbps ? (res->wrap / max_mbps) / 1000 : ~0ULL;
+}
+
+/**
+  @brief   Print the results of a node. A counter that wraps within the
+           telemetry period cannot be sampled at that period without losing
+           counts, as a wrap cannot be told from a small delta.
+**/
+void
+pcie_mon_report(PCIE_MON_RESULT *res)
+{
+  uint32_t point;
+  uint64_t ns;
+  PCIE_MON_POINT *pt;
+
+  val_print(ACS_PRINT_TEST, "\n       PCIe monitors, node %d", res->node_index);
+  if (res->src.type == PCIE_MON_SRC_EXERCISER)
+      val_print(ACS_PRINT_TEST, ", exerciser %d DMA", res->src.instance);
+  else
+      val_print(ACS_PRINT_TEST, ", config space stand-in", 0);
+
+  val_print(ACS_PRINT_TEST, "\n       Counter mask 0x%llx", res->wrap);
+  val_print(ACS_PRINT_TEST, ", read %d ns", res->read_cost_ns);
+  val_print(ACS_PRINT_TEST, ", update latency %d ns", res->update_ns);
+  val_print(ACS_PRINT_TEST,
+            "\n          Ops     Expected      Counted  Per mille   Read     Write    MB/s", 0);
+
+  for (point = 0; point < PCIE_MON_POINTS; point++) {
+      pt = &res->point[point];
+      ns = perf_ticks_to_ns(pt->ticks);
+
+      val_print(ACS_PRINT_TEST, "\n       %6d", PCIE_MON_BASE_OPS << point);
+      val_print(ACS_PRINT_TEST, " %12d", pt->expected);
+      val_print(ACS_PRINT_TEST, " %12d", pt->counted);
+      val_print(ACS_PRINT_TEST, " %10d", pt->expected ? (pt->counted * 1000) / pt->expected : 0);
+      val_print(ACS_PRINT_TEST, " %8d", pt->read);
+      val_print(ACS_PRINT_TEST, " %8d", pt->write);
+      val_print(ACS_PRINT_TEST, " %7d", ns ? (pt->expected * 1000) / ns : 0);
+  }
+
+  if (res->wrap_ms == ~0ULL)
+      return;
+
+  val_print(ACS_PRINT_TEST, "\n       Counter wraps in %d ms at the peak rate", res->wrap_ms);
+  if (res->wrap_ms < PCIE_MON_TELEMETRY_MS)
+      val_print(ACS_PRINT_WARN, "\n       Counter wraps within the %d ms telemetry period",
+                PCIE_MON_TELEMETRY_MS);
+}
+
+/**
+  @brief   Bypass, or restore, the SMMU of an exerciser. DMAs of the
+           benchmark target physical addresses. Only an SMMU found enabled
+           is disabled, and only an SMMU disabled here is enabled again, so
+           the state the caller left the SMMU in is kept. Exercisers may
+           share an SMMU. Only SMMUv3 is bypassed.
+**/
+void
+pcie_mon_bypass(uint32_t instance, uint32_t bypass)
+{
+  uint32_t smmu_index = route_map_smmu_index(val_exerciser_get_bdf(instance));
+
+  if ((smmu_index == ACS_INVALID_INDEX) || (smmu_index >= SMMU_CAPS_MAX))
+      return;
+
+  if (!bypass) {
+      if (pcie_mon_smmu_off & (1ULL << smmu_index)) {
+          val_smmu_enable(smmu_index);
+          pcie_mon_smmu_off &= ~(1ULL << smmu_index);
+      }
+      return;
+  }
+
+  if (!smmu_caps_enabled(smmu_index))
+      return;
+
+  val_smmu_disable(smmu_index);
+  pcie_mon_smmu_off |= (1ULL << smmu_index);
+}
+
+/* Program the monitors of the node for the source, 0 on success */
+static
+uint32_t
+pcie_mon_configure(uint32_t node_index, uint32_t type)
+{
+  uint32_t mon;
+
+  for (mon = 0; mon < PCIE_MON_NUM_MON; mon++) {
+      if (val_pmu_configure_monitor(node_index, src_event[type][mon], mon))
+          return 1;
+  }
+
+  return 0;
+}
+
+/**
+  @brief   Pick the traffic source of a node: the exerciser whose DMAs move
+           the inbound monitor the most, else the config space stand-in.
+**/
+static
+void
+pcie_mon_pick_source(PCIE_MON_RESULT *res, uint32_t num_ex, uint64_t phys, uint32_t len)
+{
+  uint32_t instance;
+  uint64_t before, count, delta, best = 0;
+  PCIE_MON_SRC src = {PCIE_MON_SRC_EXERCISER, 0, phys, len};
+
+  res->src.type = PCIE_MON_SRC_CFG;
+  res->src.len = 4;
+
+  if ((num_ex == 0) || pcie_mon_configure(res->node_index, PCIE_MON_SRC_EXERCISER))
+      return;
+
+  for (instance = 0; instance < num_ex; instance++) {
+      if (val_exerciser_init(instance))
+          continue;
+
+      src.instance = instance;
+      pcie_mon_reset(res->node_index);
+      before = val_pmu_read_count(res->node_index, 0);
+      count = before;
+      pcie_mon_drive(&src, PCIE_MON_DIR_READ, PCIE_MON_BASE_OPS);
+      pcie_mon_settle(res->node_index, &count);
+      delta = (count - before) & res->wrap;
+
+      if (delta > best) {
+          best = delta;
+          res->src = src;
+      }
+  }
+}
+
+/**
+  @brief   Bandwidth monitor benchmark of every PCIe root complex APMT node.
+           Each node is driven by the exerciser behind it, or by config
+           space accesses when there is none, and its time series is
+           sampled while the traffic runs. Results are informational.
+
+  @return  Number of nodes measured.
+**/
+uint32_t
+pcie_mon_bench_run(void)
+{
+  uint32_t node_count = val_pmu_get_info(PMU_NODE_COUNT, 0);
+  uint32_t num_ex = val_exerciser_get_info(EXERCISER_NUM_CARDS);
+  uint32_t node_index, instance, mon;
+  uint32_t measured = 0;
+  uint32_t len = 0;
+  uint64_t phys = 0;
+  uint32_t round;
+  void *buf = NULL;
+  PCIE_MON_RESULT *res = &pcie_mon_result;
+
+  if (num_ex) {
+      buf = val_memory_alloc_pages(PCIE_MON_NUM_PAGES);
+      if (buf == NULL) {
+          val_print(ACS_PRINT_WARN, "\n       PCIe monitor benchmark buffer alloc failure", 0);
+          num_ex = 0;
+      } else {
+          phys = (uint64_t)val_memory_virt_to_phys(buf);
+          len = val_memory_page_size() * PCIE_MON_NUM_PAGES;
+      }
+  }
+
+  for (instance = 0; instance < num_ex; instance++)
+      pcie_mon_bypass(instance, 1);
+
+  for (node_index = 0; node_index < node_count; node_index++) {
+      if ((val_pmu_get_info(PMU_NODE_TYPE, node_index) != PMU_NODE_PCIE_RC) ||
+          (val_pmu_get_monitor_count(node_index) < PCIE_MON_NUM_MON))
+          continue;
+
+      val_memory_set(res, sizeof(PCIE_MON_RESULT), 0);
+      res->node_index = node_index;
+      res->wrap = apmt_prof_wrap(node_index);
+
+      pcie_mon_pick_source(res, num_ex, phys, len);
+      if (pcie_mon_configure(node_index, res->src.type)) {
+          val_print(ACS_PRINT_DEBUG, "\n       PCIe monitor events unsupported at node %d",
+                    node_index);
+          val_pmu_disable_all_monitors(node_index);
+          continue;
+      }
+
+      pcie_mon_node(res);
+      pcie_mon_report(res);
+
+      /* Time series of back to back bursts */
+      apmt_prof_init(&pcie_mon_prof, PCIE_MON_PERIOD_NS);
+      for (mon = 0; mon < PCIE_MON_NUM_MON; mon++)
+          apmt_prof_add_monitor(&pcie_mon_prof, node_index, mon, src_event[res->src.type][mon]);
+
+      apmt_prof_start(&pcie_mon_prof);
+      for (round = 0; round < PCIE_MON_RAMP_ROUNDS; round++) {
+          pcie_mon_drive(&res->src, PCIE_MON_DIR_READ, PCIE_MON_BASE_OPS);
+          pcie_mon_drive(&res->src, PCIE_MON_DIR_WRITE, PCIE_MON_BASE_OPS);
+          apmt_prof_poll(&pcie_mon_prof);
+      }
+      apmt_prof_stop(&pcie_mon_prof);
+      apmt_prof_report(&pcie_mon_prof);
+
+      measured++;
+  }
+
+  for (instance = 0; instance < num_ex; instance++)
+      pcie_mon_bypass(instance, 0);
+
+  if (buf != NULL)
+      val_memory_free_pages(buf, PCIE_MON_NUM_PAGES);
+
+  return measured;
+}
@@ -0,0 +1,78 @@
+/** @file
+ * Copyright (c) 2026, Arm Limited or its affiliates. All rights reserved.
+ * SPDX-License-Identifier : Apache-2.0
+
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ **/
+
+
+#ifndef __PCIE_MON_BENCH_H__
+#define __PCIE_MON_BENCH_H__
+
+#include "perf_util.h"
+
+#define PCIE_MON_NUM_MON       3          /* Total, read and write bandwidth */
+#define PCIE_MON_POINTS        4          /* Operations per burst doubling from PCIE_MON_BASE_OPS */
+#define PCIE_MON_BASE_OPS      8
+#define PCIE_MON_NUM_PAGES     16         /* Exerciser DMA buffer */
+#define PCIE_MON_READ_SAMPLES  64         /* Counter reads timed for the read cost */
+#define PCIE_MON_UPDATE_POLLS  100000     /* Polls waiting for the counter to settle */
+#define PCIE_MON_STABLE_POLLS  64         /* Unchanged polls taken as settled */
+#define PCIE_MON_PERIOD_NS     10000      /* Sampling period of the time series */
+#define PCIE_MON_TELEMETRY_MS  1000       /* Sampling period the monitors must sustain */
+#define PCIE_MON_RAMP_ROUNDS   32         /* Sampled bursts of the time series */
+
+#define PCIE_MON_DIR_READ      0          /* Memory or config space read */
+#define PCIE_MON_DIR_WRITE     1
+
+/* Traffic driven through a root complex. The exerciser DMAs are inbound,
+ * the config space stand-in used without an exerciser is outbound.
+ */
+typedef enum {
+  PCIE_MON_SRC_EXERCISER = 0,
+  PCIE_MON_SRC_CFG
+} PCIE_MON_SRC_TYPE;
+
+typedef struct {
+  uint32_t type;           /* PCIE_MON_SRC_* */
+  uint32_t instance;       /* Exerciser instance */
+  uint64_t phys;           /* DMA buffer as seen by the exerciser */
+  uint32_t len;            /* Bytes per DMA, 4 per config access */
+} PCIE_MON_SRC;
+
+/* One burst of the accuracy and saturation sweep */
+typedef struct {
+  uint64_t expected;       /* Bytes read plus bytes written by the burst */
+  uint64_t counted;        /* Total bandwidth monitor */
+  uint64_t read;           /* Read bandwidth monitor */
+  uint64_t write;          /* Write bandwidth monitor */
+  uint64_t ticks;
+} PCIE_MON_POINT;
+
+typedef struct {
+  uint32_t node_index;
+  PCIE_MON_SRC src;
+  uint64_t wrap;           /* Mask of the implemented counter bits */
+  uint64_t read_cost_ns;   /* One counter read, bounds the sampling rate */
+  uint64_t update_ns;      /* Operation completion to the counter settling */
+  PCIE_MON_POINT point[PCIE_MON_POINTS];
+  uint64_t wrap_ms;        /* Counter wrap time at the highest measured bandwidth */
+} PCIE_MON_RESULT;
+
+uint64_t pcie_mon_drive(PCIE_MON_SRC *src, uint32_t dir, uint32_t ops);
+void     pcie_mon_bypass(uint32_t instance, uint32_t bypass);
+void     pcie_mon_node(PCIE_MON_RESULT *res);
+void     pcie_mon_report(PCIE_MON_RESULT *res);
+uint32_t pcie_mon_bench_run(void);
+
+#endif /* __PCIE_MON_BENCH_H__ */
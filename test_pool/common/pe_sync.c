@@ -0,0 +1,237 @@
+/** @file
+ * Copyright (c) 2026, Arm Limited or its affiliates. All rights reserved.
+ * SPDX-License-Identifier : Apache-2.0
+
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ **/
+
+
+#include "val/common/include/acs_val.h"
+#include "val/common/include/acs_pe.h"
+#include "val/common/include/acs_memory.h"
+#include "val/sbsa/include/sbsa_val_interface.h"
+
+#include "perf_util.h"
+#include "pe_sync.h"
+
+/* One cache line per PE so a flag update does not disturb the neighbours */
+typedef struct {
+  volatile uint32_t ready;
+  volatile uint32_t done;
+  uint32_t pe_index;
+  uint32_t pad[13];
+} PE_SYNC_SLOT;
+
+static PE_SYNC_SLOT      sync_slot[PE_SYNC_MAX_PE] __attribute__((aligned(64)));
+static volatile uint32_t sync_go;
+static volatile uint32_t sync_stop;
+static uint32_t          sync_num_pe;
+static uint32_t          sync_test_num;
+static PE_SYNC_WORK      sync_work;
+static uint64_t          sync_start_ticks;
+
+static
+void
+pe_sync_publish(volatile void *addr)
+{
+  val_data_cache_ops_by_va((addr_t)addr, CLEAN_AND_INVALIDATE);
+}
+
+static
+uint32_t
+pe_sync_read(volatile uint32_t *addr)
+{
+  val_data_cache_ops_by_va((addr_t)addr, CLEAN_AND_INVALIDATE);
+  return *addr;
+}
+
+/**
+  @brief   Entry point on every secondary PE. Reports ready, waits for the
+           common start, runs the work and reports done.
+**/
+static
+void
+pe_sync_worker(void)
+{
+  uint32_t index = val_pe_get_index_mpid(val_pe_get_mpid());
+  uint32_t slot;
+
+  for (slot = 0; slot < sync_num_pe; slot++)
+      if (sync_slot[slot].pe_index == index)
+          break;
+
+  if (slot < sync_num_pe) {
+      sync_slot[slot].ready = 1;
+      pe_sync_publish(&sync_slot[slot].ready);
+
+      while (!pe_sync_read(&sync_go))
+          ;
+
+      if (!pe_sync_read(&sync_stop))
+          sync_work(slot);
+
+      sync_slot[slot].done = 1;
+      pe_sync_publish(&sync_slot[slot].done);
+  }
+
+  val_set_status(index, RESULT_PASS(sync_test_num, 01));
+}
+
+/**
+  @brief   Pick up to max_pe PEs other than the calling one.
+
+  @param   max_pe   Size of pe_list, capped at PE_SYNC_MAX_PE
+  @param   pe_list  Filled with PE indexes
+  @return  Number of PEs selected.
+**/
+uint32_t
+pe_sync_select(uint32_t max_pe, uint32_t *pe_list)
+{
+  uint32_t my_index = val_pe_get_index_mpid(val_pe_get_mpid());
+  uint32_t num_pe = val_pe_get_num();
+  uint32_t index;
+  uint32_t count = 0;
+
+  if (max_pe > PE_SYNC_MAX_PE)
+      max_pe = PE_SYNC_MAX_PE;
+
+  for (index = 0; index < num_pe && count < max_pe; index++) {
+      if (index == my_index)
+          continue;
+      pe_list[count++] = index;
+  }
+
+  return count;
+}
+
+/**
+  @brief   Dispatch work on every listed PE and release them together once
+           all of them are ready, so the measured windows overlap.
+
+  @param   num_pe    Number of PEs in pe_list, at most PE_SYNC_MAX_PE
+  @param   pe_list   Secondary PE indexes, the calling PE must not be listed
+  @param   work      Work run on each PE
+  @param   test_num  Test the PE status is reported against
+  @return  0 once all PEs are running, 1 if some PE never became ready.
+**/
+uint32_t
+pe_sync_launch(uint32_t num_pe, uint32_t *pe_list, PE_SYNC_WORK work, uint32_t test_num)
+{
+  uint32_t slot;
+  uint32_t timeout;
+
+  if (num_pe > PE_SYNC_MAX_PE)
+      num_pe = PE_SYNC_MAX_PE;
+
+  sync_num_pe   = num_pe;
+  sync_test_num = test_num;
+  sync_work     = work;
+  sync_go       = 0;
+  sync_stop     = 0;
+
+  for (slot = 0; slot < num_pe; slot++) {
+      sync_slot[slot].pe_index = pe_list[slot];
+      sync_slot[slot].ready    = 0;
+      sync_slot[slot].done     = 0;
+  }
+
+  val_data_cache_ops_by_va((addr_t)&sync_num_pe, CLEAN_AND_INVALIDATE);
+  val_data_cache_ops_by_va((addr_t)&sync_test_num, CLEAN_AND_INVALIDATE);
+  val_data_cache_ops_by_va((addr_t)&sync_work, CLEAN_AND_INVALIDATE);
+  pe_sync_publish(&sync_go);
+  pe_sync_publish(&sync_stop);
+  for (slot = 0; slot < num_pe; slot++)
+      pe_sync_publish(&sync_slot[slot]);
+
+  for (slot = 0; slot < num_pe; slot++) {
+      val_set_status(pe_list[slot], RESULT_PENDING(test_num));
+      val_execute_on_pe(pe_list[slot], pe_sync_worker, 0);
+  }
+
+  for (slot = 0; slot < num_pe; slot++) {
+      timeout = PE_SYNC_TIMEOUT;
+      while (!pe_sync_read(&sync_slot[slot].ready) && --timeout)
+          ;
+
+      if (timeout == 0) {
+          val_print(ACS_PRINT_WARN, "\n       PE %d did not start", pe_list[slot]);
+          sync_stop = 1;
+          pe_sync_publish(&sync_stop);
+          sync_go = 1;
+          pe_sync_publish(&sync_go);
+          return 1;
+      }
+  }
+
+  sync_start_ticks = perf_get_ticks();
+  sync_go = 1;
+  pe_sync_publish(&sync_go);
+
+  return 0;
+}
+
+/**
+  @brief   Ask the running work to finish, for work that runs until stopped.
+**/
+void
+pe_sync_stop(void)
+{
+  sync_stop = 1;
+  pe_sync_publish(&sync_stop);
+}
+
+/**
+  @brief   Polled by the work on the secondary PEs.
+
+  @return  1 once pe_sync_stop has been called.
+**/
+uint32_t
+pe_sync_stopping(void)
+{
+  return pe_sync_read(&sync_stop);
+}
+
+/**
+  @brief   Wait for the work to complete on every launched PE.
+
+  @return  Number of PEs which did not complete.
+**/
+uint32_t
+pe_sync_wait(void)
+{
+  uint32_t slot;
+  uint32_t timeout;
+  uint32_t missing = 0;
+
+  for (slot = 0; slot < sync_num_pe; slot++) {
+      timeout = PE_SYNC_TIMEOUT;
+      while (!pe_sync_read(&sync_slot[slot].done) && --timeout)
+          ;
+
+      if (timeout == 0) {
+          val_print(ACS_PRINT_WARN, "\n       PE %d did not complete", sync_slot[slot].pe_index);
+          missing++;
+      }
+  }
+
+  return missing;
+}
+
+/**
+  @brief   Time at which the PEs were released by the last launch.
+**/
+uint64_t
+pe_sync_start_ticks(void)
+{
+  return sync_start_ticks;
+}
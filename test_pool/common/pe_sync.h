@@ -0,0 +1,38 @@
+/** @file
+ * Copyright (c) 2026, Arm Limited or its affiliates. All rights reserved.
+ * SPDX-License-Identifier : Apache-2.0
+
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ **/
+
+
+#ifndef __PE_SYNC_H__
+#define __PE_SYNC_H__
+
+#define PE_SYNC_MAX_PE    64
+#define PE_SYNC_TIMEOUT   0x10000000
+
+/* Work run on a secondary PE between the start and the done barrier. slot is
+ * the position of the PE in the list given to pe_sync_launch.
+ */
+typedef void (*PE_SYNC_WORK)(uint32_t slot);
+
+uint32_t pe_sync_select(uint32_t max_pe, uint32_t *pe_list);
+uint32_t pe_sync_launch(uint32_t num_pe, uint32_t *pe_list, PE_SYNC_WORK work,
+                        uint32_t test_num);
+void     pe_sync_stop(void);
+uint32_t pe_sync_stopping(void);
+uint32_t pe_sync_wait(void);
+uint64_t pe_sync_start_ticks(void);
+
+#endif /* __PE_SYNC_H__ */
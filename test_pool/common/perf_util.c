@@ -0,0 +1,157 @@
+/** @file
+ * Copyright (c) 2026, Arm Limited or its affiliates. All rights reserved.
+ * SPDX-License-Identifier : Apache-2.0
+
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ **/
+
+#include "val/common/include/acs_val.h"
+#include "val/common/include/acs_timer.h"
+#include "val/common/include/acs_timer_support.h"
+
+#include "perf_util.h"
+
+#define NSEC_PER_SEC 1000000000ULL
+
+static uint64_t counter_freq;
+
+/**
+  @brief   Return the current system counter value. The system counter is
+           common to all PEs, so timestamps taken on different PEs compare.
+**/
+uint64_t
+perf_get_ticks(void)
+{
+  return ArmReadCntPct();
+}
+
+/**
+  @brief   Return the system counter frequency in Hz, cached after the first call.
+**/
+uint64_t
+perf_get_freq(void)
+{
+  if (counter_freq == 0)
+      counter_freq = val_timer_get_info(TIMER_INFO_CNTFREQ, 0);
+
+  return counter_freq;
+}
+
+/**
+  @brief   Convert a system counter delta into nanoseconds.
+
+  @param   ticks  Counter delta
+  @return  Duration in ns, 0 if the counter frequency is not known.
+**/
+uint64_t
+perf_ticks_to_ns(uint64_t ticks)
+{
+  uint64_t freq = perf_get_freq();
+
+  if (freq == 0)
+      return 0;
+
+  /* Split the conversion so that long intervals do not overflow 64 bits */
+  return ((ticks / freq) * NSEC_PER_SEC) + (((ticks % freq) * NSEC_PER_SEC) / freq);
+}
+
+void
+perf_stats_init(PERF_STATS *stats)
+{
+  stats->count = 0;
+  stats->min   = ~0ULL;
+  stats->max   = 0;
+  stats->sum   = 0;
+}
+
+void
+perf_stats_add(PERF_STATS *stats, uint64_t value)
+{
+  stats->count++;
+  stats->sum += value;
+
+  if (value < stats->min)
+      stats->min = value;
+
+  if (value > stats->max)
+      stats->max = value;
+}
+
+uint64_t
+perf_stats_avg(PERF_STATS *stats)
+{
+  if (stats->count == 0)
+      return 0;
+
+  return stats->sum / stats->count;
+}
+
+/**
+  @brief   Print one line of min/avg/max for the collected samples.
+
+  @param   level  Print verbosity
+  @param   name   Label printed in front of the numbers
+  @param   stats  Collected samples
+**/
+void
+perf_stats_print(uint32_t level, char8_t *name, PERF_STATS *stats)
+{
+  val_print(level, name, 0);
+
+  if (stats->count == 0) {
+      val_print(level, " : no samples", 0);
+      return;
+  }
+
+  val_print(level, " : samples %d", stats->count);
+  val_print(level, " min %d", stats->min);
+  val_print(level, " avg %d", perf_stats_avg(stats));
+  val_print(level, " max %d", stats->max);
+}
+
+void
+perf_hist_init(PERF_HIST *hist)
+{
+  uint32_t idx;
+
+  for (idx = 0; idx < PERF_HIST_BUCKETS; idx++)
+      hist->bucket[idx] = 0;
+}
+
+void
+perf_hist_add(PERF_HIST *hist, uint64_t value)
+{
+  uint32_t idx = 0;
+
+  while ((value >>= 1) && (idx < PERF_HIST_BUCKETS - 1))
+      idx++;
+
+  hist->bucket[idx]++;
+}
+
+/**
+  @brief   Print the non empty buckets of a histogram, one line per bucket.
+**/
+void
+perf_hist_print(uint32_t level, PERF_HIST *hist)
+{
+  uint32_t idx;
+
+  for (idx = 0; idx < PERF_HIST_BUCKETS; idx++) {
+      if (hist->bucket[idx] == 0)
+          continue;
+
+      val_print(level, "\n         >= %d", 1ULL << idx);
+      val_print(level, " : %d", hist->bucket[idx]);
+  }
+}
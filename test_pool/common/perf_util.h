@@ -0,0 +1,61 @@
+/** @file
+ * Copyright (c) 2026, Arm Limited or its affiliates. All rights reserved.
+ * SPDX-License-Identifier : Apache-2.0
+
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ **/
+
+#ifndef __PERF_UTIL_H__
+#define __PERF_UTIL_H__
+
+/* Set by the application when benchmarks are requested on the command line */
+extern uint32_t g_sbsa_perf_mode;
+
+/* Percent HMAT claims may be off the measurement, 0 for the default */
+extern uint32_t g_sbsa_hmat_tol;
+
+/* MSI delivery rate of the LPI benchmark: delay between two MSIs of a burst in ns
+ * (0 for back to back) and bursts per active vector count (0 for the default)
+ */
+extern uint32_t g_sbsa_msi_gap;
+extern uint32_t g_sbsa_msi_rounds;
+
+#define PERF_HIST_BUCKETS  24
+
+/* Running min/max/sum of a measured quantity (ticks, ns, bytes ...) */
+typedef struct {
+  uint64_t count;
+  uint64_t min;
+  uint64_t max;
+  uint64_t sum;
+} PERF_STATS;
+
+/* Power of two histogram, bucket n counts values in [2^n, 2^(n+1)) */
+typedef struct {
+  uint64_t bucket[PERF_HIST_BUCKETS];
+} PERF_HIST;
+
+uint64_t perf_get_ticks(void);
+uint64_t perf_get_freq(void);
+uint64_t perf_ticks_to_ns(uint64_t ticks);
+
+void     perf_stats_init(PERF_STATS *stats);
+void     perf_stats_add(PERF_STATS *stats, uint64_t value);
+uint64_t perf_stats_avg(PERF_STATS *stats);
+void     perf_stats_print(uint32_t level, char8_t *name, PERF_STATS *stats);
+
+void     perf_hist_init(PERF_HIST *hist);
+void     perf_hist_add(PERF_HIST *hist, uint64_t value);
+void     perf_hist_print(uint32_t level, PERF_HIST *hist);
+
+#endif /* __PERF_UTIL_H__ */
@@ -0,0 +1,181 @@
+/** @file
+ * Copyright (c) 2026, Arm Limited or its affiliates. All rights reserved.
+ * SPDX-License-Identifier : Apache-2.0
+
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ **/
+
+
+#include "val/common/include/acs_val.h"
+#include "val/common/include/acs_mmu.h"
+#include "val/sbsa/include/sbsa_val_interface.h"
+
+#include "val/sbsa/include/sbsa_acs_iovirt.h"
+#include "val/sbsa/include/sbsa_acs_smmu.h"
+
+#include "pmcg.h"
+
+/* SMMU_PMCG register offsets, EVCNTR and OVS live in cnt_base */
+#define PMCG_REG_EVCNTR      0x000
+#define PMCG_REG_EVTYPER     0x400
+#define PMCG_REG_SMR         0xA00
+#define PMCG_REG_CNTENSET    0xC00
+#define PMCG_REG_CNTENCLR    0xC20
+#define PMCG_REG_INTENCLR    0xC60
+#define PMCG_REG_OVSCLR      0xC80
+#define PMCG_REG_CFGR        0xE00
+#define PMCG_REG_CR          0xE04
+#define PMCG_REG_CEID0       0xE20
+
+#define PMCG_CR_E            (1 << 0)
+#define PMCG_EVTYPER_SPAN    (1u << 29)
+
+/* IORT gives page 1 its own base, val only reports page 0. Page 1 follows
+ * page 0 in every known implementation.
+ */
+#define PMCG_PAGE1_OFFSET    0x10000
+#define PMCG_PAGE_SIZE       0x1000
+
+/**
+  @brief   Locate a PMCG of an SMMU and read its configuration.
+
+  @param   smmu_base  Base address of the SMMU the PMCG is attached to
+  @param   instance   Which of the SMMU PMCGs to return, 0 for the first one
+  @param   pmcg       Filled with the PMCG description
+  @return  0 on success, 1 if the SMMU has no such PMCG.
+**/
+uint32_t
+pmcg_find(uint64_t smmu_base, uint32_t instance, PMCG_CTX *pmcg)
+{
+  uint32_t idx;
+  uint32_t num_pmcg;
+  uint32_t cfgr;
+
+  num_pmcg = val_iovirt_get_pmcg_info(PMCG_NUM_CTRL, 0);
+
+  for (idx = 0; idx < num_pmcg; idx++) {
+      if (val_iovirt_get_pmcg_info(PMCG_NODE_SMMU_BASE, idx) != smmu_base)
+          continue;
+
+      if (instance--)
+          continue;
+
+      val_memory_set(pmcg, sizeof(PMCG_CTX), 0);
+      pmcg->pmcg_index = idx;
+      pmcg->base = val_iovirt_get_pmcg_info(PMCG_CTRL_BASE, idx);
+      val_mmu_update_entry(pmcg->base, PMCG_PAGE_SIZE);
+
+      cfgr = val_mmio_read(pmcg->base + PMCG_REG_CFGR);
+      pmcg->num_ctr = VAL_EXTRACT_BITS(cfgr, 0, 5) + 1;
+      pmcg->ctr_bits = VAL_EXTRACT_BITS(cfgr, 8, 13) + 1;
+      pmcg->sid_filter_global = VAL_EXTRACT_BITS(cfgr, 23, 23);
+
+      pmcg->cnt_base = pmcg->base;
+      if (VAL_EXTRACT_BITS(cfgr, 20, 20)) {
+          pmcg->cnt_base = pmcg->base + PMCG_PAGE1_OFFSET;
+          val_mmu_update_entry(pmcg->cnt_base, PMCG_PAGE_SIZE);
+      }
+
+      if (pmcg->num_ctr > PMCG_MAX_COUNTERS)
+          pmcg->num_ctr = PMCG_MAX_COUNTERS;
+
+      return 0;
+  }
+
+  return 1;
+}
+
+/**
+  @brief   Check SMMU_PMCG_CEID0 for an architected event.
+**/
+uint32_t
+pmcg_event_supported(PMCG_CTX *pmcg, uint32_t event)
+{
+  if (event >= 64)
+      return 0;
+
+  return (val_mmio_read64(pmcg->base + PMCG_REG_CEID0) >> event) & 1;
+}
+
+/**
+  @brief   Program a counter with an event and a StreamID filter.
+
+  @param   pmcg      PMCG
+  @param   ctr       Counter index
+  @param   event     Event number
+  @param   sid       StreamID to count, ignored when all_sids is set
+  @param   all_sids  Count transactions of every StreamID
+**/
+void
+pmcg_config(PMCG_CTX *pmcg, uint32_t ctr, uint32_t event, uint32_t sid, uint32_t all_sids)
+{
+  uint32_t smr_ctr = pmcg->sid_filter_global ? 0 : ctr;
+
+  /* With SPAN set, an all ones SMR matches every StreamID */
+  val_mmio_write(pmcg->base + PMCG_REG_SMR + smr_ctr * 4, all_sids ? 0xFFFFFFFF : sid);
+  val_mmio_write(pmcg->base + PMCG_REG_EVTYPER + ctr * 4,
+                 (event & 0xFFFF) | (all_sids ? PMCG_EVTYPER_SPAN : 0));
+}
+
+static
+void
+pmcg_write_counter(PMCG_CTX *pmcg, uint32_t ctr, uint64_t value)
+{
+  if (pmcg->ctr_bits > 32)
+      val_mmio_write64(pmcg->cnt_base + PMCG_REG_EVCNTR + ctr * 8, value);
+  else
+      val_mmio_write(pmcg->cnt_base + PMCG_REG_EVCNTR + ctr * 4, (uint32_t)value);
+}
+
+/**
+  @brief   Read a counter, 32 or 64 bit wide depending on CFGR.SIZE.
+**/
+uint64_t
+pmcg_read(PMCG_CTX *pmcg, uint32_t ctr)
+{
+  if (pmcg->ctr_bits > 32)
+      return val_mmio_read64(pmcg->cnt_base + PMCG_REG_EVCNTR + ctr * 8);
+
+  return val_mmio_read(pmcg->cnt_base + PMCG_REG_EVCNTR + ctr * 4);
+}
+
+/**
+  @brief   Zero and enable the counters in ctr_mask, interrupts stay off.
+**/
+void
+pmcg_start(PMCG_CTX *pmcg, uint64_t ctr_mask)
+{
+  uint32_t ctr;
+
+  val_mmio_write(pmcg->base + PMCG_REG_CR, 0);
+  val_mmio_write64(pmcg->base + PMCG_REG_INTENCLR, ctr_mask);
+  val_mmio_write64(pmcg->cnt_base + PMCG_REG_OVSCLR, ctr_mask);
+
+  for (ctr = 0; ctr < pmcg->num_ctr; ctr++) {
+      if (ctr_mask & (1ULL << ctr))
+          pmcg_write_counter(pmcg, ctr, 0);
+  }
+
+  val_mmio_write64(pmcg->base + PMCG_REG_CNTENSET, ctr_mask);
+  val_mmio_write(pmcg->base + PMCG_REG_CR, PMCG_CR_E);
+}
+
+/**
+  @brief   Freeze every counter, values stay readable.
+**/
+void
+pmcg_stop(PMCG_CTX *pmcg)
+{
+  val_mmio_write(pmcg->base + PMCG_REG_CR, 0);
+  val_mmio_write64(pmcg->base + PMCG_REG_CNTENCLR, ~0ULL);
+}
@@ -0,0 +1,52 @@
+/** @file
+ * Copyright (c) 2026, Arm Limited or its affiliates. All rights reserved.
+ * SPDX-License-Identifier : Apache-2.0
+
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ **/
+
+
+#ifndef __PMCG_H__
+#define __PMCG_H__
+
+#define PMCG_MAX_COUNTERS   64
+
+/* Architected SMMUv3 PMCG events */
+#define PMCG_EVT_CYCLES           0x0
+#define PMCG_EVT_TRANSACTION      0x1
+#define PMCG_EVT_TLB_MISS         0x2
+#define PMCG_EVT_CONFIG_MISS      0x3
+#define PMCG_EVT_TT_WALK          0x4
+#define PMCG_EVT_CONFIG_ACCESS    0x5
+#define PMCG_EVT_ATS_TRANS_REQ    0x6
+#define PMCG_EVT_ATS_TRANS_PASS   0x7
+
+/* Counter group of an SMMU, as described by IORT and SMMU_PMCG_CFGR */
+typedef struct {
+  uint32_t pmcg_index;
+  uint64_t base;           /* Page 0 */
+  uint64_t cnt_base;       /* Page holding EVCNTR/OVS, page 1 when RELOC_CTRS */
+  uint32_t num_ctr;
+  uint32_t ctr_bits;
+  uint32_t sid_filter_global;  /* CFGR.SID_FILTER_TYPE, SMR0 filters every counter */
+} PMCG_CTX;
+
+uint32_t pmcg_find(uint64_t smmu_base, uint32_t instance, PMCG_CTX *pmcg);
+uint32_t pmcg_event_supported(PMCG_CTX *pmcg, uint32_t event);
+void     pmcg_config(PMCG_CTX *pmcg, uint32_t ctr, uint32_t event, uint32_t sid,
+                     uint32_t all_sids);
+void     pmcg_start(PMCG_CTX *pmcg, uint64_t ctr_mask);
+void     pmcg_stop(PMCG_CTX *pmcg);
+uint64_t pmcg_read(PMCG_CTX *pmcg, uint32_t ctr);
+
+#endif /* __PMCG_H__ */
@@ -0,0 +1,376 @@
+/** @file
+ * Copyright (c) 2026, Arm Limited or its affiliates. All rights reserved.
+ * SPDX-License-Identifier : Apache-2.0
+
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ **/
+
+
+#include "val/common/include/acs_val.h"
+#include "val/sbsa/include/sbsa_val_interface.h"
+
+#include "val/sbsa/include/sbsa_acs_pe.h"
+#include "val/sbsa/include/sbsa_acs_smmu.h"
+#include "val/common/include/acs_pgt.h"
+#include "val/common/include/acs_pe.h"
+#include "val/sbsa/include/sbsa_acs_iovirt.h"
+#include "val/common/include/acs_iovirt.h"
+#include "val/sbsa/include/sbsa_acs_memory.h"
+#include "val/common/include/acs_pcie_enumeration.h"
+#include "val/sbsa/include/sbsa_acs_pcie.h"
+#include "val/sbsa/include/sbsa_acs_exerciser.h"
+
+#include "smmu_caps.h"
+#include "smmu_ctx.h"
+#include "route_map.h"
+#include "dma_bench.h"
+#include "pmcg_prof.h"
+
+/* Exerciser workload of pmcg_prof_run */
+#define PMCG_PROF_NUM_PAGES  64
+#define PMCG_PROF_ROUNDS     16
+#define PMCG_PROF_DMA_LEN    256
+
+static uint32_t prof_event[PMCG_PROF_EVENTS] = {
+  PMCG_EVT_TRANSACTION, PMCG_EVT_TLB_MISS, PMCG_EVT_TT_WALK, PMCG_EVT_CONFIG_MISS
+};
+
+static PMCG_PROF exerciser_prof;
+
+/**
+  @brief   Start a profile description, no stream is attached yet.
+
+  @param   prof       Profile
+  @param   period_ns  Minimum time between two samples
+**/
+void
+pmcg_prof_init(PMCG_PROF *prof, uint64_t period_ns)
+{
+  val_memory_set(prof, sizeof(PMCG_PROF), 0);
+  prof->period = (period_ns * perf_get_freq()) / 1000000000ULL;
+}
+
+/**
+  @brief   Profile a StreamID of an SMMU. PMCG_PROF_EVENTS counters of the
+           first PMCG of the SMMU are allocated to the stream.
+
+  @return  0 on success, 1 if the SMMU has no PMCG or it is out of counters.
+**/
+uint32_t
+pmcg_prof_add_stream(PMCG_PROF *prof, uint32_t smmu_index, uint32_t sid)
+{
+  uint32_t idx;
+  uint32_t evt;
+  uint32_t ctr_base;
+  SMMU_CAPS *caps;
+  PMCG_PROF_STREAM *stream;
+
+  if (prof->num_streams >= PMCG_PROF_MAX_STREAMS)
+      return 1;
+
+  caps = smmu_caps_get(smmu_index);
+  if (caps == NULL || caps->arch_major < 3)
+      return 1;
+
+  for (idx = 0; idx < prof->num_pmcg; idx++) {
+      if (val_iovirt_get_pmcg_info(PMCG_NODE_SMMU_BASE, prof->pmcg[idx].pmcg_index) ==
+          caps->base)
+          break;
+  }
+
+  if (idx == prof->num_pmcg) {
+      if (idx >= PMCG_PROF_MAX_PMCG || pmcg_find(caps->base, 0, &prof->pmcg[idx]))
+          return 1;
+      prof->num_pmcg++;
+  }
+
+  /* A global StreamID filter can only follow one stream */
+  if (prof->pmcg[idx].sid_filter_global && prof->pmcg_mask[idx])
+      return 1;
+
+  ctr_base = 0;
+  while (prof->pmcg_mask[idx] & (1ULL << ctr_base))
+      ctr_base++;
+
+  if (ctr_base + PMCG_PROF_EVENTS > prof->pmcg[idx].num_ctr)
+      return 1;
+
+  stream = &prof->stream[prof->num_streams++];
+  stream->smmu_index = smmu_index;
+  stream->sid = sid;
+  stream->pmcg = idx;
+  stream->ctr_base = ctr_base;
+
+  for (evt = 0; evt < PMCG_PROF_EVENTS; evt++) {
+      pmcg_config(&prof->pmcg[idx], ctr_base + evt, prof_event[evt], sid, 0);
+      prof->pmcg_mask[idx] |= 1ULL << (ctr_base + evt);
+  }
+
+  return 0;
+}
+
+static
+void
+pmcg_prof_sample(PMCG_PROF *prof, uint64_t now)
+{
+  uint32_t idx, evt;
+  uint64_t raw, delta, wrap;
+  PMCG_CTX *pmcg;
+  PMCG_PROF_STREAM *stream;
+  PMCG_PROF_SAMPLE *sample;
+
+  for (idx = 0; idx < prof->num_streams; idx++) {
+      stream = &prof->stream[idx];
+      pmcg = &prof->pmcg[stream->pmcg];
+      wrap = (pmcg->ctr_bits >= 64) ? ~0ULL : ((1ULL << pmcg->ctr_bits) - 1);
+
+      sample = NULL;
+      if (stream->num_samples < PMCG_PROF_MAX_SAMPLES) {
+          sample = &stream->sample[stream->num_samples++];
+          sample->ts = now - prof->start_ts;
+      } else {
+          stream->dropped++;
+      }
+
+      for (evt = 0; evt < PMCG_PROF_EVENTS; evt++) {
+          raw = pmcg_read(pmcg, stream->ctr_base + evt);
+          delta = (raw - stream->last[evt]) & wrap;
+          stream->last[evt] = raw;
+          stream->total[evt] += delta;
+
+          if (sample)
+              sample->delta[evt] = delta;
+      }
+  }
+
+  prof->last_ts = now;
+}
+
+/**
+  @brief   Zero the allocated counters and start counting.
+**/
+void
+pmcg_prof_start(PMCG_PROF *prof)
+{
+  uint32_t idx;
+
+  for (idx = 0; idx < prof->num_streams; idx++) {
+      val_memory_set(prof->stream[idx].last, sizeof(prof->stream[idx].last), 0);
+      val_memory_set(prof->stream[idx].total, sizeof(prof->stream[idx].total), 0);
+      prof->stream[idx].num_samples = 0;
+      prof->stream[idx].dropped = 0;
+  }
+
+  for (idx = 0; idx < prof->num_pmcg; idx++)
+      pmcg_start(&prof->pmcg[idx], prof->pmcg_mask[idx]);
+
+  prof->start_ts = perf_get_ticks();
+  prof->last_ts = prof->start_ts;
+}
+
+/**
+  @brief   To be called by the DMA source between operations. Takes a sample
+           once the period elapsed since the previous one.
+**/
+void
+pmcg_prof_poll(PMCG_PROF *prof)
+{
+  uint64_t now = perf_get_ticks();
+
+  if ((now - prof->last_ts) >= prof->period)
+      pmcg_prof_sample(prof, now);
+}
+
+/**
+  @brief   Take the closing sample and stop the counters.
+**/
+void
+pmcg_prof_stop(PMCG_PROF *prof)
+{
+  uint32_t idx;
+
+  pmcg_prof_sample(prof, perf_get_ticks());
+
+  for (idx = 0; idx < prof->num_pmcg; idx++)
+      pmcg_stop(&prof->pmcg[idx]);
+}
+
+/**
+  @brief   Print the totals of each stream, and its time series at INFO level.
+**/
+void
+pmcg_prof_report(PMCG_PROF *prof)
+{
+  uint32_t idx, num;
+  PMCG_PROF_STREAM *stream;
+  PMCG_PROF_SAMPLE *sample;
+
+  for (idx = 0; idx < prof->num_streams; idx++) {
+      stream = &prof->stream[idx];
+
+      val_print(ACS_PRINT_TEST, "\n       PMCG profile, SMMU %d", stream->smmu_index);
+      val_print(ACS_PRINT_TEST, " StreamID 0x%x", stream->sid);
+      val_print(ACS_PRINT_TEST, ", %d samples", stream->num_samples);
+      if (stream->dropped)
+          val_print(ACS_PRINT_TEST, " (%d dropped)", stream->dropped);
+
+      val_print(ACS_PRINT_INFO,
+                "\n       t (us)      Txns  TLB miss     Walks  Cfg miss", 0);
+      for (num = 0; num < stream->num_samples; num++) {
+          sample = &stream->sample[num];
+          val_print(ACS_PRINT_INFO, "\n       %6d", perf_ticks_to_ns(sample->ts) / 1000);
+          val_print(ACS_PRINT_INFO, " %9d", sample->delta[PMCG_PROF_TXN]);
+          val_print(ACS_PRINT_INFO, " %9d", sample->delta[PMCG_PROF_TLB_MISS]);
+          val_print(ACS_PRINT_INFO, " %9d", sample->delta[PMCG_PROF_WALK]);
+          val_print(ACS_PRINT_INFO, " %9d", sample->delta[PMCG_PROF_CFG_MISS]);
+      }
+
+      val_print(ACS_PRINT_TEST, "\n       Total       %9d", stream->total[PMCG_PROF_TXN]);
+      val_print(ACS_PRINT_TEST, " %9d", stream->total[PMCG_PROF_TLB_MISS]);
+      val_print(ACS_PRINT_TEST, " %9d", stream->total[PMCG_PROF_WALK]);
+      val_print(ACS_PRINT_TEST, " %9d", stream->total[PMCG_PROF_CFG_MISS]);
+  }
+}
+
+/**
+  @brief   Profile one exerciser doing page strided DMA writes through the
+           first translation stage its SMMU supports. Sampling stops at the
+           first failed DMA, and the SMMU is left enabled or disabled as it
+           was found.
+
+  @return  1 if the exerciser was profiled, 0 otherwise.
+**/
+static
+uint32_t
+pmcg_prof_exerciser(uint32_t instance, void *buf_virt, uint64_t buf_phys, uint32_t page_size,
+                    pgt_descriptor_t *pgt_tmpl, uint64_t s1_attr)
+{
+  uint32_t e_bdf;
+  uint32_t device_id, its_id;
+  uint32_t xlat;
+  uint32_t round, page;
+  uint32_t was_enabled;
+  uint32_t profiled = 0;
+  uint64_t iova;
+  SMMU_CAPS *caps;
+  memory_region_descriptor_t mem_desc;
+  pgt_descriptor_t pgt_desc;
+  smmu_master_attributes_t master;
+
+  e_bdf = val_exerciser_get_bdf(instance);
+
+  val_memory_set(&master, sizeof(master), 0);
+  master.smmu_index = route_map_smmu_index(e_bdf);
+  caps = smmu_caps_get(master.smmu_index);
+  if (caps == NULL || caps->arch_major < 3 || !(caps->s1p || caps->s2p))
+      return 0;
+
+  if (route_map_device_info(e_bdf, &device_id, &master.streamid, &its_id))
+      return 0;
+
+  pmcg_prof_init(&exerciser_prof, PMCG_PROF_PERIOD_NS);
+  if (pmcg_prof_add_stream(&exerciser_prof, master.smmu_index, master.streamid)) {
+      val_print(ACS_PRINT_DEBUG, "\n       No PMCG counters for SMMU %d", master.smmu_index);
+      return 0;
+  }
+
+  xlat = caps->s1p ? DMA_XLAT_STAGE1 : DMA_XLAT_STAGE2;
+  master.stage2 = (xlat == DMA_XLAT_STAGE2);
+
+  pgt_desc = *pgt_tmpl;
+  pgt_desc.ias = val_smmu_get_info(SMMU_IN_ADDR_SIZE, master.smmu_index);
+  pgt_desc.oas = val_smmu_get_info(SMMU_OUT_ADDR_SIZE, master.smmu_index);
+  pgt_desc.stage = master.stage2 ? PGT_STAGE2 : PGT_STAGE1;
+  if ((pgt_desc.ias == 0) || (pgt_desc.oas == 0))
+      return 0;
+
+  was_enabled = smmu_caps_enabled(master.smmu_index);
+  val_smmu_enable(master.smmu_index);
+
+  iova = (uint64_t)buf_virt + (uint64_t)instance * PMCG_PROF_NUM_PAGES * page_size;
+
+  val_memory_set(&mem_desc, sizeof(mem_desc), 0);
+  mem_desc.virtual_address = iova;
+  mem_desc.physical_address = buf_phys;
+  mem_desc.length = (uint64_t)PMCG_PROF_NUM_PAGES * page_size;
+  mem_desc.attributes = dma_bench_attr(s1_attr, xlat, DMA_TARGET_NORMAL, -1);
+
+  if (smmu_ctx_map(&master, &mem_desc, &pgt_desc) == NULL)
+      goto restore;
+
+  val_print(ACS_PRINT_TEST, "\n       Exerciser %d", instance);
+  val_print(ACS_PRINT_TEST, (xlat == DMA_XLAT_STAGE2) ? ", stage 2" : ", stage 1", 0);
+
+  pmcg_prof_start(&exerciser_prof);
+
+  for (round = 0; round < PMCG_PROF_ROUNDS; round++) {
+      for (page = 0; page < PMCG_PROF_NUM_PAGES; page++) {
+          val_exerciser_set_param(DMA_ATTRIBUTES, iova + (uint64_t)page * page_size,
+                                  PMCG_PROF_DMA_LEN, instance);
+          if (val_exerciser_ops(START_DMA, (round & 1) ? EDMA_TO_DEVICE : EDMA_FROM_DEVICE,
+                                instance)) {
+              val_print(ACS_PRINT_DEBUG, "\n       DMA failed for exerciser %d", instance);
+              goto stop;
+          }
+          pmcg_prof_poll(&exerciser_prof);
+      }
+  }
+
+stop:
+  pmcg_prof_stop(&exerciser_prof);
+  pmcg_prof_report(&exerciser_prof);
+  profiled = 1;
+
+restore:
+  smmu_ctx_pool_destroy();
+
+  if (!was_enabled)
+      val_smmu_disable(master.smmu_index);
+
+  return profiled;
+}
+
+/**
+  @brief   Profile every exerciser behind an SMMUv3 with a PMCG, as a
+           reference workload for the profiler.
+
+  @return  Number of exercisers profiled.
+**/
+uint32_t
+pmcg_prof_run(void)
+{
+  uint32_t instance;
+  uint32_t num_exercisers;
+  uint32_t profiled = 0;
+  uint32_t page_size;
+  SMMU_CTX_BUF buf;
+
+  num_exercisers = val_exerciser_get_info(EXERCISER_NUM_CARDS);
+  if (num_exercisers == 0)
+      return 0;
+
+  page_size = val_memory_page_size();
+  if (smmu_ctx_buf_alloc(&buf, PMCG_PROF_NUM_PAGES))
+      return 0;
+
+  for (instance = 0; instance < num_exercisers; instance++) {
+      if (val_exerciser_init(instance))
+          continue;
+
+      profiled += pmcg_prof_exerciser(instance, buf.buf_virt, buf.buf_phys, page_size,
+                                      &buf.pgt_desc, buf.s1_attr);
+  }
+
+  smmu_ctx_buf_free(&buf);
+  return profiled;
+}
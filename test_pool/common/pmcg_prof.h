@@ -0,0 +1,78 @@
+/** @file
+ * Copyright (c) 2026, Arm Limited or its affiliates. All rights reserved.
+ * SPDX-License-Identifier : Apache-2.0
+
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ **/
+
+
+#ifndef __PMCG_PROF_H__
+#define __PMCG_PROF_H__
+
+#include "perf_util.h"
+#include "pmcg.h"
+
+#define PMCG_PROF_MAX_PMCG     8
+#define PMCG_PROF_MAX_STREAMS  8
+#define PMCG_PROF_MAX_SAMPLES  64
+#define PMCG_PROF_PERIOD_NS    50000
+
+/* Counters programmed for every profiled stream, in this order */
+typedef enum {
+  PMCG_PROF_TXN = 0,
+  PMCG_PROF_TLB_MISS,
+  PMCG_PROF_WALK,
+  PMCG_PROF_CFG_MISS,
+  PMCG_PROF_EVENTS
+} PMCG_PROF_EVENT;
+
+typedef struct {
+  uint64_t ts;                         /* Ticks since the profile started */
+  uint64_t delta[PMCG_PROF_EVENTS];    /* Counts since the previous sample */
+} PMCG_PROF_SAMPLE;
+
+typedef struct {
+  uint32_t smmu_index;
+  uint32_t sid;
+  uint32_t pmcg;                       /* Index in PMCG_PROF.pmcg */
+  uint32_t ctr_base;                   /* First of PMCG_PROF_EVENTS counters */
+  uint64_t last[PMCG_PROF_EVENTS];     /* Raw counter values at the last sample */
+  uint64_t total[PMCG_PROF_EVENTS];
+  uint32_t num_samples;
+  uint32_t dropped;                    /* Samples lost once the series was full */
+  PMCG_PROF_SAMPLE sample[PMCG_PROF_MAX_SAMPLES];
+} PMCG_PROF_STREAM;
+
+/* Per stream PMCG time series. The DMA source calls pmcg_prof_poll between
+ * operations, a sample is taken whenever the period elapsed.
+ */
+typedef struct {
+  uint64_t period;                     /* Sampling period in ticks */
+  uint64_t start_ts;
+  uint64_t last_ts;
+  uint32_t num_pmcg;
+  PMCG_CTX pmcg[PMCG_PROF_MAX_PMCG];
+  uint64_t pmcg_mask[PMCG_PROF_MAX_PMCG];  /* Counters allocated on each PMCG */
+  uint32_t num_streams;
+  PMCG_PROF_STREAM stream[PMCG_PROF_MAX_STREAMS];
+} PMCG_PROF;
+
+void     pmcg_prof_init(PMCG_PROF *prof, uint64_t period_ns);
+uint32_t pmcg_prof_add_stream(PMCG_PROF *prof, uint32_t smmu_index, uint32_t sid);
+void     pmcg_prof_start(PMCG_PROF *prof);
+void     pmcg_prof_poll(PMCG_PROF *prof);
+void     pmcg_prof_stop(PMCG_PROF *prof);
+void     pmcg_prof_report(PMCG_PROF *prof);
+uint32_t pmcg_prof_run(void);
+
+#endif /* __PMCG_PROF_H__ */
@@ -0,0 +1,304 @@
+/** @file
+ * Copyright (c) 2026, Arm Limited or its affiliates. All rights reserved.
+ * SPDX-License-Identifier : Apache-2.0
+
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ **/
+
+
+#include "val/common/include/acs_val.h"
+#include "val/common/include/acs_pe.h"
+#include "val/common/include/acs_memory.h"
+#include "val/sbsa/include/sbsa_val_interface.h"
+#include "val/sbsa/include/sbsa_acs_pe.h"
+#include "val/common/include/acs_common.h"
+
+#include "pe_sync.h"
+#include "traffic_gen.h"
+#include "pmu_irq_bench.h"
+
+#define PMU_IRQ_CTR_BIT   0x1        /* Event counter 0 */
+#define PMU_IRQ_PMCR_E    0x1
+#define PMU_IRQ_PMCR_LP   0x80       /* Event counters overflow at 64 bits, FEAT_PMUv3p5 */
+
+/* Overflow periods swept, in PE cycles */
+static uint32_t pmu_irq_period[PMU_IRQ_NUM_PERIODS] = {1000000, 100000, 20000, 5000, 1000};
+
+static PMU_IRQ_PE   pmu_irq_pe;                      /* Primary PE, the one sampled */
+static uint32_t     pmu_irq_load_list[PE_SYNC_MAX_PE];
+static uint32_t     pmu_irq_num_load;
+static uint64_t     pmu_irq_load_buf;                /* Streamed by the loading PEs, 0 if none */
+static uint32_t     pmu_irq_int_id;
+static uint32_t     pmu_irq_cur_period;
+static PMU_IRQ_STEP pmu_irq_step[PMU_IRQ_NUM_PERIODS];
+
+/* Event counter 0 is not reachable through val_pe_reg_read/write */
+static
+uint64_t
+pmu_irq_cnt_read(void)
+{
+  uint64_t value;
+
+  __asm__ volatile ("mrs %0, pmevcntr0_el0" : "=r" (value));
+  return value;
+}
+
+static
+void
+pmu_irq_cnt_write(uint64_t value)
+{
+  __asm__ volatile ("msr pmevcntr0_el0, %0" : : "r" (value));
+  __asm__ volatile ("isb" : : : "memory");
+}
+
+static
+void
+pmu_irq_cnt_enable(uint32_t enable)
+{
+  uint64_t bit = PMU_IRQ_CTR_BIT;
+
+  if (enable) {
+      __asm__ volatile ("msr pmevtyper0_el0, %0" : : "r" ((uint64_t)PMU_IRQ_EVT_CPU_CYCLES));
+      __asm__ volatile ("msr pmcntenset_el0, %0" : : "r" (bit));
+  } else {
+      __asm__ volatile ("msr pmcntenclr_el0, %0" : : "r" (bit));
+  }
+  __asm__ volatile ("isb" : : : "memory");
+}
+
+/**
+  @brief   Overflow interrupt handler. The counter keeps counting cycles after
+           it wraps, so its value on entry is the overflow to ISR latency.
+           Every further period that went by while the interrupt was pending
+           is an overflow coalesced into this one. The reload keeps the
+           cycles counted since the last period boundary, so the latency and
+           handler time do not stretch the sampling period.
+**/
+static
+void
+pmu_irq_isr(void)
+{
+  uint64_t late = pmu_irq_cnt_read() & 0xFFFFFFFF;
+
+  pmu_irq_pe.samples++;
+  pmu_irq_pe.coalesced += late / pmu_irq_cur_period;
+  perf_stats_add(&pmu_irq_pe.latency, late);
+
+  pmu_irq_cnt_write(0x100000000ULL - pmu_irq_cur_period +
+                    (pmu_irq_cnt_read() & 0xFFFFFFFF) % pmu_irq_cur_period);
+  val_pe_reg_write(PMOVSCLR_EL0, PMU_IRQ_CTR_BIT);
+  val_gic_end_of_interrupt(pmu_irq_int_id);
+}
+
+/* Cycles the counter advances per microsecond of generic timer */
+static
+uint64_t
+pmu_irq_calibrate(void)
+{
+  uint64_t start, ns;
+  uint64_t cyc;
+
+  pmu_irq_cnt_write(0);
+  start = perf_get_ticks();
+  while (perf_ticks_to_ns(perf_get_ticks() - start) < PMU_IRQ_CAL_NS)
+      ;
+  cyc = pmu_irq_cnt_read() & 0xFFFFFFFF;
+  ns = perf_ticks_to_ns(perf_get_ticks() - start);
+
+  return ns ? (cyc * 1000) / ns : 0;
+}
+
+/**
+  @brief   Run on every loading PE: stream the load buffer until stopped,
+           or spin when there is none.
+**/
+static
+void
+pmu_irq_load(uint32_t slot)
+{
+  TGEN_CFG cfg = {TGEN_OP_READ, TGEN_PATTERN_SEQ, 0, 0, 1, 0, 0, PMU_IRQ_LOAD_SIZE, 0};
+
+  (void)slot;
+  cfg.src = pmu_irq_load_buf;
+
+  while (!pe_sync_stopping()) {
+      if (cfg.src)
+          tgen_run(&cfg);
+  }
+}
+
+/**
+  @brief   Run on the primary PE: count cycles on event counter 0 with
+           overflow interrupts every pmu_irq_cur_period cycles for
+           PMU_IRQ_WINDOW_NS.
+**/
+static
+void
+pmu_irq_sample(PMU_IRQ_PE *pe)
+{
+  uint64_t start, ns;
+  uint64_t pmcr;
+
+  val_pe_reg_write(PMINTENCLR_EL1, PMU_IRQ_CTR_BIT);
+  val_pe_reg_write(PMOVSCLR_EL0, PMU_IRQ_CTR_BIT);
+  /* 32-bit overflow, whatever LP firmware left set */
+  pmcr = val_pe_reg_read(PMCR_EL0);
+  val_pe_reg_write(PMCR_EL0, (pmcr & ~(uint64_t)PMU_IRQ_PMCR_LP) | PMU_IRQ_PMCR_E);
+  pmu_irq_cnt_enable(1);
+
+  pe->cyc_per_us = pmu_irq_calibrate();
+
+  pmu_irq_cnt_write(0x100000000ULL - pmu_irq_cur_period);
+  start = perf_get_ticks();
+  val_pe_reg_write(PMINTENSET_EL1, PMU_IRQ_CTR_BIT);
+
+  while (perf_ticks_to_ns(perf_get_ticks() - start) < PMU_IRQ_WINDOW_NS)
+      ;
+
+  val_pe_reg_write(PMINTENCLR_EL1, PMU_IRQ_CTR_BIT);
+  pe->ticks = perf_get_ticks() - start;
+  pmu_irq_cnt_enable(0);
+  val_pe_reg_write(PMOVSCLR_EL0, PMU_IRQ_CTR_BIT);
+  val_pe_reg_write(PMCR_EL0, pmcr);
+
+  ns = perf_ticks_to_ns(pe->ticks);
+  pe->expected = ((ns / 1000) * pe->cyc_per_us) / pmu_irq_cur_period;
+}
+
+/**
+  @brief   Sample one overflow period on the primary PE while the loading
+           PEs run, and summarise the results.
+
+  @param   period    Cycles between overflows
+  @param   step      Summary of the period
+  @param   test_num  Test the secondary PE status is reported against
+  @return  0 on success, 1 if some loading PE did not run or complete.
+**/
+uint32_t
+pmu_irq_bench_step(uint32_t period, PMU_IRQ_STEP *step, uint32_t test_num)
+{
+  uint64_t ns;
+  uint64_t serviced;
+  PMU_IRQ_PE *pe = &pmu_irq_pe;
+
+  val_memory_set(step, sizeof(PMU_IRQ_STEP), 0);
+  step->period = period;
+  step->num_load = pmu_irq_num_load;
+
+  pmu_irq_cur_period = period;
+  val_memory_set(pe, sizeof(PMU_IRQ_PE), 0);
+  pe->pe_index = val_pe_get_index_mpid(val_pe_get_mpid());
+  perf_stats_init(&pe->latency);
+
+  if (pe_sync_launch(pmu_irq_num_load, pmu_irq_load_list, pmu_irq_load, test_num)) {
+      pe_sync_wait();
+      return 1;
+  }
+
+  pmu_irq_sample(pe);
+
+  pe_sync_stop();
+  if (pe_sync_wait())
+      return 1;
+
+  ns = perf_ticks_to_ns(pe->ticks);
+  step->rate = ns ? (pe->samples * 1000000000ULL) / ns : 0;
+  step->max_latency = pe->latency.count ? pe->latency.max : 0;
+  step->avg_latency = perf_stats_avg(&pe->latency);
+  step->coalesced = pe->coalesced;
+
+  serviced = pe->samples + pe->coalesced;
+  step->lost = (pe->expected > serviced) ? pe->expected - serviced : 0;
+  step->sustained = (pe->samples != 0) &&
+                    (pe->coalesced * 100 <= pe->samples * PMU_IRQ_COALESCE_PCT);
+
+  val_print(ACS_PRINT_INFO, "\n         PE %4d", pe->pe_index);
+  val_print(ACS_PRINT_INFO, " %4d cyc/us", pe->cyc_per_us);
+  val_print(ACS_PRINT_INFO, " samples %8d", pe->samples);
+  val_print(ACS_PRINT_INFO, " coalesced %6d", pe->coalesced);
+  val_print(ACS_PRINT_INFO, " latency avg %6d cyc", step->avg_latency);
+
+  return 0;
+}
+
+/**
+  @brief   Print one row per period and the highest sample rate the PE
+           sustained without coalescing more than PMU_IRQ_COALESCE_PCT.
+**/
+void
+pmu_irq_bench_report(PMU_IRQ_STEP *step, uint32_t num_step)
+{
+  uint32_t idx;
+  uint64_t best = 0;
+
+  val_print(ACS_PRINT_TEST, "\n       PMU overflow interrupts, %d PEs loading", step[0].num_load);
+  val_print(ACS_PRINT_TEST, "\n        Period      Rate/s  Avg lat cyc  Max lat cyc"
+                            "  Coalesced      Lost", 0);
+
+  for (idx = 0; idx < num_step; idx++) {
+      val_print(ACS_PRINT_TEST, "\n       %7d", step[idx].period);
+      val_print(ACS_PRINT_TEST, " %11d", step[idx].rate);
+      val_print(ACS_PRINT_TEST, " %12d", step[idx].avg_latency);
+      val_print(ACS_PRINT_TEST, " %12d", step[idx].max_latency);
+      val_print(ACS_PRINT_TEST, " %10d", step[idx].coalesced);
+      val_print(ACS_PRINT_TEST, " %9d", step[idx].lost);
+
+      if (step[idx].sustained && (step[idx].rate > best))
+          best = step[idx].rate;
+  }
+
+  val_print(ACS_PRINT_TEST, "\n       Sustained sample rate : %d /s", best);
+}
+
+/**
+  @brief   Overflow interrupt latency and sample rate of the PMU of the
+           primary PE, for periods from long to short ones, while every
+           secondary PE streams memory as concurrent load. The ISR is
+           installed and the overflow interrupt enabled on the primary PE
+           only. Results are informational.
+
+  @param   int_id    PMU overflow PPI
+  @param   test_num  Test the secondary PE status is reported against
+  @return  Number of periods measured.
+**/
+uint32_t
+pmu_irq_bench_run(uint32_t int_id, uint32_t test_num)
+{
+  uint32_t idx;
+
+  pmu_irq_int_id = int_id;
+  val_gic_install_isr(pmu_irq_int_id, pmu_irq_isr);
+
+  pmu_irq_num_load = pe_sync_select(PE_SYNC_MAX_PE, pmu_irq_load_list);
+  pmu_irq_load_buf = 0;
+  if (pmu_irq_num_load) {
+      pmu_irq_load_buf = (uint64_t)val_aligned_alloc(MEM_ALIGN_4K, PMU_IRQ_LOAD_SIZE);
+      if (pmu_irq_load_buf == 0)
+          val_print(ACS_PRINT_DEBUG, "\n       PMU interrupt load buffer unavailable", 0);
+  }
+  val_data_cache_ops_by_va((addr_t)&pmu_irq_load_buf, CLEAN_AND_INVALIDATE);
+
+  for (idx = 0; idx < PMU_IRQ_NUM_PERIODS; idx++) {
+      val_print(ACS_PRINT_INFO, "\n       Overflow period %d cycles", pmu_irq_period[idx]);
+      if (pmu_irq_bench_step(pmu_irq_period[idx], &pmu_irq_step[idx], test_num))
+          break;
+  }
+
+  if (idx)
+      pmu_irq_bench_report(pmu_irq_step, idx);
+
+  if (pmu_irq_load_buf)
+      val_memory_free_aligned((void *)pmu_irq_load_buf);
+
+  return idx;
+}
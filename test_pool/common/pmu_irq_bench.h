@@ -0,0 +1,58 @@
+/** @file
+ * Copyright (c) 2026, Arm Limited or its affiliates. All rights reserved.
+ * SPDX-License-Identifier : Apache-2.0
+
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ **/
+
+
+#ifndef __PMU_IRQ_BENCH_H__
+#define __PMU_IRQ_BENCH_H__
+
+#include "perf_util.h"
+#include "pe_sync.h"
+
+#define PMU_IRQ_NUM_PERIODS   5
+#define PMU_IRQ_WINDOW_NS     2000000     /* Time each period is sampled */
+#define PMU_IRQ_CAL_NS        100000      /* PE clock calibration window */
+#define PMU_IRQ_COALESCE_PCT  1           /* Coalesced overflows a sustained rate allows */
+#define PMU_IRQ_LOAD_SIZE     0x800000    /* Streamed by the loading PEs, 8 MB */
+#define PMU_IRQ_EVT_CPU_CYCLES  0x11
+
+/* Results of the sampled PE for one overflow period */
+typedef struct {
+  uint32_t pe_index;
+  uint64_t cyc_per_us;     /* PE clock, calibrated against the generic timer */
+  uint64_t samples;        /* Overflow interrupts serviced */
+  uint64_t coalesced;      /* Overflows that went by while one was pending */
+  uint64_t expected;       /* Overflows the window held at the PE clock */
+  uint64_t ticks;          /* Window length on the PE */
+  PERF_STATS latency;      /* Overflow to ISR entry, PE cycles */
+} PMU_IRQ_PE;
+
+typedef struct {
+  uint32_t period;         /* Cycles between overflows */
+  uint32_t num_load;       /* Secondary PEs running concurrent load */
+  uint64_t rate;           /* Samples per second */
+  uint64_t max_latency;    /* Worst overflow to ISR entry, cycles */
+  uint64_t avg_latency;
+  uint64_t coalesced;
+  uint64_t lost;           /* Expected overflows neither serviced nor coalesced */
+  uint32_t sustained;      /* Coalescing stayed within PMU_IRQ_COALESCE_PCT */
+} PMU_IRQ_STEP;
+
+uint32_t pmu_irq_bench_step(uint32_t period, PMU_IRQ_STEP *step, uint32_t test_num);
+void     pmu_irq_bench_report(PMU_IRQ_STEP *step, uint32_t num_step);
+uint32_t pmu_irq_bench_run(uint32_t int_id, uint32_t test_num);
+
+#endif /* __PMU_IRQ_BENCH_H__ */
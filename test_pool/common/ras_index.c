@@ -0,0 +1,63 @@
+/** @file
+ * Copyright (c) 2026, Arm Limited or its affiliates. All rights reserved.
+ * SPDX-License-Identifier : Apache-2.0
+
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ **/
+
+#include "val/common/include/acs_val.h"
+#include "val/sbsa/include/sbsa_val_interface.h"
+#include "val/sbsa/include/sbsa_acs_exerciser.h"
+
+#include "ras_index.h"
+
+static RAS_INDEX_PORT ras_port[RAS_INDEX_MAX_PORTS];
+
+/**
+  @brief   Return the PCIe RAS compliant error node recording errors of an
+           endpoint below a root port. The platform is only queried the first
+           time an endpoint and root port pair is seen, later lookups are
+           served from a hash on both BDFs.
+
+  @param   e_bdf    BDF of an endpoint below the root port
+  @param   erp_bdf  Root port BDF
+  @return  Platform RAS node, NOT_IMPLEMENTED if there is none.
+**/
+uint32_t
+ras_index_pcie_node(uint32_t e_bdf, uint32_t erp_bdf)
+{
+  uint32_t slot;
+  uint32_t probe;
+
+  slot = ((erp_bdf ^ (erp_bdf >> 8)) ^ ((e_bdf * 0x9E3779B1u) >> 26)) &
+         (RAS_INDEX_MAX_PORTS - 1);
+
+  for (probe = 0; probe < RAS_INDEX_MAX_PORTS; probe++) {
+      if (!ras_port[slot].valid) {
+          ras_port[slot].valid = 1;
+          ras_port[slot].e_bdf = e_bdf;
+          ras_port[slot].rp_bdf = erp_bdf;
+          ras_port[slot].ras_node = val_exerciser_get_pcie_ras_compliant_err_node(e_bdf,
+                                                                                  erp_bdf);
+          return ras_port[slot].ras_node;
+      }
+
+      if ((ras_port[slot].e_bdf == e_bdf) && (ras_port[slot].rp_bdf == erp_bdf))
+          return ras_port[slot].ras_node;
+
+      slot = (slot + 1) & (RAS_INDEX_MAX_PORTS - 1);
+  }
+
+  /* Table full, fall back to the platform */
+  return val_exerciser_get_pcie_ras_compliant_err_node(e_bdf, erp_bdf);
+}
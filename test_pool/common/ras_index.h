@@ -0,0 +1,35 @@
+/** @file
+ * Copyright (c) 2026, Arm Limited or its affiliates. All rights reserved.
+ * SPDX-License-Identifier : Apache-2.0
+
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ **/
+
+#ifndef __RAS_INDEX_H__
+#define __RAS_INDEX_H__
+
+#define RAS_INDEX_MAX_PORTS   64   /* Power of two, hashed on endpoint and root port BDF */
+
+/* Endpoint and root port to PCIe RAS compliant error node, as reported by the
+ * platform, which is given both.
+ */
+typedef struct {
+  uint32_t valid;
+  uint32_t e_bdf;
+  uint32_t rp_bdf;
+  uint32_t ras_node;
+} RAS_INDEX_PORT;
+
+uint32_t ras_index_pcie_node(uint32_t e_bdf, uint32_t erp_bdf);
+
+#endif /* __RAS_INDEX_H__ */
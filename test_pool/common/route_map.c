@@ -0,0 +1,288 @@
+/** @file
+ * Copyright (c) 2026, Arm Limited or its affiliates. All rights reserved.
+ * SPDX-License-Identifier : Apache-2.0
+
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ **/
+
+
+#include "val/common/include/acs_val.h"
+#include "val/sbsa/include/sbsa_val_interface.h"
+
+#include "val/sbsa/include/sbsa_acs_iovirt.h"
+#include "val/common/include/acs_iovirt.h"
+#include "val/common/include/acs_pcie_enumeration.h"
+#include "val/sbsa/include/sbsa_acs_pcie.h"
+
+#include "route_map.h"
+
+static ROUTE_ENTRY route_entry[ROUTE_MAP_SIZE];
+static uint32_t    route_count;
+static ROUTE_NODE  route_node[ROUTE_MAP_MAX_NODES];
+static ROUTE_NODE  route_node_scratch;     /* Nodes past the cache */
+static uint32_t    route_num_nodes;
+static uint32_t    route_num_rc;
+static uint32_t    route_nodes_cached;
+static uint32_t    route_built;
+
+static
+uint32_t
+route_map_key(uint32_t bdf)
+{
+  return (PCIE_EXTRACT_BDF_SEG(bdf) << 16) | PCIE_CREATE_BDF_PACKED(bdf);
+}
+
+/* Multiplicative hash, consecutive RIDs spread over the table */
+static
+uint32_t
+route_map_hash(uint32_t key)
+{
+  return (key * 0x9E3779B1u) >> (32 - ROUTE_MAP_BITS);
+}
+
+/**
+  @brief   Resolve the IORT routing of a requestor into an entry.
+**/
+static
+void
+route_map_resolve(ROUTE_ENTRY *entry, uint32_t bdf)
+{
+  uint32_t seg = PCIE_EXTRACT_BDF_SEG(bdf);
+  uint32_t rid = PCIE_CREATE_BDF_PACKED(bdf);
+
+  entry->key = route_map_key(bdf);
+  entry->smmu_index = val_iovirt_get_rc_smmu_index(seg, rid);
+  entry->smmu_arch = 0;
+  if (entry->smmu_index != ACS_INVALID_INDEX)
+      entry->smmu_arch = val_iovirt_get_smmu_info(SMMU_CTRL_ARCH_MAJOR_REV, entry->smmu_index);
+
+  entry->status = val_iovirt_get_device_info(rid, seg, &entry->device_id, &entry->streamid,
+                                             &entry->its_id);
+}
+
+/**
+  @brief   Find the slot of a key, or the free slot it belongs in.
+
+  @return  Slot, NULL if the key is absent and the table is full.
+**/
+static
+ROUTE_ENTRY *
+route_map_slot(uint32_t key)
+{
+  uint32_t idx, probe;
+
+  idx = route_map_hash(key);
+  for (probe = 0; probe < ROUTE_MAP_SIZE; probe++) {
+      if (route_entry[idx].key == key || route_entry[idx].key == ROUTE_MAP_EMPTY)
+          return &route_entry[idx];
+      idx = (idx + 1) & (ROUTE_MAP_SIZE - 1);
+  }
+
+  return NULL;
+}
+
+static
+ROUTE_ENTRY *
+route_map_insert(uint32_t bdf)
+{
+  ROUTE_ENTRY *entry;
+
+  entry = route_map_slot(route_map_key(bdf));
+  if (entry == NULL)
+      return NULL;
+
+  if (entry->key == ROUTE_MAP_EMPTY) {
+      if (route_count >= (ROUTE_MAP_SIZE / 4) * 3)
+          return NULL;
+
+      route_map_resolve(entry, bdf);
+      route_count++;
+  }
+
+  return entry;
+}
+
+/**
+  @brief   Read a requestor node from IORT. Root complexes come first, then
+           named components.
+
+  @param   node  Filled with the node
+  @param   num   Node number over both kinds
+**/
+static
+void
+route_map_read_node(ROUTE_NODE *node, uint32_t num)
+{
+  uint32_t idx = (num < route_num_rc) ? num : num - route_num_rc;
+
+  node->type = (num < route_num_rc) ? ROUTE_NODE_RC : ROUTE_NODE_NAMED_COMP;
+
+  if (node->type == ROUTE_NODE_RC) {
+      node->segment   = val_iovirt_get_pcie_rc_info(RC_SEGMENT_NUM, idx);
+      node->cca       = val_iovirt_get_pcie_rc_info(RC_MEM_ATTRIBUTE, idx);
+      node->smmu_base = val_iovirt_get_pcie_rc_info(RC_SMMU_BASE, idx);
+      node->name      = NULL;
+  } else {
+      node->segment   = 0;
+      node->cca       = val_iovirt_get_named_comp_info(NAMED_COMP_CCA_ATTR, idx);
+      node->smmu_base = val_iovirt_get_named_comp_info(NAMED_COMP_SMMU_BASE, idx);
+      node->name      = (char8_t *)val_iovirt_get_named_comp_info(NAMED_COMP_DEV_OBJ_NAME, idx);
+  }
+}
+
+/**
+  @brief   Resolve the requestor nodes and every enumerated PCIe function
+           once. Requestors outside the BDF table are added on first lookup.
+           The first ROUTE_MAP_MAX_NODES nodes are cached, the others are
+           read from IORT when asked for.
+**/
+static
+void
+route_map_build(void)
+{
+  uint32_t idx, num;
+  pcie_device_bdf_table *bdf_tbl_ptr;
+
+  route_built = 1;
+  route_count = 0;
+
+  for (idx = 0; idx < ROUTE_MAP_SIZE; idx++)
+      route_entry[idx].key = ROUTE_MAP_EMPTY;
+
+  route_num_rc = val_iovirt_get_pcie_rc_info(NUM_PCIE_RC, 0);
+  route_num_nodes = route_num_rc + val_iovirt_get_named_comp_info(NUM_NAMED_COMP, 0);
+
+  route_nodes_cached = route_num_nodes;
+  if (route_nodes_cached > ROUTE_MAP_MAX_NODES) {
+      val_print(ACS_PRINT_DEBUG, "\n       %d IORT nodes past the route map are read directly",
+                route_nodes_cached - ROUTE_MAP_MAX_NODES);
+      route_nodes_cached = ROUTE_MAP_MAX_NODES;
+  }
+
+  for (num = 0; num < route_nodes_cached; num++)
+      route_map_read_node(&route_node[num], num);
+
+  bdf_tbl_ptr = val_pcie_bdf_table_ptr();
+  if (bdf_tbl_ptr == NULL)
+      return;
+
+  for (idx = 0; idx < bdf_tbl_ptr->num_entries; idx++) {
+      if (route_map_insert(bdf_tbl_ptr->device[idx].bdf) == NULL) {
+          val_print(ACS_PRINT_DEBUG, "\n       Route map full after %d RIDs", route_count);
+          break;
+      }
+  }
+}
+
+/**
+  @brief   Return the resolved routing of a requestor.
+
+  @param   bdf  Requestor in the val BDF format, segment included
+  @return  Routing entry, NULL only if the map is full and the RID unknown.
+**/
+ROUTE_ENTRY *
+route_map_lookup(uint32_t bdf)
+{
+  if (!route_built)
+      route_map_build();
+
+  return route_map_insert(bdf);
+}
+
+/**
+  @brief   Drop-in for val_iovirt_get_rc_smmu_index.
+**/
+uint32_t
+route_map_smmu_index(uint32_t bdf)
+{
+  ROUTE_ENTRY *entry = route_map_lookup(bdf);
+
+  if (entry == NULL)
+      return val_iovirt_get_rc_smmu_index(PCIE_EXTRACT_BDF_SEG(bdf),
+                                          PCIE_CREATE_BDF_PACKED(bdf));
+
+  return entry->smmu_index;
+}
+
+/**
+  @brief   Architecture major revision of the SMMU in front of a requestor.
+
+  @return  SMMU_CTRL_ARCH_MAJOR_REV, 0 when the requestor is not behind an SMMU.
+**/
+uint32_t
+route_map_smmu_arch(uint32_t bdf)
+{
+  ROUTE_ENTRY *entry = route_map_lookup(bdf);
+  uint32_t smmu_index;
+
+  if (entry != NULL)
+      return entry->smmu_arch;
+
+  smmu_index = route_map_smmu_index(bdf);
+  if (smmu_index == ACS_INVALID_INDEX)
+      return 0;
+
+  return val_iovirt_get_smmu_info(SMMU_CTRL_ARCH_MAJOR_REV, smmu_index);
+}
+
+/**
+  @brief   Drop-in for val_iovirt_get_device_info.
+
+  @return  Status of the IORT lookup, 0 on success.
+**/
+uint32_t
+route_map_device_info(uint32_t bdf, uint32_t *device_id, uint32_t *stream_id, uint32_t *its_id)
+{
+  ROUTE_ENTRY *entry = route_map_lookup(bdf);
+
+  if (entry == NULL)
+      return val_iovirt_get_device_info(PCIE_CREATE_BDF_PACKED(bdf), PCIE_EXTRACT_BDF_SEG(bdf),
+                                        device_id, stream_id, its_id);
+
+  *device_id = entry->device_id;
+  *stream_id = entry->streamid;
+  *its_id    = entry->its_id;
+
+  return entry->status;
+}
+
+/**
+  @brief   Number of DMA requestor nodes, root complexes first.
+**/
+uint32_t
+route_map_num_nodes(void)
+{
+  if (!route_built)
+      route_map_build();
+
+  return route_num_nodes;
+}
+
+/**
+  @brief   Requestor node, root complexes first. Nodes past the cache are
+           read into a scratch node, valid until the next call.
+
+  @return  Node, NULL if idx is out of range.
+**/
+ROUTE_NODE *
+route_map_node(uint32_t idx)
+{
+  if (idx >= route_map_num_nodes())
+      return NULL;
+
+  if (idx < route_nodes_cached)
+      return &route_node[idx];
+
+  route_map_read_node(&route_node_scratch, idx);
+  return &route_node_scratch;
+}
@@ -0,0 +1,60 @@
+/** @file
+ * Copyright (c) 2026, Arm Limited or its affiliates. All rights reserved.
+ * SPDX-License-Identifier : Apache-2.0
+
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ **/
+
+
+#ifndef __ROUTE_MAP_H__
+#define __ROUTE_MAP_H__
+
+#define ROUTE_MAP_BITS       12
+#define ROUTE_MAP_SIZE       (1 << ROUTE_MAP_BITS)   /* Kept at most 3/4 full */
+#define ROUTE_MAP_MAX_NODES  64                      /* Cached, later nodes are read from IORT */
+#define ROUTE_MAP_EMPTY      0xFFFFFFFF
+
+/* IORT routing of one requestor ID, resolved once */
+typedef struct {
+  uint32_t key;            /* Segment << 16 | RID, ROUTE_MAP_EMPTY if free */
+  uint32_t status;         /* val_iovirt_get_device_info status, 0 when resolved */
+  uint32_t smmu_index;     /* ACS_INVALID_INDEX when not behind an SMMU */
+  uint32_t smmu_arch;      /* SMMU_CTRL_ARCH_MAJOR_REV, 0 without SMMU */
+  uint32_t streamid;
+  uint32_t device_id;
+  uint32_t its_id;
+} ROUTE_ENTRY;
+
+typedef enum {
+  ROUTE_NODE_RC = 0,
+  ROUTE_NODE_NAMED_COMP
+} ROUTE_NODE_TYPE;
+
+/* DMA requestor node of IORT: PCIe root complex or named component */
+typedef struct {
+  uint32_t type;
+  uint32_t cca;            /* Cache coherent attribute */
+  uint64_t segment;        /* Root complexes only */
+  uint64_t smmu_base;      /* 0 when not behind an SMMU */
+  char8_t  *name;          /* Named components only */
+} ROUTE_NODE;
+
+ROUTE_ENTRY *route_map_lookup(uint32_t bdf);
+uint32_t     route_map_smmu_index(uint32_t bdf);
+uint32_t     route_map_smmu_arch(uint32_t bdf);
+uint32_t     route_map_device_info(uint32_t bdf, uint32_t *device_id, uint32_t *stream_id,
+                                   uint32_t *its_id);
+uint32_t     route_map_num_nodes(void);
+ROUTE_NODE  *route_map_node(uint32_t idx);
+
+#endif /* __ROUTE_MAP_H__ */
@@ -0,0 +1,160 @@
+/** @file
+ * Copyright (c) 2026, Arm Limited or its affiliates. All rights reserved.
+ * SPDX-License-Identifier : Apache-2.0
+
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ **/
+
+#include "val/common/include/acs_val.h"
+#include "val/sbsa/include/sbsa_val_interface.h"
+
+#include "val/sbsa/include/sbsa_acs_smmu.h"
+
+#include "smmu_caps.h"
+
+/* SMMUv3 register page 0 */
+#define SMMU_CAPS_CR0         0x20
+#define SMMU_CAPS_CR0_SMMUEN  (1 << 0)
+
+static SMMU_CAPS smmu_caps[SMMU_CAPS_MAX];
+static SMMU_CAPS smmu_caps_scratch;      /* SMMUs past the cache */
+static uint32_t  smmu_caps_count;
+static uint32_t  smmu_caps_cached;
+static uint32_t  smmu_caps_built;
+
+static
+void
+smmu_caps_decode(SMMU_CAPS *caps)
+{
+  caps->minor      = VAL_EXTRACT_BITS(caps->aidr, 0, 3);
+  caps->s2p        = VAL_EXTRACT_BITS(caps->idr[0], 0, 0);
+  caps->s1p        = VAL_EXTRACT_BITS(caps->idr[0], 1, 1);
+  caps->cohacc     = VAL_EXTRACT_BITS(caps->idr[0], 4, 4);
+  caps->httu       = VAL_EXTRACT_BITS(caps->idr[0], 6, 7);
+  caps->ats        = VAL_EXTRACT_BITS(caps->idr[0], 10, 10);
+  caps->asid16     = VAL_EXTRACT_BITS(caps->idr[0], 12, 12);
+  caps->msi        = VAL_EXTRACT_BITS(caps->idr[0], 13, 13);
+  caps->vmid16     = VAL_EXTRACT_BITS(caps->idr[0], 18, 18);
+  caps->ttendian   = VAL_EXTRACT_BITS(caps->idr[0], 21, 22);
+  caps->mpam       = VAL_EXTRACT_BITS(caps->idr[3], 7, 7);
+  caps->ril        = VAL_EXTRACT_BITS(caps->idr[3], 10, 10);
+  caps->vax        = VAL_EXTRACT_BITS(caps->idr[5], 10, 11);
+  caps->partid_max = VAL_EXTRACT_BITS(caps->mpamidr, 0, 15);
+}
+
+/**
+  @brief   Read and decode the identification registers of one SMMU.
+**/
+static
+void
+smmu_caps_read(SMMU_CAPS *caps, uint32_t idx)
+{
+  val_memory_set(caps, sizeof(SMMU_CAPS), 0);
+
+  caps->arch_major = val_smmu_get_info(SMMU_CTRL_ARCH_MAJOR_REV, idx);
+  caps->base = val_smmu_get_info(SMMU_CTRL_BASE, idx);
+
+  /* SMMUv2 has a different register map */
+  if (caps->arch_major < 3)
+      return;
+
+  caps->idr[0] = val_smmu_read_cfg(SMMUv3_IDR0, idx);
+  caps->idr[1] = val_smmu_read_cfg(SMMUv3_IDR1, idx);
+  caps->idr[2] = val_smmu_read_cfg(SMMUv3_IDR2, idx);
+  caps->idr[3] = val_smmu_read_cfg(SMMUv3_IDR3, idx);
+  caps->idr[4] = val_smmu_read_cfg(SMMUv3_IDR4, idx);
+  caps->idr[5] = val_smmu_read_cfg(SMMUv3_IDR5, idx);
+  caps->aidr = val_smmu_read_cfg(SMMUv3_AIDR, idx);
+  caps->iidr = val_smmu_read_cfg(SMMUv3_IIDR, idx);
+
+  if (VAL_EXTRACT_BITS(caps->idr[3], 7, 7))
+      caps->mpamidr = val_smmu_read_cfg(SMMUv3_MPAMIDR, idx);
+
+  smmu_caps_decode(caps);
+}
+
+/**
+  @brief   Read the identification registers of every SMMU once and decode
+           them. Later SMMU tests only look at the cached records. SMMUs
+           past SMMU_CAPS_MAX are not cached, they are read again on each
+           smmu_caps_get().
+**/
+static
+void
+smmu_caps_build(void)
+{
+  uint32_t idx;
+
+  smmu_caps_built = 1;
+  smmu_caps_count = val_smmu_get_info(SMMU_NUM_CTRL, 0);
+
+  smmu_caps_cached = smmu_caps_count;
+  if (smmu_caps_cached > SMMU_CAPS_MAX) {
+      val_print(ACS_PRINT_DEBUG, "\n       Only first %d SMMUs are cached", SMMU_CAPS_MAX);
+      smmu_caps_cached = SMMU_CAPS_MAX;
+  }
+
+  for (idx = 0; idx < smmu_caps_cached; idx++)
+      smmu_caps_read(&smmu_caps[idx], idx);
+}
+
+/**
+  @brief   Return the number of SMMUs.
+**/
+uint32_t
+smmu_caps_num(void)
+{
+  if (!smmu_caps_built)
+      smmu_caps_build();
+
+  return smmu_caps_count;
+}
+
+/**
+  @brief   Return the decoded capabilities of an SMMU. Indexes past the cache
+           are read directly into a scratch record, which stays valid until
+           the next such lookup.
+
+  @param   smmu_index  SMMU index as used by val_smmu_get_info
+  @return  Capability record, NULL if the index is out of range.
+**/
+SMMU_CAPS *
+smmu_caps_get(uint32_t smmu_index)
+{
+  if (smmu_index >= smmu_caps_num())
+      return NULL;
+
+  if (smmu_index < smmu_caps_cached)
+      return &smmu_caps[smmu_index];
+
+  smmu_caps_read(&smmu_caps_scratch, smmu_index);
+  return &smmu_caps_scratch;
+}
+
+/**
+  @brief   Current SMMU_CR0.SMMUEN of an SMMUv3, read from the SMMU rather
+           than cached, for the benchmarks which enable or bypass an SMMU
+           and must leave it as they found it.
+
+  @return  1 if the SMMU is enabled, 0 if it is disabled or not an SMMUv3.
+**/
+uint32_t
+smmu_caps_enabled(uint32_t smmu_index)
+{
+  SMMU_CAPS *caps = smmu_caps_get(smmu_index);
+
+  if ((caps == NULL) || (caps->arch_major < 3))
+      return 0;
+
+  return (val_mmio_read(caps->base + SMMU_CAPS_CR0) & SMMU_CAPS_CR0_SMMUEN) ? 1 : 0;
+}
@@ -0,0 +1,56 @@
+/** @file
+ * Copyright (c) 2026, Arm Limited or its affiliates. All rights reserved.
+ * SPDX-License-Identifier : Apache-2.0
+
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ **/
+
+#ifndef __SMMU_CAPS_H__
+#define __SMMU_CAPS_H__
+
+#define SMMU_CAPS_MAX  64
+
+/* Identification registers of one SMMU read in a single pass, and the fields
+ * the SMMU rules are evaluated against. IDR/AIDR/IIDR based fields are only
+ * valid for SMMUv3 and above.
+ */
+typedef struct {
+  uint32_t arch_major;   /* SMMU_CTRL_ARCH_MAJOR_REV */
+  uint64_t base;         /* SMMU_CTRL_BASE */
+  uint32_t idr[6];
+  uint32_t aidr;
+  uint32_t iidr;
+  uint32_t mpamidr;      /* Only read when IDR3.MPAM is set */
+
+  /* Decoded fields */
+  uint32_t minor;        /* AIDR.ArchMinorRev */
+  uint32_t s2p;          /* IDR0.S2P */
+  uint32_t s1p;          /* IDR0.S1P */
+  uint32_t cohacc;       /* IDR0.COHACC */
+  uint32_t httu;         /* IDR0.HTTU */
+  uint32_t ats;          /* IDR0.ATS */
+  uint32_t asid16;       /* IDR0.ASID16 */
+  uint32_t msi;          /* IDR0.MSI */
+  uint32_t vmid16;       /* IDR0.VMID16 */
+  uint32_t ttendian;     /* IDR0.TTENDIAN */
+  uint32_t mpam;         /* IDR3.MPAM */
+  uint32_t ril;          /* IDR3.RIL */
+  uint32_t vax;          /* IDR5.VAX */
+  uint32_t partid_max;   /* MPAMIDR.PARTID_MAX */
+} SMMU_CAPS;
+
+uint32_t   smmu_caps_num(void);
+SMMU_CAPS *smmu_caps_get(uint32_t smmu_index);
+uint32_t   smmu_caps_enabled(uint32_t smmu_index);
+
+#endif /* __SMMU_CAPS_H__ */
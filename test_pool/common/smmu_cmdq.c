@@ -0,0 +1,253 @@
+/** @file
+ * Copyright (c) 2026, Arm Limited or its affiliates. All rights reserved.
+ * SPDX-License-Identifier : Apache-2.0
+
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ **/
+
+
+#include "val/common/include/acs_val.h"
+#include "val/sbsa/include/sbsa_val_interface.h"
+
+#include "val/sbsa/include/sbsa_acs_smmu.h"
+
+#include "smmu_caps.h"
+#include "smmu_cmdq.h"
+
+/* SMMUv3 register page 0 */
+#define CMDQ_REG_CR0        0x20
+#define CMDQ_REG_CR1        0x28
+#define CMDQ_REG_GERROR     0x60
+#define CMDQ_REG_GERRORN    0x64
+#define CMDQ_REG_BASE       0x90
+#define CMDQ_REG_PROD       0x98
+#define CMDQ_REG_CONS       0x9C
+
+#define CMDQ_CR0_CMDQEN     (1 << 3)
+#define CMDQ_GERROR_CMDQ    (1 << 0)
+#define CMDQ_BASE_ADDR_MASK 0x000FFFFFFFFFFFE0ULL
+
+/* Entries are published to the SMMU before the PROD update */
+#define CMDQ_BARRIER()  __asm__ volatile ("dsb st" : : : "memory")
+
+uint32_t
+smmu_cmdq_entries(SMMU_CMDQ *q)
+{
+  return 1 << q->log2size;
+}
+
+/* Index bits plus the wrap bit of PROD/CONS */
+static
+uint32_t
+smmu_cmdq_wrap_mask(SMMU_CMDQ *q)
+{
+  return (2 << q->log2size) - 1;
+}
+
+/**
+  @brief   Number of commands written but not yet consumed by the SMMU.
+**/
+uint32_t
+smmu_cmdq_used(SMMU_CMDQ *q)
+{
+  uint32_t cons;
+
+  cons = val_mmio_read(q->base + CMDQ_REG_CONS);
+  return (q->prod - cons) & smmu_cmdq_wrap_mask(q);
+}
+
+static
+void
+smmu_cmdq_write_entry(SMMU_CMDQ *q, uint32_t idx, uint64_t dw0, uint64_t dw1)
+{
+  q->entry[2 * idx]     = dw0;
+  q->entry[2 * idx + 1] = dw1;
+
+  if (q->clean)
+      val_data_cache_ops_by_va((addr_t)&q->entry[2 * idx], CLEAN_AND_INVALIDATE);
+}
+
+/**
+  @brief   Hand every command pushed so far to the SMMU.
+**/
+void
+smmu_cmdq_doorbell(SMMU_CMDQ *q)
+{
+  CMDQ_BARRIER();
+  val_mmio_write(q->base + CMDQ_REG_PROD, q->prod);
+}
+
+/**
+  @brief   Check GERROR for a command queue error. The failing command is
+           overwritten with a CMD_SYNC and the error acknowledged, so the
+           SMMU resumes and the queue can still be drained.
+
+  @return  1 if an error was handled, 0 otherwise.
+**/
+static
+uint32_t
+smmu_cmdq_check_error(SMMU_CMDQ *q)
+{
+  uint32_t gerror, gerrorn, cons;
+
+  gerror  = val_mmio_read(q->base + CMDQ_REG_GERROR);
+  gerrorn = val_mmio_read(q->base + CMDQ_REG_GERRORN);
+  if (((gerror ^ gerrorn) & CMDQ_GERROR_CMDQ) == 0)
+      return 0;
+
+  cons = val_mmio_read(q->base + CMDQ_REG_CONS);
+  q->error = VAL_EXTRACT_BITS(cons, 24, 30);
+
+  smmu_cmdq_write_entry(q, cons & (smmu_cmdq_entries(q) - 1), SMMU_CMDQ_OP_SYNC, 0);
+  CMDQ_BARRIER();
+  val_mmio_write(q->base + CMDQ_REG_GERRORN, gerrorn ^ CMDQ_GERROR_CMDQ);
+
+  return 1;
+}
+
+/**
+  @brief   Wait until the SMMU consumed every command up to PROD.
+
+  @return  0 on success, 1 on a command error or timeout.
+**/
+uint32_t
+smmu_cmdq_drain(SMMU_CMDQ *q)
+{
+  uint32_t timeout = SMMU_CMDQ_TIMEOUT;
+  uint32_t status = 0;
+
+  while (timeout--) {
+      if (smmu_cmdq_check_error(q))
+          status = 1;
+
+      if (smmu_cmdq_used(q) == 0)
+          return status;
+  }
+
+  val_print(ACS_PRINT_WARN, "\n       SMMU %d command queue timeout", q->smmu_index);
+  return 1;
+}
+
+/**
+  @brief   Add a command at PROD without ringing the doorbell. If the queue
+           is full the pending commands are first handed to the SMMU.
+
+  @return  0 on success, 1 if space could not be made.
+**/
+uint32_t
+smmu_cmdq_push(SMMU_CMDQ *q, uint64_t dw0, uint64_t dw1)
+{
+  if (smmu_cmdq_used(q) >= smmu_cmdq_entries(q)) {
+      smmu_cmdq_doorbell(q);
+      if (smmu_cmdq_drain(q))
+          return 1;
+  }
+
+  smmu_cmdq_write_entry(q, q->prod & (smmu_cmdq_entries(q) - 1), dw0, dw1);
+  q->prod = (q->prod + 1) & smmu_cmdq_wrap_mask(q);
+
+  return 0;
+}
+
+/**
+  @brief   Borrow the command queue of an SMMUv3. The queue must be enabled
+           and idle.
+
+  @return  0 on success, 1 if the queue can not be used.
+**/
+uint32_t
+smmu_cmdq_attach(SMMU_CMDQ *q, uint32_t smmu_index)
+{
+  uint64_t qbase;
+  uint32_t cons;
+  SMMU_CAPS *caps;
+
+  val_memory_set(q, sizeof(SMMU_CMDQ), 0);
+
+  caps = smmu_caps_get(smmu_index);
+  if (caps == NULL || caps->arch_major < 3)
+      return 1;
+
+  q->smmu_index = smmu_index;
+  q->base = caps->base;
+
+  if (!(val_mmio_read(q->base + CMDQ_REG_CR0) & CMDQ_CR0_CMDQEN)) {
+      val_print(ACS_PRINT_DEBUG, "\n       SMMU %d command queue not enabled", smmu_index);
+      return 1;
+  }
+
+  qbase = val_mmio_read64(q->base + CMDQ_REG_BASE);
+  q->log2size = VAL_EXTRACT_BITS(qbase, 0, 4);
+  if (q->log2size > SMMU_CMDQ_MAX_LOG2SIZE) {
+      val_print(ACS_PRINT_DEBUG, "\n       SMMU %d command queue too large", smmu_index);
+      return 1;
+  }
+
+  q->prod = val_mmio_read(q->base + CMDQ_REG_PROD) & smmu_cmdq_wrap_mask(q);
+  cons = val_mmio_read(q->base + CMDQ_REG_CONS) & smmu_cmdq_wrap_mask(q);
+  if (q->prod != cons || smmu_cmdq_check_error(q)) {
+      val_print(ACS_PRINT_DEBUG, "\n       SMMU %d command queue busy", smmu_index);
+      return 1;
+  }
+
+  q->start_prod = q->prod;
+  q->entry = (uint64_t *)val_memory_phys_to_virt(qbase & CMDQ_BASE_ADDR_MASK);
+  if (!q->entry)
+      return 1;
+
+  /* CR1.QUEUE_OC, queue accesses are non-cacheable */
+  q->clean = !caps->cohacc ||
+             !VAL_EXTRACT_BITS(val_mmio_read(q->base + CMDQ_REG_CR1), 2, 3);
+
+  return 0;
+}
+
+/**
+  @brief   Pad the queue with CMD_SYNCs until PROD is back at its initial
+           value, so the val SMMU driver finds the queue as it left it.
+**/
+void
+smmu_cmdq_detach(SMMU_CMDQ *q)
+{
+  while (q->prod != q->start_prod) {
+      if (smmu_cmdq_push(q, SMMU_CMDQ_OP_SYNC, 0))
+          break;
+  }
+
+  smmu_cmdq_doorbell(q);
+  smmu_cmdq_drain(q);
+}
+
+/**
+  @brief   Issue a single command followed by a CMD_SYNC and wait for it.
+
+  @return  0 on success, 1 if the queue is unusable or the command failed.
+**/
+uint32_t
+smmu_cmdq_issue(uint32_t smmu_index, uint64_t dw0, uint64_t dw1)
+{
+  uint32_t status;
+  SMMU_CMDQ q;
+
+  if (smmu_cmdq_attach(&q, smmu_index))
+      return 1;
+
+  smmu_cmdq_push(&q, dw0, dw1);
+  smmu_cmdq_push(&q, SMMU_CMDQ_OP_SYNC, 0);
+  smmu_cmdq_doorbell(&q);
+  status = smmu_cmdq_drain(&q);
+
+  smmu_cmdq_detach(&q);
+
+  return status || q.error;
+}
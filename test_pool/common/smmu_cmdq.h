@@ -0,0 +1,65 @@
+/** @file
+ * Copyright (c) 2026, Arm Limited or its affiliates. All rights reserved.
+ * SPDX-License-Identifier : Apache-2.0
+
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ **/
+
+
+#ifndef __SMMU_CMDQ_H__
+#define __SMMU_CMDQ_H__
+
+#define SMMU_CMDQ_MAX_LOG2SIZE  10     /* Larger queues take too long to pad back */
+#define SMMU_CMDQ_TIMEOUT       0x100000
+
+/* Command opcodes */
+#define SMMU_CMDQ_OP_CFGI_STE        0x03
+#define SMMU_CMDQ_OP_CFGI_ALL        0x04   /* CFGI_STE_RANGE with Range 31 */
+#define SMMU_CMDQ_OP_CFGI_CD         0x05
+#define SMMU_CMDQ_OP_TLBI_NH_VA      0x12
+#define SMMU_CMDQ_OP_TLBI_NSNH_ALL   0x30
+#define SMMU_CMDQ_OP_SYNC            0x46
+
+/* Command fields */
+#define SMMU_CMDQ_SID(sid)           ((uint64_t)(sid) << 32)
+#define SMMU_CMDQ_ASID(asid)         ((uint64_t)(asid) << 48)
+#define SMMU_CMDQ_RANGE_NUM(n)       ((uint64_t)(n) << 12)
+#define SMMU_CMDQ_RANGE_SCALE(s)     ((uint64_t)(s) << 20)
+#define SMMU_CMDQ_RANGE_ALL          31ULL
+#define SMMU_CMDQ_TG_4KB             (1ULL << 10)
+#define SMMU_CMDQ_LEAF               1ULL
+
+/* Command queue set up by the val SMMU driver, borrowed by a test. Detaching
+ * leaves PROD where it was found so the driver state stays valid.
+ */
+typedef struct {
+  uint32_t smmu_index;
+  uint64_t base;           /* SMMU register page 0 */
+  uint64_t *entry;         /* Queue memory, two double words per command */
+  uint32_t log2size;
+  uint32_t prod;           /* Next PROD value, including the wrap bit */
+  uint32_t start_prod;     /* PROD on attach */
+  uint32_t clean;          /* Queue is not coherent with the SMMU */
+  uint32_t error;          /* CMDQ_CONS.ERR of the last failed command */
+} SMMU_CMDQ;
+
+uint32_t smmu_cmdq_attach(SMMU_CMDQ *q, uint32_t smmu_index);
+void     smmu_cmdq_detach(SMMU_CMDQ *q);
+uint32_t smmu_cmdq_entries(SMMU_CMDQ *q);
+uint32_t smmu_cmdq_used(SMMU_CMDQ *q);
+uint32_t smmu_cmdq_push(SMMU_CMDQ *q, uint64_t dw0, uint64_t dw1);
+void     smmu_cmdq_doorbell(SMMU_CMDQ *q);
+uint32_t smmu_cmdq_drain(SMMU_CMDQ *q);
+uint32_t smmu_cmdq_issue(uint32_t smmu_index, uint64_t dw0, uint64_t dw1);
+
+#endif /* __SMMU_CMDQ_H__ */
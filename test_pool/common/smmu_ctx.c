@@ -0,0 +1,313 @@
+/** @file
+ * Copyright (c) 2026, Arm Limited or its affiliates. All rights reserved.
+ * SPDX-License-Identifier : Apache-2.0
+
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ **/
+
+#include "val/common/include/acs_val.h"
+#include "val/sbsa/include/sbsa_val_interface.h"
+
+#include "val/common/include/acs_pgt.h"
+#include "val/common/include/acs_pe.h"
+#include "val/sbsa/include/sbsa_acs_pe.h"
+#include "val/sbsa/include/sbsa_acs_memory.h"
+#include "val/sbsa/include/sbsa_acs_smmu.h"
+
+#include "smmu_ctx.h"
+
+static SMMU_CTX     smmu_ctx_pool[SMMU_CTX_POOL_SIZE];
+static uint64_t     smmu_ctx_clock;
+static SMMU_CTX_BUF smmu_ctx_shared;
+
+/**
+  @brief   Check whether a context was built for exactly this mapping, in
+           which case its page table can be reused as is.
+**/
+static
+uint32_t
+smmu_ctx_match(SMMU_CTX *ctx, smmu_master_attributes_t *master,
+               memory_region_descriptor_t *mem_desc, pgt_descriptor_t *pgt_desc)
+{
+  if (val_memory_compare(&ctx->master, master, sizeof(smmu_master_attributes_t)))
+      return 0;
+
+  if (val_memory_compare(&ctx->mem_desc[0], mem_desc, sizeof(memory_region_descriptor_t)))
+      return 0;
+
+  if ((ctx->pgt_desc.ias != pgt_desc->ias) || (ctx->pgt_desc.oas != pgt_desc->oas) ||
+      (ctx->pgt_desc.mair != pgt_desc->mair) || (ctx->pgt_desc.stage != pgt_desc->stage))
+      return 0;
+
+  if (val_memory_compare(&ctx->pgt_desc.tcr, &pgt_desc->tcr, sizeof(pgt_desc->tcr)))
+      return 0;
+
+  return 1;
+}
+
+static
+void
+smmu_ctx_release(SMMU_CTX *ctx)
+{
+  if (ctx->enabled)
+      val_smmu_unmap(ctx->master);
+
+  if (ctx->pgt_desc.pgt_base)
+      val_pgt_destroy(ctx->pgt_desc);
+
+  val_memory_set(ctx, sizeof(SMMU_CTX), 0);
+}
+
+/**
+  @brief   Find the context of a stream, or a slot for a new one. When the
+           pool is full the least recently used disabled context is evicted.
+**/
+static
+SMMU_CTX *
+smmu_ctx_lookup(smmu_master_attributes_t *master)
+{
+  uint32_t idx;
+  SMMU_CTX *ctx;
+  SMMU_CTX *free_ctx = NULL;
+  SMMU_CTX *lru_ctx = NULL;
+
+  for (idx = 0; idx < SMMU_CTX_POOL_SIZE; idx++) {
+      ctx = &smmu_ctx_pool[idx];
+
+      if (!ctx->in_use) {
+          if (free_ctx == NULL)
+              free_ctx = ctx;
+          continue;
+      }
+
+      /* A stream has a single STE, so at most one context per stream */
+      if ((ctx->master.smmu_index == master->smmu_index) &&
+          (ctx->master.streamid == master->streamid))
+          return ctx;
+
+      if (!ctx->enabled && ((lru_ctx == NULL) || (ctx->last_used < lru_ctx->last_used)))
+          lru_ctx = ctx;
+  }
+
+  if (free_ctx)
+      return free_ctx;
+
+  if (lru_ctx)
+      smmu_ctx_release(lru_ctx);
+
+  return lru_ctx;
+}
+
+/**
+  @brief   Map a region for a DMA master, reusing the page table built by an
+           earlier request for the same mapping. Only the STE is re-installed
+           when the context was disabled, and nothing is done when it is
+           still enabled.
+
+  @param   master    SMMU index and stream of the DMA master
+  @param   mem_desc  Region to map
+  @param   pgt_desc  Translation attributes, pgt_base is updated on success
+  @return  Context of the stream, NULL on failure.
+**/
+SMMU_CTX *
+smmu_ctx_map(smmu_master_attributes_t *master, memory_region_descriptor_t *mem_desc,
+             pgt_descriptor_t *pgt_desc)
+{
+  SMMU_CTX *ctx;
+
+  ctx = smmu_ctx_lookup(master);
+  if (ctx == NULL) {
+      val_print(ACS_PRINT_ERR, "\n       SMMU context pool exhausted", 0);
+      return NULL;
+  }
+
+  if (ctx->in_use && smmu_ctx_match(ctx, master, mem_desc, pgt_desc)) {
+      ctx->reuse++;
+      ctx->last_used = ++smmu_ctx_clock;
+      pgt_desc->pgt_base = ctx->pgt_desc.pgt_base;
+
+      if (ctx->enabled)
+          return ctx;
+
+      if (val_smmu_map(ctx->master, ctx->pgt_desc))
+          return NULL;
+
+      ctx->enabled = 1;
+      return ctx;
+  }
+
+  /* Stream is remapped to something else, drop its old translation */
+  if (ctx->in_use)
+      smmu_ctx_release(ctx);
+
+  ctx->master = *master;
+  ctx->mem_desc[0] = *mem_desc;
+  ctx->pgt_desc = *pgt_desc;
+
+  /* set pgt_desc.pgt_base to NULL to create new translation table, val_pgt_create
+     will update pgt_desc.pgt_base to point to created translation table */
+  ctx->pgt_desc.pgt_base = (uint64_t) NULL;
+  if (val_pgt_create(ctx->mem_desc, &ctx->pgt_desc)) {
+      val_print(ACS_PRINT_ERR, "\n       Unable to create page table with given attributes", 0);
+      val_memory_set(ctx, sizeof(SMMU_CTX), 0);
+      return NULL;
+  }
+
+  ctx->in_use = 1;
+  ctx->last_used = ++smmu_ctx_clock;
+
+  if (val_smmu_map(ctx->master, ctx->pgt_desc))
+      return NULL;
+
+  ctx->enabled = 1;
+  pgt_desc->pgt_base = ctx->pgt_desc.pgt_base;
+
+  return ctx;
+}
+
+/**
+  @brief   Put the stream STE back to its unmapped state but keep the page
+           table, so the same mapping can be re-enabled without a rebuild.
+**/
+void
+smmu_ctx_unmap(SMMU_CTX *ctx)
+{
+  if ((ctx == NULL) || !ctx->enabled)
+      return;
+
+  val_smmu_unmap(ctx->master);
+  ctx->enabled = 0;
+}
+
+/**
+  @brief   Disable the STE of every pooled context, in one pass.
+**/
+void
+smmu_ctx_unmap_all(void)
+{
+  uint32_t idx;
+
+  for (idx = 0; idx < SMMU_CTX_POOL_SIZE; idx++)
+      smmu_ctx_unmap(&smmu_ctx_pool[idx]);
+}
+
+/**
+  @brief   Unmap every context, free all pooled page tables and the shared
+           DMA buffer. Called once the exerciser module has run, and by the
+           benchmarks of other modules which are the only pool user there.
+**/
+void
+smmu_ctx_pool_destroy(void)
+{
+  uint32_t idx;
+
+  for (idx = 0; idx < SMMU_CTX_POOL_SIZE; idx++) {
+      if (smmu_ctx_pool[idx].in_use)
+          smmu_ctx_release(&smmu_ctx_pool[idx]);
+  }
+
+  smmu_ctx_buf_free(&smmu_ctx_shared);
+}
+
+/**
+  @brief   DMA buffer shared by the SMMU-backed exerciser tests, allocated on
+           first use and kept until smmu_ctx_pool_destroy(). As every test
+           maps the same buffer, a later test finds the translation an
+           earlier one built for the stream and only re-installs its STE.
+
+  @return  The buffer, NULL if it cannot be allocated.
+**/
+SMMU_CTX_BUF *
+smmu_ctx_shared_buf(void)
+{
+  if ((smmu_ctx_shared.buf_virt == NULL) &&
+      smmu_ctx_buf_alloc(&smmu_ctx_shared, SMMU_CTX_SHARED_PAGES))
+      return NULL;
+
+  return &smmu_ctx_shared;
+}
+
+/**
+  @brief   Region of the shared buffer an exerciser maps: a per exerciser
+           IOVA alias of the buffer, so every instance accesses a unique IOVA
+           which translates to the same physical address.
+
+  @param   instance  Exerciser instance
+  @param   mem_desc  Filled with the region, smmu_ctx_shared_buf() must
+                     have succeeded
+**/
+void
+smmu_ctx_shared_region(uint32_t instance, memory_region_descriptor_t *mem_desc)
+{
+  uint64_t len = (uint64_t)val_memory_page_size() * smmu_ctx_shared.num_pages;
+
+  val_memory_set(mem_desc, sizeof(memory_region_descriptor_t), 0);
+  mem_desc->virtual_address = (uint64_t)smmu_ctx_shared.buf_virt + instance * len;
+  mem_desc->physical_address = smmu_ctx_shared.buf_phys;
+  mem_desc->length = len;
+  mem_desc->attributes = smmu_ctx_shared.s1_attr | PGT_STAGE1_AP_RW;
+}
+
+/**
+  @brief   Allocate a DMA buffer and read the PE stage 1 translation it is
+           mapped with, as the template of the SMMU page tables built for it.
+
+  @param   buf        Buffer to fill
+  @param   num_pages  Size of the buffer in pages
+  @return  0 on success, 1 if the buffer or its translation is not available.
+**/
+uint32_t
+smmu_ctx_buf_alloc(SMMU_CTX_BUF *buf, uint32_t num_pages)
+{
+  uint64_t ttbr;
+
+  val_memory_set(buf, sizeof(SMMU_CTX_BUF), 0);
+
+  buf->buf_virt = val_memory_alloc_pages(num_pages);
+  if (!buf->buf_virt) {
+      val_print(ACS_PRINT_WARN, "\n       DMA buffer alloc failure", 0);
+      return 1;
+  }
+
+  buf->num_pages = num_pages;
+  buf->buf_phys = (uint64_t)val_memory_virt_to_phys(buf->buf_virt);
+
+  if (val_pe_reg_read_tcr(0 /*for TTBR0*/, &buf->pgt_desc.tcr) ||
+      val_pe_reg_read_ttbr(0 /*for TTBR0*/, &ttbr))
+      goto free_buf;
+
+  buf->pgt_desc.pgt_base = (ttbr & AARCH64_TTBR_ADDR_MASK);
+  buf->pgt_desc.mair = val_pe_reg_read(MAIR_ELx);
+  buf->pgt_desc.stage = PGT_STAGE1;
+
+  if (val_pgt_get_attributes(buf->pgt_desc, (uint64_t)buf->buf_virt, &buf->s1_attr))
+      goto free_buf;
+
+  return 0;
+
+free_buf:
+  smmu_ctx_buf_free(buf);
+  return 1;
+}
+
+/**
+  @brief   Free a buffer allocated by smmu_ctx_buf_alloc().
+**/
+void
+smmu_ctx_buf_free(SMMU_CTX_BUF *buf)
+{
+  if (buf->buf_virt)
+      val_memory_free_pages(buf->buf_virt, buf->num_pages);
+
+  buf->buf_virt = NULL;
+}
@@ -0,0 +1,59 @@
+/** @file
+ * Copyright (c) 2026, Arm Limited or its affiliates. All rights reserved.
+ * SPDX-License-Identifier : Apache-2.0
+
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ **/
+
+#ifndef __SMMU_CTX_H__
+#define __SMMU_CTX_H__
+
+#define SMMU_CTX_POOL_SIZE     32
+#define SMMU_CTX_SHARED_PAGES  1     /* DMA buffer shared by the exerciser tests */
+
+/* Translation context of one stream: its page table and the mapping it was
+ * built for. The page table outlives the STE so that a later request for the
+ * same mapping only has to re-install the STE.
+ */
+typedef struct {
+  uint32_t in_use;
+  uint32_t enabled;                  /* STE currently points at pgt_desc */
+  uint32_t reuse;                    /* Number of requests served without a rebuild */
+  uint64_t last_used;
+  smmu_master_attributes_t master;
+  pgt_descriptor_t pgt_desc;
+  memory_region_descriptor_t mem_desc[2];  /* Mapped region and terminator */
+} SMMU_CTX;
+
+/* DMA buffer of a benchmark, with the PE stage 1 translation it is mapped with.
+ * pgt_desc is the template the SMMU page tables of the buffer are built from.
+ */
+typedef struct {
+  void    *buf_virt;
+  uint64_t buf_phys;
+  uint32_t num_pages;
+  uint64_t s1_attr;                  /* PE stage 1 attributes of the buffer */
+  pgt_descriptor_t pgt_desc;
+} SMMU_CTX_BUF;
+
+uint32_t  smmu_ctx_buf_alloc(SMMU_CTX_BUF *buf, uint32_t num_pages);
+void      smmu_ctx_buf_free(SMMU_CTX_BUF *buf);
+SMMU_CTX *smmu_ctx_map(smmu_master_attributes_t *master, memory_region_descriptor_t *mem_desc,
+                       pgt_descriptor_t *pgt_desc);
+void      smmu_ctx_unmap(SMMU_CTX *ctx);
+void      smmu_ctx_unmap_all(void);
+void      smmu_ctx_pool_destroy(void);
+SMMU_CTX_BUF *smmu_ctx_shared_buf(void);
+void      smmu_ctx_shared_region(uint32_t instance, memory_region_descriptor_t *mem_desc);
+
+#endif /* __SMMU_CTX_H__ */
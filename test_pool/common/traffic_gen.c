@@ -0,0 +1,327 @@
+/** @file
+ * Copyright (c) 2026, Arm Limited or its affiliates. All rights reserved.
+ * SPDX-License-Identifier : Apache-2.0
+
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ **/
+
+
+#include "val/common/include/acs_val.h"
+#include "val/common/include/acs_memory.h"
+#include "val/sbsa/include/sbsa_val_interface.h"
+
+#include "pe_sync.h"
+#include "traffic_gen.h"
+
+/* Full period LCG modulo a power of two: multiplier 1 mod 4 and odd increment */
+#define TGEN_LCG_MUL  0x5DEECE66Dull
+#define TGEN_LCG_INC  11
+
+static TGEN_CFG *tgen_multi_cfg;
+static volatile uint64_t tgen_sink;
+
+static
+uint64_t
+tgen_stride(TGEN_CFG *cfg)
+{
+  uint64_t stride = cfg->stride;
+
+  if (stride < TGEN_LINE_SIZE)
+      stride = TGEN_LINE_SIZE;
+
+  return stride & ~((uint64_t)TGEN_LINE_SIZE - 1);
+}
+
+/**
+  @brief   Number of lines accessed in each buffer per pass. Random order
+           covers the largest power of two number of lines in the buffer.
+**/
+uint64_t
+tgen_lines(TGEN_CFG *cfg)
+{
+  uint64_t lines = cfg->size / TGEN_LINE_SIZE;
+  uint64_t pow2 = 1;
+
+  switch (cfg->pattern) {
+  case TGEN_PATTERN_STRIDE:
+      return cfg->size / tgen_stride(cfg);
+  case TGEN_PATTERN_RANDOM:
+      if (lines == 0)
+          return 0;
+      while ((pow2 << 1) <= lines)
+          pow2 <<= 1;
+      return pow2;
+  default:
+      return lines;
+  }
+}
+
+/**
+  @brief   Bytes requested from memory by a run, lines read plus lines
+           written. Write allocation and cache hits are not modelled.
+**/
+uint64_t
+tgen_bytes(TGEN_CFG *cfg)
+{
+  uint64_t bytes = tgen_lines(cfg) * TGEN_LINE_SIZE;
+
+  if (cfg->op == TGEN_OP_COPY)
+      bytes *= 2;
+
+  return bytes * (cfg->iter ? cfg->iter : 1);
+}
+
+static
+void
+tgen_store_line(uint64_t *dst, uint64_t v0, uint64_t v1, uint64_t v2, uint64_t v3,
+                uint64_t v4, uint64_t v5, uint64_t v6, uint64_t v7, uint32_t nontemporal)
+{
+  if (nontemporal) {
+      __asm__ volatile ("stnp %0, %1, [%2]" : : "r" (v0), "r" (v1), "r" (dst) : "memory");
+      __asm__ volatile ("stnp %0, %1, [%2, #16]" : : "r" (v2), "r" (v3), "r" (dst) : "memory");
+      __asm__ volatile ("stnp %0, %1, [%2, #32]" : : "r" (v4), "r" (v5), "r" (dst) : "memory");
+      __asm__ volatile ("stnp %0, %1, [%2, #48]" : : "r" (v6), "r" (v7), "r" (dst) : "memory");
+      return;
+  }
+
+  dst[0] = v0;
+  dst[1] = v1;
+  dst[2] = v2;
+  dst[3] = v3;
+  dst[4] = v4;
+  dst[5] = v5;
+  dst[6] = v6;
+  dst[7] = v7;
+}
+
+static
+uint64_t
+tgen_line(TGEN_CFG *cfg, uint64_t offset, uint64_t seed)
+{
+  volatile uint64_t *src = (volatile uint64_t *)(cfg->src + offset);
+  uint64_t *dst = (uint64_t *)(cfg->dst + offset);
+
+  switch (cfg->op) {
+  case TGEN_OP_READ:
+      return src[0];
+  case TGEN_OP_WRITE:
+      tgen_store_line(dst, seed, seed, seed, seed, seed, seed, seed, seed, cfg->nontemporal);
+      return 0;
+  default:
+      tgen_store_line(dst, src[0], src[1], src[2], src[3], src[4], src[5], src[6], src[7],
+                      cfg->nontemporal);
+      return 0;
+  }
+}
+
+/**
+  @brief   Generate the configured traffic on the calling PE.
+
+  @param   cfg  Traffic configuration, cfg->ticks is updated
+  @return  Bytes requested from memory, as tgen_bytes.
+**/
+uint64_t
+tgen_run(TGEN_CFG *cfg)
+{
+  uint64_t lines = tgen_lines(cfg);
+  uint64_t stride = TGEN_LINE_SIZE;
+  uint64_t line, idx;
+  uint64_t start;
+  uint64_t sum = 0;
+  uint32_t iter;
+
+  if (cfg->pattern == TGEN_PATTERN_STRIDE)
+      stride = tgen_stride(cfg);
+
+  start = perf_get_ticks();
+  for (iter = 0; iter < (cfg->iter ? cfg->iter : 1); iter++) {
+      idx = iter;
+      for (line = 0; line < lines; line++) {
+          if (cfg->pattern == TGEN_PATTERN_RANDOM) {
+              idx = (idx * TGEN_LCG_MUL + TGEN_LCG_INC) & (lines - 1);
+              sum += tgen_line(cfg, idx * TGEN_LINE_SIZE, line);
+          } else {
+              sum += tgen_line(cfg, line * stride, line);
+          }
+      }
+  }
+
+  if (cfg->nontemporal && cfg->op != TGEN_OP_READ)
+      __asm__ volatile ("dsb sy" : : : "memory");
+
+  cfg->ticks = perf_get_ticks() - start;
+  tgen_sink = sum;
+
+  return tgen_bytes(cfg);
+}
+
+/**
+  @brief   Link the lines of buf in a single random cycle (Sattolo), so the
+           chase defeats the prefetchers and every load depends on the last.
+
+  @param   buf   Buffer, each line holds the address of the next one
+  @param   size  Bytes of buf covered by the chain
+  @return  Address of the first line, to start tgen_chase from.
+**/
+uint64_t
+tgen_chain_build(uint64_t buf, uint64_t size)
+{
+  uint64_t num = size / TGEN_LINE_SIZE;
+  uint64_t seed = 0x9E3779B97F4A7C15ull;
+  uint64_t idx, pick, tmp;
+  uint64_t *node;
+
+  for (idx = 0; idx < num; idx++)
+      *(uint64_t *)(buf + idx * TGEN_LINE_SIZE) = idx;
+
+  for (idx = num - 1; idx > 0; idx--) {
+      seed ^= seed << 13;
+      seed ^= seed >> 7;
+      seed ^= seed << 17;
+      pick = seed % idx;
+
+      node = (uint64_t *)(buf + pick * TGEN_LINE_SIZE);
+      tmp = *node;
+      *node = *(uint64_t *)(buf + idx * TGEN_LINE_SIZE);
+      *(uint64_t *)(buf + idx * TGEN_LINE_SIZE) = tmp;
+  }
+
+  for (idx = 0; idx < num; idx++) {
+      node = (uint64_t *)(buf + idx * TGEN_LINE_SIZE);
+      *node = buf + *node * TGEN_LINE_SIZE;
+  }
+
+  return buf;
+}
+
+/**
+  @brief   Follow a chain built by tgen_chain_build for the given loads.
+
+  @return  Where the chase stopped, to resume it from.
+**/
+uint64_t
+tgen_chase(uint64_t ptr, uint32_t loads)
+{
+  while (loads--)
+      ptr = *(volatile uint64_t *)ptr;
+
+  return ptr;
+}
+
+static
+void
+tgen_worker(uint32_t slot)
+{
+  TGEN_CFG *cfg = &tgen_multi_cfg[slot];
+
+  tgen_run(cfg);
+  val_data_cache_ops_by_va((addr_t)&cfg->ticks, CLEAN_AND_INVALIDATE);
+}
+
+/**
+  @brief   Run one traffic configuration per PE, all PEs released together.
+
+  @param   num_pe    Number of PEs in pe_list
+  @param   pe_list   Secondary PE indexes
+  @param   cfg       num_pe configurations, cfg[n] runs on pe_list[n]
+  @param   test_num  Test the secondary PE status is reported against
+  @return  0 on success, 1 if some PE did not run or complete.
+**/
+uint32_t
+tgen_run_multi(uint32_t num_pe, uint32_t *pe_list, TGEN_CFG *cfg, uint32_t test_num)
+{
+  uint32_t slot;
+
+  tgen_multi_cfg = cfg;
+  val_data_cache_ops_by_va((addr_t)&tgen_multi_cfg, CLEAN_AND_INVALIDATE);
+  for (slot = 0; slot < num_pe; slot++)
+      val_data_cache_ops_by_va((addr_t)&cfg[slot], CLEAN_AND_INVALIDATE);
+
+  if (pe_sync_launch(num_pe, pe_list, tgen_worker, test_num)) {
+      pe_sync_wait();
+      return 1;
+  }
+
+  if (pe_sync_wait())
+      return 1;
+
+  for (slot = 0; slot < num_pe; slot++)
+      val_data_cache_ops_by_va((addr_t)&cfg[slot].ticks, CLEAN_AND_INVALIDATE);
+
+  return 0;
+}
+
+/**
+  @brief   Drive a counter with the configuration at TGEN_LIN_POINTS sizes
+           and compare the counts with the bytes requested. The slope is a
+           least squares fit through the origin, counts per 1000 bytes, and
+           the deviation is the worst point against that slope.
+
+  @param   cfg      Traffic at its largest size, restored on return
+  @param   counter  Resets and reads the counter under test
+  @param   ctx      Passed to counter
+  @param   name     Printed with the results
+  @return  Worst deviation from the fitted slope in per mille.
+**/
+uint32_t
+tgen_linearity(TGEN_CFG *cfg, TGEN_COUNTER counter, void *ctx, char8_t *name)
+{
+  uint64_t size = cfg->size;
+  uint64_t expected[TGEN_LIN_POINTS];
+  uint64_t count[TGEN_LIN_POINTS];
+  uint64_t sxx = 0, sxy = 0;
+  uint64_t slope, fit, dev;
+  uint64_t worst = 0;
+  uint32_t point;
+
+  val_print(ACS_PRINT_TEST, "\n       Linearity of ", 0);
+  val_print(ACS_PRINT_TEST, name, 0);
+  val_print(ACS_PRINT_TEST, "\n         Expected bytes        Count", 0);
+
+  for (point = 0; point < TGEN_LIN_POINTS; point++) {
+      cfg->size = size >> (TGEN_LIN_POINTS - 1 - point);
+
+      counter(ctx, TGEN_COUNTER_RESET);
+      expected[point] = tgen_run(cfg);
+      count[point] = counter(ctx, TGEN_COUNTER_READ);
+
+      /* Scaled down to keep the sums in 64 bit */
+      sxx += (expected[point] >> 10) * (expected[point] >> 10);
+      sxy += (expected[point] >> 10) * (count[point] >> 10);
+
+      val_print(ACS_PRINT_TEST, "\n         %14d", expected[point]);
+      val_print(ACS_PRINT_TEST, "  %11d", count[point]);
+  }
+
+  cfg->size = size;
+
+  if (sxx == 0)
+      return 0;
+
+  slope = (sxy * 1000) / sxx;
+  for (point = 0; point < TGEN_LIN_POINTS; point++) {
+      fit = (expected[point] * slope) / 1000;
+      if (fit == 0)
+          continue;
+
+      dev = (count[point] > fit) ? count[point] - fit : fit - count[point];
+      dev = (dev * 1000) / fit;
+      if (dev > worst)
+          worst = dev;
+  }
+
+  val_print(ACS_PRINT_TEST, "\n         Slope %d counts per 1000 bytes", slope);
+  val_print(ACS_PRINT_TEST, ", worst deviation %d per mille", worst);
+
+  return (uint32_t)worst;
+}
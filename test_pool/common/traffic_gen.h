@@ -0,0 +1,68 @@
+/** @file
+ * Copyright (c) 2026, Arm Limited or its affiliates. All rights reserved.
+ * SPDX-License-Identifier : Apache-2.0
+
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ **/
+
+
+#ifndef __TRAFFIC_GEN_H__
+#define __TRAFFIC_GEN_H__
+
+#include "perf_util.h"
+
+#define TGEN_LINE_SIZE    64
+#define TGEN_LIN_POINTS   4     /* Linearity sweep at size/8, size/4, size/2 and size */
+
+typedef enum {
+  TGEN_OP_READ = 0,
+  TGEN_OP_WRITE,
+  TGEN_OP_COPY
+} TGEN_OP;
+
+typedef enum {
+  TGEN_PATTERN_SEQ = 0,
+  TGEN_PATTERN_STRIDE,
+  TGEN_PATTERN_RANDOM
+} TGEN_PATTERN;
+
+/* Every access is a whole cache line, so the traffic reaching memory is known
+ * from the configuration alone, see tgen_bytes.
+ */
+typedef struct {
+  uint32_t op;             /* TGEN_OP_* */
+  uint32_t pattern;        /* TGEN_PATTERN_* */
+  uint32_t stride;         /* Bytes between lines, TGEN_PATTERN_STRIDE only */
+  uint32_t nontemporal;    /* Use non-temporal stores (STNP) */
+  uint32_t iter;           /* Passes over the buffers, 0 is taken as 1 */
+  uint64_t src;            /* Read buffer, READ and COPY */
+  uint64_t dst;            /* Written buffer, WRITE and COPY */
+  uint64_t size;           /* Bytes of each buffer covered */
+  uint64_t ticks;          /* Set by tgen_run, duration of the last run */
+} TGEN_CFG;
+
+/* Counter under test, op is TGEN_COUNTER_RESET or TGEN_COUNTER_READ */
+typedef uint64_t (*TGEN_COUNTER)(void *ctx, uint32_t op);
+
+#define TGEN_COUNTER_RESET  0
+#define TGEN_COUNTER_READ   1
+
+uint64_t tgen_lines(TGEN_CFG *cfg);
+uint64_t tgen_bytes(TGEN_CFG *cfg);
+uint64_t tgen_run(TGEN_CFG *cfg);
+uint64_t tgen_chain_build(uint64_t buf, uint64_t size);
+uint64_t tgen_chase(uint64_t ptr, uint32_t loads);
+uint32_t tgen_run_multi(uint32_t num_pe, uint32_t *pe_list, TGEN_CFG *cfg, uint32_t test_num);
+uint32_t tgen_linearity(TGEN_CFG *cfg, TGEN_COUNTER counter, void *ctx, char8_t *name);
+
+#endif /* __TRAFFIC_GEN_H__ */
@@ -29,6 +29,9 @@
 #include "val/sbsa/include/sbsa_acs_pcie.h"
 #include "val/sbsa/include/sbsa_acs_exerciser.h"
 
+#include "../../common/dma_bench.h"
+#include "../../common/route_map.h"
+
 #define TEST_NUM   (ACS_EXERCISER_TEST_NUM_BASE + 2)
 #define TEST_DESC  "PCIe Address translation check        "
 #define TEST_RULE  "RE_SMU_2"
@@ -163,19 +166,14 @@ payload(void)
     val_print(ACS_PRINT_DEBUG, "\n       Exercise BDF - 0x%x", e_bdf);
 
     /* Get SMMU node index for this exerciser instance */
-    master.smmu_index = val_iovirt_get_rc_smmu_index(PCIE_EXTRACT_BDF_SEG(e_bdf),
-                                                     PCIE_CREATE_BDF_PACKED(e_bdf));
+    master.smmu_index = route_map_smmu_index(e_bdf);
 
     clear_dram_buf(dram_buf_in_virt, test_data_blk_size);
 
     dram_buf_in_iova = dram_buf_in_phys;
     dram_buf_out_iova = dram_buf_out_phys;
-    if (master.smmu_index != ACS_INVALID_INDEX &&
-        val_iovirt_get_smmu_info(SMMU_CTRL_ARCH_MAJOR_REV, master.smmu_index) == 3) {
-        if (val_iovirt_get_device_info(PCIE_CREATE_BDF_PACKED(e_bdf),
-                                       PCIE_EXTRACT_BDF_SEG(e_bdf),
-                                       &device_id, &master.streamid,
-                                       &its_id))
+    if (route_map_smmu_arch(e_bdf) == 3) {
+        if (route_map_device_info(e_bdf, &device_id, &master.streamid, &its_id))
             continue;
 
         /* Each exerciser instance accesses a unique IOVA, which, because of SMMU translations,
@@ -268,12 +266,8 @@ test_clean:
   for (instance = 0; instance < num_exercisers; ++instance)
   {
     e_bdf = val_exerciser_get_bdf(instance);
-    master.smmu_index = val_iovirt_get_rc_smmu_index(PCIE_EXTRACT_BDF_SEG(e_bdf),
-                                                     PCIE_CREATE_BDF_PACKED(e_bdf));
-    if (val_iovirt_get_device_info(PCIE_CREATE_BDF_PACKED(e_bdf),
-                                   PCIE_EXTRACT_BDF_SEG(e_bdf),
-                                   &device_id, &master.streamid,
-                                   &its_id))
+    master.smmu_index = route_map_smmu_index(e_bdf);
+    if (route_map_device_info(e_bdf, &device_id, &master.streamid, &its_id))
         continue;
     val_smmu_unmap(master);
     if (pgt_base_array[instance] != 0) {
@@ -282,6 +276,10 @@ test_clean:
     }
   }
 
+  /* Measure DMA bandwidth once the functional mappings are removed */
+  if (g_sbsa_perf_mode)
+      dma_bench_run();
+
   /* Disable all SMMUs */
   for (instance = 0; instance < num_smmus; ++instance)
      val_smmu_disable(instance);
@@ -29,11 +29,14 @@
 #include "val/sbsa/include/sbsa_acs_pcie.h"
 #include "val/sbsa/include/sbsa_acs_exerciser.h"
 
+#include "../../common/smmu_ctx.h"
+#include "../../common/route_map.h"
+
 #define TEST_NUM   (ACS_EXERCISER_TEST_NUM_BASE + 3)
 #define TEST_DESC  "ATS Functionality Check               "
 #define TEST_RULE  "RE_SMU_2"
 
-#define TEST_DATA_NUM_PAGES  1
+#define TEST_DATA_NUM_PAGES  SMMU_CTX_SHARED_PAGES
 #define TEST_DATA 0xDE
 
 static
@@ -88,9 +91,9 @@ payload(void)
   memory_region_descriptor_t mem_desc_array[2], *mem_desc;
   pgt_descriptor_t pgt_desc;
   smmu_master_attributes_t master;
+  SMMU_CTX_BUF *shared_buf;
   uint64_t ttbr;
   uint32_t test_data_blk_size = page_size * TEST_DATA_NUM_PAGES;
-  uint64_t *pgt_base_array;
   uint64_t translated_addr;
   uint32_t test_skip = 1;
   uint32_t reg_value = 0;
@@ -105,26 +108,14 @@ payload(void)
   num_exercisers = val_exerciser_get_info(EXERCISER_NUM_CARDS);
   num_smmus = val_iovirt_get_smmu_info(SMMU_NUM_CTRL, 0);
 
-  /* Allocate an array to store base addresses of page tables allocated for
-   * all exercisers
-   */
-  pgt_base_array = val_aligned_alloc(MEM_ALIGN_4K, sizeof(uint64_t) * num_exercisers);
-  if (!pgt_base_array) {
-      val_print(ACS_PRINT_ERR, "\n       mem alloc failure", 0);
-      val_set_status(pe_index, RESULT_FAIL(TEST_NUM, 02));
-      return;
-  }
-
-  val_memory_set(pgt_base_array, sizeof(uint64_t) * num_exercisers, 0);
-
-  /* Allocate a buffer to perform DMA tests on */
-  dram_buf_in_virt = val_memory_alloc_pages(TEST_DATA_NUM_PAGES);
-  if (!dram_buf_in_virt) {
+  /* Perform the DMA tests on the buffer shared by the SMMU-backed exerciser tests */
+  shared_buf = smmu_ctx_shared_buf();
+  if (shared_buf == NULL) {
       val_print(ACS_PRINT_ERR, "\n       Cacheable mem alloc failure", 0);
-      val_memory_free_aligned(pgt_base_array);
       val_set_status(pe_index, RESULT_FAIL(TEST_NUM, 03));
       return;
   }
+  dram_buf_in_virt = shared_buf->buf_virt;
 
   /* Set the virtual and physical addresses for test buffers */
   dram_buf_in_phys = (uint64_t)val_memory_virt_to_phys(dram_buf_in_virt);
@@ -185,39 +176,22 @@ payload(void)
     pgt_desc.mair = val_pe_reg_read(MAIR_ELx);
     pgt_desc.stage = PGT_STAGE1;
 
-    /* Get memory attributes of the test buffer, we'll use the same attibutes to create
-     * our own page table later.
-     */
-    if (val_pgt_get_attributes(pgt_desc, (uint64_t)dram_buf_in_virt, &mem_desc->attributes)) {
-        val_print(ACS_PRINT_ERR, "\n       Unable to get memory attributes of the test buffer", 0);
-        goto test_fail;
-    }
-
     /* Get SMMU node index for this exerciser instance */
-    master.smmu_index = val_iovirt_get_rc_smmu_index(PCIE_EXTRACT_BDF_SEG(e_bdf),
-                                                     PCIE_CREATE_BDF_PACKED(e_bdf));
+    master.smmu_index = route_map_smmu_index(e_bdf);
 
     clear_dram_buf(dram_buf_in_virt, test_data_blk_size);
 
     dram_buf_in_iova = dram_buf_in_phys;
     dram_buf_out_iova = dram_buf_out_phys;
-    if (master.smmu_index != ACS_INVALID_INDEX &&
-        val_iovirt_get_smmu_info(SMMU_CTRL_ARCH_MAJOR_REV, master.smmu_index) == 3) {
-        if (val_iovirt_get_device_info(PCIE_CREATE_BDF_PACKED(e_bdf),
-                                       PCIE_EXTRACT_BDF_SEG(e_bdf),
-                                       &device_id, &master.streamid,
-                                       &its_id))
+    if (route_map_smmu_arch(e_bdf) == 3) {
+        if (route_map_device_info(e_bdf, &device_id, &master.streamid, &its_id))
             continue;
 
         /* Each exerciser instance accesses a unique IOVA, which, because of SMMU translations,
          * will point to the same physical address. We create the requisite page tables and
          * configure the SMMU for each exerciser as such.
          */
-
-        mem_desc->virtual_address = (uint64_t)dram_buf_in_virt + instance * test_data_blk_size;
-        mem_desc->physical_address = dram_buf_in_phys;
-        mem_desc->length = test_data_blk_size;
-        mem_desc->attributes |= PGT_STAGE1_AP_RW;
+        smmu_ctx_shared_region(instance, mem_desc);
 
         /* Need to know input and output address sizes before creating page table */
         pgt_desc.ias = val_smmu_get_info(SMMU_IN_ADDR_SIZE, master.smmu_index);
@@ -234,20 +208,9 @@ payload(void)
             goto test_fail;
         }
 
-        /* set pgt_desc.pgt_base to NULL to create new translation table, val_pgt_create
-           will update pgt_desc.pgt_base to point to created translation table */
-        pgt_desc.pgt_base = (uint64_t) NULL;
-        if (val_pgt_create(mem_desc, &pgt_desc)) {
-            val_print(ACS_PRINT_ERR,
-                      "\n       Unable to create page table with given attributes", 0);
-            goto test_fail;
-        }
-
-        pgt_base_array[instance] = pgt_desc.pgt_base;
-
-        /* Configure the SMMU tables for this exerciser to use this page table
-           for VA to PA translations*/
-        if (val_smmu_map(master, pgt_desc))
+        /* Configure the SMMU tables for this exerciser to use a page table for
+           VA to PA translations, reusing the pooled one if this mapping was built before */
+        if (smmu_ctx_map(&master, mem_desc, &pgt_desc) == NULL)
         {
             val_print(ACS_PRINT_ERR, "\n       SMMU mapping failed (%x)     ", e_bdf);
             goto test_fail;
@@ -325,27 +288,14 @@ test_fail:
   val_set_status(pe_index, RESULT_FAIL(TEST_NUM, 01));
 
 test_clean:
-  /* Return the pages to the heap manager */
-  val_memory_free_pages(dram_buf_in_virt, TEST_DATA_NUM_PAGES);
+  /* Disable the STEs but keep the page tables and the buffer for the next
+   * SMMU-backed test, the pool is destroyed once the exerciser module ends
+   */
+  smmu_ctx_unmap_all();
 
-  /* Remove all address mappings for each exerciser */
   for (instance = 0; instance < num_exercisers; ++instance)
   {
     e_bdf = val_exerciser_get_bdf(instance);
-    master.smmu_index = val_iovirt_get_rc_smmu_index(PCIE_EXTRACT_BDF_SEG(e_bdf),
-                                                     PCIE_CREATE_BDF_PACKED(e_bdf));
-    if (val_iovirt_get_device_info(PCIE_CREATE_BDF_PACKED(e_bdf),
-                                   PCIE_EXTRACT_BDF_SEG(e_bdf),
-                                   &device_id, &master.streamid,
-                                   &its_id))
-        continue;
-
-    val_smmu_unmap(master);
-
-    if (pgt_base_array[instance] != 0) {
-      pgt_desc.pgt_base = pgt_base_array[instance];
-      val_pgt_destroy(pgt_desc);
-    }
 
     if (val_pcie_find_capability(e_bdf, PCIE_ECAP, ECID_ATS, &cap_base) == PCIE_SUCCESS)
     {
@@ -359,8 +309,6 @@ test_clean:
   /* Disable all SMMUs */
   for (instance = 0; instance < num_smmus; ++instance)
      val_smmu_disable(instance);
-
-  val_memory_free_aligned(pgt_base_array);
 }
 
 
@@ -28,6 +28,9 @@
 #include "val/sbsa/include/sbsa_acs_memory.h"
 #include "val/sbsa/include/sbsa_acs_exerciser.h"
 
+#include "../../common/err_campaign.h"
+#include "../../common/route_map.h"
+
 #define TEST_NUM   (ACS_EXERCISER_TEST_NUM_BASE + 6)
 #define TEST_DESC  "RP's must support AER feature         "
 #define TEST_RULE  "PCI_ER_01, PCI_ER_04"
@@ -36,20 +39,20 @@
 #define ERR_UNCORR   0x3
 #define CLEAR_STATUS 0xFFFFFFFF
 
-static uint32_t irq_pending;
 static uint32_t lpi_int_id = 0x204C;
 static uint32_t mask_value;
 static uint32_t msi_check;
+static ERR_CAMPAIGN campaign;
 
 static
 void
 intr_handler(void)
 {
-  /* Clear the interrupt pending state */
-  irq_pending = 0;
+  /* Record the completion, status registers are read by the campaign */
+  err_campaign_isr(campaign.int_id);
 
-  val_print(ACS_PRINT_INFO, "\n       Received MSI interrupt %x       ", lpi_int_id);
-  val_gic_end_of_interrupt(lpi_int_id);
+  val_print(ACS_PRINT_INFO, "\n       Received MSI interrupt %x       ", campaign.int_id);
+  val_gic_end_of_interrupt(campaign.int_id);
   return;
 }
 
@@ -76,60 +79,53 @@ clear_status_bits(uint32_t e_bdf, uint32_t aer_offset, uint32_t mask, uint32_t s
 }
 
 static uint32_t
-correctable_err_status_chk(uint32_t e_bdf, uint32_t aer_offset, uint32_t err_code)
+correctable_err_status_chk(ERR_CAMPAIGN *camp, ERR_EVENT *evt)
 {
-    uint32_t erp_bdf, reg_bdf, rp_aer_offset;
+    uint32_t reg_bdf;
     uint32_t value, err_bit;
-    uint32_t pciecs_base, reg_value;
     uint32_t fail_cnt = 0;
+    ERR_SNAPSHOT *snap = &evt->snap;
 
-    val_pcie_get_rootport(e_bdf, &erp_bdf);
-    val_pcie_find_capability(erp_bdf, PCIE_ECAP, ECID_AER, &rp_aer_offset);
-    err_bit = val_get_exerciser_err_info(err_code);
+    err_bit = val_get_exerciser_err_info(evt->err_value);
 
     /* Check if corresponding error bit is set */
-    val_pcie_read_cfg(e_bdf, aer_offset + AER_CORR_STATUS_OFFSET, &value);
-    if (!((value >> err_bit) & 0x1))
+    if (!((snap->ep_corr_status >> err_bit) & 0x1))
     {
         val_print(ACS_PRINT_ERR, "\n       Err bit for error not set", 0);
         fail_cnt++;
     }
 
     /* Check if the RP has received the corresponding error type if error is not masked */
-    val_pcie_read_cfg(erp_bdf, rp_aer_offset + AER_ROOT_ERR_OFFSET, &value);
-    if ((mask_value == 0) && ((value & 0x1) == 0))
+    if ((mask_value == 0) && ((snap->rp_root_err_status & 0x1) == 0))
     {
         val_print(ACS_PRINT_ERR, "\n       Root error status not set", 0);
         fail_cnt++;
     }
 
-    if ((mask_value == 1) && ((value & 0x1) == 1))
+    if ((mask_value == 1) && ((snap->rp_root_err_status & 0x1) == 1))
     {
         val_print(ACS_PRINT_ERR, "\n       Root error status set when error is masked", 0);
         fail_cnt++;
     }
 
     /* Check if the Reg ID matches with the error source ID */
-    val_pcie_read_cfg(erp_bdf, rp_aer_offset + AER_ROOT_ERR_SOURCE_ID, &value);
-    reg_bdf = PCIE_CREATE_BDF_PACKED(e_bdf);
-    if ((mask_value == 0) && ((value & AER_SOURCE_ID_MASK) != reg_bdf))
+    reg_bdf = PCIE_CREATE_BDF_PACKED(camp->e_bdf);
+    if ((mask_value == 0) && ((snap->rp_err_source_id & AER_SOURCE_ID_MASK) != reg_bdf))
     {
         val_print(ACS_PRINT_ERR, "\n       Error source Identification failed", 0);
         fail_cnt++;
     }
 
     /* Check if the appropriate status bit is set in Device status register */
-    val_pcie_find_capability(e_bdf, PCIE_CAP, CID_PCIECS, &pciecs_base);
-    val_pcie_read_cfg(e_bdf, pciecs_base + DCTLR_OFFSET, &reg_value);
-    if (!((reg_value >> DSTS_SHIFT) & 0x1))
+    if (!((snap->ep_dev_ctl_status >> DSTS_SHIFT) & 0x1))
     {
-        val_print(ACS_PRINT_ERR, "\n       Device reg of EP not set %x ", reg_value);
+        val_print(ACS_PRINT_ERR, "\n       Device reg of EP not set %x ", snap->ep_dev_ctl_status);
         fail_cnt++;
     }
 
     /* Clear the Error status bit in the RP */
-    val_pcie_write_cfg(erp_bdf, rp_aer_offset + AER_ROOT_ERR_OFFSET, 0x1);
-    val_pcie_read_cfg(erp_bdf, rp_aer_offset + AER_ROOT_ERR_OFFSET, &value);
+    val_pcie_write_cfg(camp->erp_bdf, camp->rp_aer_offset + AER_ROOT_ERR_OFFSET, 0x1);
+    val_pcie_read_cfg(camp->erp_bdf, camp->rp_aer_offset + AER_ROOT_ERR_OFFSET, &value);
     if ((value & 0x1))
     {
         val_print(ACS_PRINT_ERR, "\n       Err bit is not cleared %x ", value);
@@ -143,60 +139,54 @@ correctable_err_status_chk(uint32_t e_bdf, uint32_t aer_offset, uint32_t err_cod
 }
 
 static uint32_t
-uncorrectable_error_chk(uint32_t e_bdf, uint32_t aer_offset, uint32_t err_code)
+uncorrectable_error_chk(ERR_CAMPAIGN *camp, ERR_EVENT *evt)
 {
-    uint32_t erp_bdf, reg_bdf, rp_aer_offset;
+    uint32_t reg_bdf;
     uint32_t value, err_bit;
-    uint32_t pciecs_base, reg_value;
     uint32_t fail_cnt = 0;
+    ERR_SNAPSHOT *snap = &evt->snap;
 
-    val_pcie_get_rootport(e_bdf, &erp_bdf);
-    val_pcie_find_capability(erp_bdf, PCIE_ECAP, ECID_AER, &rp_aer_offset);
-    err_bit = val_get_exerciser_err_info(err_code);
+    err_bit = val_get_exerciser_err_info(evt->err_value);
 
     /* Check if corresponding error bit is set */
-    val_pcie_read_cfg(e_bdf, aer_offset + AER_UNCORR_STATUS_OFFSET, &value);
-    if (!((value >> err_bit) & 0x1))
+    if (!((snap->ep_uncorr_status >> err_bit) & 0x1))
     {
-        val_print(ACS_PRINT_ERR, "\n       Err bit not set %x", value);
+        val_print(ACS_PRINT_ERR, "\n       Err bit not set %x", snap->ep_uncorr_status);
         fail_cnt++;
     }
 
     /* Check if the RP has received the corresponding error type if error is not masked */
-    val_pcie_read_cfg(erp_bdf, rp_aer_offset + AER_ROOT_ERR_OFFSET, &value);
-    if ((mask_value == 0) && ((value & 0x4) == 0))
+    if ((mask_value == 0) && ((snap->rp_root_err_status & 0x4) == 0))
     {
         val_print(ACS_PRINT_ERR, "\n       Root Error status not set", 0);
         fail_cnt++;
     }
 
-    if ((mask_value == 1) && ((value & 0x4) == 0x4))
+    if ((mask_value == 1) && ((snap->rp_root_err_status & 0x4) == 0x4))
     {
         val_print(ACS_PRINT_ERR, "\n       Root error status set when error is masked", 0);
         fail_cnt++;
     }
 
     /* Check if the Reg ID matches with the error source ID */
-    val_pcie_read_cfg(erp_bdf, rp_aer_offset + AER_ROOT_ERR_SOURCE_ID, &value);
-    reg_bdf = PCIE_CREATE_BDF_PACKED(e_bdf);
-    if ((mask_value == 0) && (((value >> AER_SOURCE_ID_SHIFT) & AER_SOURCE_ID_MASK) != reg_bdf))
+    reg_bdf = PCIE_CREATE_BDF_PACKED(camp->e_bdf);
+    if ((mask_value == 0) &&
+        (((snap->rp_err_source_id >> AER_SOURCE_ID_SHIFT) & AER_SOURCE_ID_MASK) != reg_bdf))
     {
         val_print(ACS_PRINT_ERR, "\n       Error source Identification failed", 0);
         fail_cnt++;
     }
 
     /* Check if the appropriate status bit is set in Device status register */
-    val_pcie_find_capability(e_bdf, PCIE_CAP, CID_PCIECS, &pciecs_base);
-    val_pcie_read_cfg(e_bdf, pciecs_base + DCTLR_OFFSET, &reg_value);
-    if (!((reg_value >> DSTS_SHIFT) & DS_UNCORR_MASK))
+    if (!((snap->ep_dev_ctl_status >> DSTS_SHIFT) & DS_UNCORR_MASK))
     {
         val_print(ACS_PRINT_ERR, "\n       Device reg of EP not set", 0);
         fail_cnt++;
     }
 
     /* Clear the Error status bit in the RP */
-    val_pcie_write_cfg(erp_bdf, rp_aer_offset + AER_ROOT_ERR_OFFSET, 0x7F);
-    val_pcie_read_cfg(erp_bdf, rp_aer_offset + AER_ROOT_ERR_OFFSET, &value);
+    val_pcie_write_cfg(camp->erp_bdf, camp->rp_aer_offset + AER_ROOT_ERR_OFFSET, 0x7F);
+    val_pcie_read_cfg(camp->erp_bdf, camp->rp_aer_offset + AER_ROOT_ERR_OFFSET, &value);
     if ((value & 0x7F))
     {
         val_print(ACS_PRINT_ERR, "\n       Err bit is not cleared %x", value);
@@ -210,62 +200,69 @@ uncorrectable_error_chk(uint32_t e_bdf, uint32_t aer_offset, uint32_t err_code)
 
 }
 
+/* Replay every queued error code of the campaign. Completion of each error is
+ * taken from the ISR completion ring and all AER registers are captured in a
+ * single snapshot before being checked.
+ **/
 static
 uint32_t
-inject_error(uint32_t e_bdf, uint32_t instance, uint32_t aer_offset)
+inject_error(ERR_CAMPAIGN *camp)
 {
-    uint32_t err_code;
-    uint32_t status, value;
-    uint32_t res, timeout;
+    uint32_t idx;
+    uint32_t res;
+    ERR_EVENT *evt;
+
+    err_campaign_reset(camp);
 
-    for (err_code = 0; err_code <= ERR_CNT; err_code++)
+    for (idx = 0; idx < camp->num_events; idx++)
     {
-        irq_pending = 1;
+        evt = &camp->event[idx];
 
-        status = val_exerciser_set_param(ERROR_INJECT_TYPE, err_code, 0, instance);
-        value = val_exerciser_ops(INJECT_ERROR, err_code, instance);
+        evt->err_type = val_exerciser_set_param(ERROR_INJECT_TYPE, evt->err_code, 0,
+                                                camp->instance);
+
+        /* Timestamp just before the injection, so the latency excludes the setup */
+        err_campaign_arm(camp, evt);
+        evt->err_value = val_exerciser_ops(INJECT_ERROR, evt->err_code, camp->instance);
 
         /* If MSI/MSI-X is supported then interrupt must be generated
          * on error detection if errors are not masked*/
-        if (msi_check == 1)
-        {
-            if (mask_value == 0) {
-                timeout = TIMEOUT_LARGE;
-                while ((--timeout > 0) && irq_pending)
-                {};
-
-                if (timeout == 0)
-                {
-                    val_gic_free_irq(irq_pending, 0);
-                    val_print(ACS_PRINT_ERR,
-                              "\n       Intr not trigerred on err injection bdf 0x%x", e_bdf);
-                    return 1;
-                }
+        if ((msi_check == 1) && (mask_value == 0)) {
+            if (err_campaign_wait(camp, evt, TIMEOUT_LARGE))
+            {
+                val_gic_free_irq(camp->int_id, 0);
+                val_print(ACS_PRINT_ERR,
+                          "\n       Intr not trigerred on err injection bdf 0x%x", camp->e_bdf);
+                return 1;
             }
         }
 
+        err_campaign_snapshot(camp, &evt->snap);
+
         /* Check if error injected is correctable or uncorrectable*/
-        if (status == ERR_CORR) {
+        if (evt->err_type == ERR_CORR) {
             val_print(ACS_PRINT_INFO, "\n       Correctable error recieved", 0);
-            res = correctable_err_status_chk(e_bdf, aer_offset, value);
+            res = correctable_err_status_chk(camp, evt);
             if (res) {
                 val_print(ACS_PRINT_ERR,
-                          "\n       Correctable error check failed for bdf %x", e_bdf);
+                          "\n       Correctable error check failed for bdf %x", camp->e_bdf);
                 return 1;
             }
         }
 
-        else if (status == ERR_UNCORR) {
+        else if (evt->err_type == ERR_UNCORR) {
             val_print(ACS_PRINT_INFO, "\n       UnCorrectable error recieved", 0);
-            res = uncorrectable_error_chk(e_bdf, aer_offset, value);
+            res = uncorrectable_error_chk(camp, evt);
             if (res) {
                 val_print(ACS_PRINT_ERR,
-                          "\n       Uncorrectable error check failed for bdf %x", e_bdf);
+                          "\n       Uncorrectable error check failed for bdf %x", camp->e_bdf);
                 return 1;
             }
         }
     }
 
+    err_campaign_report(camp);
+
     return 0;
 }
 
@@ -279,6 +276,7 @@ payload(void)
   uint32_t pe_index;
   uint32_t e_bdf;
   uint32_t erp_bdf;
+  uint32_t err_code;
   uint32_t aer_offset;
   uint32_t rp_aer_offset;
   uint32_t value = 0;
@@ -291,7 +289,6 @@ payload(void)
   uint32_t its_id = 0;
   uint32_t msi_index = 0;
   uint32_t msi_cap_offset = 0;
-  uint32_t dpc_cap_base = 0;
 
   pe_index = val_pe_get_index_mpid(val_pe_get_mpid());
   instance = val_exerciser_get_info(EXERCISER_NUM_CARDS);
@@ -312,21 +309,25 @@ payload(void)
      val_pcie_enable_eru(erp_bdf);
      msi_check = 0;
 
+     /* Resolve AER/DPC capabilities of exerciser and its RP once for the campaign */
+     err_campaign_init(&campaign, instance, e_bdf, erp_bdf, lpi_int_id + instance);
+     aer_offset = campaign.aer_offset;
+     rp_aer_offset = campaign.rp_aer_offset;
+
      /*Check AER capability for exerciser and its RP */
-      if (val_pcie_find_capability(e_bdf, PCIE_ECAP, ECID_AER, &aer_offset) != PCIE_SUCCESS) {
+      if (aer_offset == 0) {
           val_print(ACS_PRINT_ERR, "\n       No AER Capability, Skipping for Bdf : 0x%x", e_bdf);
           continue;
       }
 
-      if (val_pcie_find_capability(erp_bdf, PCIE_ECAP, ECID_AER, &rp_aer_offset) != PCIE_SUCCESS) {
+      if (rp_aer_offset == 0) {
           val_print(ACS_PRINT_ERR, "\n       AER Capability not supported for RP : 0x%x", erp_bdf);
           val_set_status(pe_index, RESULT_FAIL(TEST_NUM, 01));
           return;
       }
 
       /* Check DPC capability */
-      status = val_pcie_find_capability(erp_bdf, PCIE_ECAP, ECID_DPC, &dpc_cap_base);
-      if (status == PCIE_CAP_NOT_FOUND)
+      if (campaign.rp_dpc_base == 0)
       {
           val_print(ACS_PRINT_ERR, "\n       ECID_DPC not found", 0);
           val_set_status(pe_index, RESULT_FAIL(TEST_NUM, 01));
@@ -334,7 +335,7 @@ payload(void)
       }
 
       /* Warn if DPC enabled */
-      val_pcie_read_cfg(erp_bdf, dpc_cap_base + DPC_CTRL_OFFSET, &reg_value);
+      val_pcie_read_cfg(erp_bdf, campaign.rp_dpc_base + DPC_CTRL_OFFSET, &reg_value);
       if ((reg_value & 0x3) != 0)
           val_print(ACS_PRINT_WARN, "\n       DPC enabled for bdf : 0x%x", erp_bdf);
 
@@ -351,9 +352,7 @@ payload(void)
 
       msi_check = 1;
       /* Get DeviceID & ITS_ID for this device */
-      status = val_iovirt_get_device_info(PCIE_CREATE_BDF_PACKED(erp_bdf),
-                                        PCIE_EXTRACT_BDF_SEG(erp_bdf), &device_id,
-                                        &stream_id, &its_id);
+      status = route_map_device_info(erp_bdf, &device_id, &stream_id, &its_id);
 
       if (status) {
           val_print(ACS_PRINT_ERR, "\n       iovirt_get_device failed for bdf 0x%x", e_bdf);
@@ -379,14 +378,17 @@ payload(void)
 
 err_check:
       test_skip = 0;
-      val_pcie_find_capability(erp_bdf, PCIE_ECAP, ECID_AER, &rp_aer_offset);
       val_pcie_read_cfg(erp_bdf, rp_aer_offset + AER_ROOT_ERR_CMD_OFFSET, &value);
       val_pcie_write_cfg(erp_bdf, rp_aer_offset + AER_ROOT_ERR_CMD_OFFSET, (value | 0x7));
 
+      /* Queue every error code once, each pass below replays the whole campaign */
+      for (err_code = 0; err_code <= ERR_CNT; err_code++)
+          err_campaign_queue(&campaign, err_code);
+
       /* Errors not masked and severity is non-fatal */
       mask_value = 0;
       clear_status_bits(e_bdf, aer_offset, 0, 0);
-      if (inject_error(e_bdf, instance, aer_offset))
+      if (inject_error(&campaign))
       {
           val_set_status(pe_index, RESULT_FAIL(TEST_NUM, 03));
           return;
@@ -395,7 +397,7 @@ err_check:
       /* Errors masked and severity is non-fatal */
       mask_value = 1;
       clear_status_bits(e_bdf, aer_offset, AER_ERROR_MASK, 0);
-      if (inject_error(e_bdf, instance, aer_offset))
+      if (inject_error(&campaign))
       {
           val_set_status(pe_index, RESULT_FAIL(TEST_NUM, 04));
           return;
@@ -404,7 +406,7 @@ err_check:
 
       /* Errors not masked and severity is fatal */
       clear_status_bits(e_bdf, aer_offset, 0, AER_UNCORR_SEVR_FATAL);
-      if (inject_error(e_bdf, instance, aer_offset))
+      if (inject_error(&campaign))
       {
           val_set_status(pe_index, RESULT_FAIL(TEST_NUM, 05));
           return;
@@ -27,6 +27,9 @@
 #include "val/sbsa/include/sbsa_acs_memory.h"
 #include "val/sbsa/include/sbsa_acs_exerciser.h"
 
+#include "../../common/err_campaign.h"
+#include "../../common/route_map.h"
+
 #define TEST_NUM   (ACS_EXERCISER_TEST_NUM_BASE + 7)
 #define TEST_DESC  "RP's must support DPC                 "
 #define TEST_RULE  "PCI_ER_05, PCI_ER_06"
@@ -37,8 +40,8 @@
 #define MAX_DEVICES  256
 
 static uint32_t msg_type[] = {ERR_FATAL_NONFATAL, ERR_FATAL};
-static uint32_t irq_pending;
 static uint32_t lpi_int_id = 0x204C;
+static ERR_CAMPAIGN campaign;
 
 /* Allocating memory only for 256 devices */
 static void     *cfg_space_buf[MAX_DEVICES];
@@ -47,11 +50,11 @@ static
 void
 intr_handler(void)
 {
-  /* Clear the interrupt pending state */
-  irq_pending = 0;
+  /* Record the completion, DPC status is read by the campaign */
+  err_campaign_isr(campaign.int_id);
 
-  val_print(ACS_PRINT_INFO, "\n       Received MSI interrupt %x       ", lpi_int_id);
-  val_gic_end_of_interrupt(lpi_int_id);
+  val_print(ACS_PRINT_INFO, "\n       Received MSI interrupt %x       ", campaign.int_id);
+  val_gic_end_of_interrupt(campaign.int_id);
   return;
 }
 
@@ -161,6 +164,7 @@ payload(void)
   uint32_t dpc_trigger_reason;
   uint32_t timeout;
   uint32_t msi_check = 0;
+  ERR_EVENT *evt;
 
   uint32_t device_id = 0;
   uint32_t stream_id = 0;
@@ -186,21 +190,26 @@ payload(void)
           continue;
       val_pcie_enable_eru(erp_bdf);
 
+      /* Resolve AER/DPC capabilities of exerciser and its RP once for the campaign */
+      err_campaign_init(&campaign, instance, e_bdf, erp_bdf, lpi_int_id + instance);
+      rp_dpc_cap_base = campaign.rp_dpc_base;
+      aer_offset = campaign.aer_offset;
+      rp_aer_offset = campaign.rp_aer_offset;
+
       /* Check DPC capability */
-      status = val_pcie_find_capability(erp_bdf, PCIE_ECAP, ECID_DPC, &rp_dpc_cap_base);
-      if (status == PCIE_CAP_NOT_FOUND)
+      if (rp_dpc_cap_base == 0)
       {
           val_print(ACS_PRINT_ERR, "\n       ECID_DPC not found", 0);
           continue;
       }
 
       /* Check AER capability for both exerciser and RP */
-      if (val_pcie_find_capability(e_bdf, PCIE_ECAP, ECID_AER, &aer_offset) != PCIE_SUCCESS) {
+      if (aer_offset == 0) {
           val_print(ACS_PRINT_ERR, "\n       AER Capability not supported, Bdf : 0x%x", e_bdf);
           continue;
       }
 
-      if (val_pcie_find_capability(erp_bdf, PCIE_ECAP, ECID_AER, &rp_aer_offset) != PCIE_SUCCESS) {
+      if (rp_aer_offset == 0) {
           val_print(ACS_PRINT_ERR, "\n       AER Capability not supported for RP : 0x%x", erp_bdf);
           fail_cnt++;
       }
@@ -213,9 +222,7 @@ payload(void)
 
       msi_check = 1;
       /* Get DeviceID & ITS_ID for this device */
-      status = val_iovirt_get_device_info(PCIE_CREATE_BDF_PACKED(erp_bdf),
-                                        PCIE_EXTRACT_BDF_SEG(erp_bdf), &device_id,
-                                        &stream_id, &its_id);
+      status = route_map_device_info(erp_bdf, &device_id, &stream_id, &its_id);
 
       if (status) {
           val_print(ACS_PRINT_ERR, "\n       iovirt_get_device failed for bdf 0x%x", e_bdf);
@@ -248,9 +255,16 @@ err_check:
 
       test_skip = 0;
 
+      /* Queue the fatal and non-fatal DPC triggers for this RP */
+      for (int i = 0; i < 2; i++) {
+          evt = err_campaign_queue(&campaign, msg_type[i]);
+          evt->err_type = status;
+      }
+
       /* check for both fatal and non-fatal error */
       for (int i = 0; i < 2; i++)
       {
+          evt = &campaign.event[i];
           val_pcie_data_link_layer_status(erp_bdf);
 
           /* Save the config space of all the devices connected to the RP
@@ -258,16 +272,15 @@ err_check:
           save_config_space(erp_bdf);
           val_print(ACS_PRINT_INFO, "       EP BDF : 0x%x\n", e_bdf);
 
-          irq_pending = 1;
           val_pcie_read_cfg(erp_bdf, rp_dpc_cap_base + DPC_CTRL_OFFSET, &reg_value);
           reg_value &= DPC_DISABLE_MASK;
           reg_value |= DPC_INTR_ENABLE;
-          reg_value = reg_value | (msg_type[i] << DPC_CTRL_TRG_EN_SHIFT);
+          reg_value = reg_value | (evt->err_code << DPC_CTRL_TRG_EN_SHIFT);
           val_pcie_write_cfg(erp_bdf, rp_dpc_cap_base + DPC_CTRL_OFFSET, reg_value);
 
           val_pcie_read_cfg(erp_bdf, rp_dpc_cap_base + DPC_CTRL_OFFSET, &reg_value);
 
-          if (msg_type[i] == ERR_FATAL)
+          if (evt->err_code == ERR_FATAL)
           {
               val_pcie_write_cfg(e_bdf, aer_offset + AER_UNCORR_SEVR_OFFSET, AER_UNCORR_SEVR_FATAL);
               val_pcie_write_cfg(e_bdf, aer_offset + AER_UNCORR_MASK_OFFSET, 0x0);
@@ -278,7 +291,8 @@ err_check:
           }
 
           /*Inject error immediately*/
-          val_exerciser_ops(INJECT_ERROR, CFG_READ, instance);
+          err_campaign_arm(&campaign, evt);
+          evt->err_value = val_exerciser_ops(INJECT_ERROR, CFG_READ, instance);
 
           val_pcie_read_cfg(e_bdf, CFG_READ, &reg_value);
           if (reg_value != PCIE_UNKNOWN_RESPONSE)
@@ -287,7 +301,9 @@ err_check:
               fail_cnt++;
           }
 
-          val_pcie_read_cfg(erp_bdf, rp_dpc_cap_base + DPC_STATUS_OFFSET, &reg_value);
+          /* Capture the AER/DPC state of the event in one pass */
+          err_campaign_snapshot(&campaign, &evt->snap);
+          reg_value = evt->snap.rp_dpc_status;
 
           /* Check DPC Trigger status */
           if ((reg_value & 1) == 0)
@@ -297,7 +313,7 @@ err_check:
           }
 
           dpc_trigger_reason = (reg_value & DPC_TRIGGER_MASK) >> 1;
-          if (msg_type[i] == ERR_FATAL)
+          if (evt->err_code == ERR_FATAL)
           {
               if (dpc_trigger_reason != 2)
               {
@@ -322,12 +338,8 @@ err_check:
 
           if (msi_check == 1)
           {
-              timeout = TIMEOUT_LARGE;
-              while ((--timeout > 0) && irq_pending)
-              {};
-
-              if (timeout == 0) {
-                  val_gic_free_irq(irq_pending, 0);
+              if (err_campaign_wait(&campaign, evt, TIMEOUT_LARGE)) {
+                  val_gic_free_irq(campaign.int_id, 0);
                   val_print(ACS_PRINT_ERR, "\n       Interrupt trigger failed for bdf 0x%x", e_bdf);
                   fail_cnt++;
                   continue;
@@ -402,6 +414,8 @@ err_check:
           }
 
       }
+
+      err_campaign_report(&campaign);
   }
 
   if (test_skip)
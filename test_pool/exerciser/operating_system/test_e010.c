@@ -28,6 +28,9 @@
 #include "val/sbsa/include/sbsa_val_interface.h"
 #include "val/sbsa/include/sbsa_acs_exerciser.h"
 
+#include "../../common/err_campaign.h"
+#include "../../common/route_map.h"
+
 #define TEST_NUM   (ACS_EXERCISER_TEST_NUM_BASE + 10)
 #define TEST_DESC  "DPC trig when RP-PIO unimplemented    "
 #define TEST_RULE  "PCI_ER_10"
@@ -36,8 +39,8 @@
 #define MAX_DEVICES  256
 
 static uint32_t msg_type[] = {UNCORR_AMPT_ABORT, UNCORR_UR};
-static uint32_t irq_pending;
 static uint32_t lpi_int_id = 0x204C;
+static ERR_CAMPAIGN campaign;
 
 /* Allocating memory only for 256 devices */
 static void     *cfg_space_buf[MAX_DEVICES];
@@ -46,11 +49,11 @@ static
 void
 intr_handler(void)
 {
-  /* Clear the interrupt pending state */
-  irq_pending = 0;
+  /* Record the completion, DPC status is read by the campaign */
+  err_campaign_isr(campaign.int_id);
 
-  val_print(ACS_PRINT_INFO, "\n       Received MSI interrupt %x", lpi_int_id);
-  val_gic_end_of_interrupt(lpi_int_id);
+  val_print(ACS_PRINT_INFO, "\n       Received MSI interrupt %x", campaign.int_id);
+  val_gic_end_of_interrupt(campaign.int_id);
   return;
 }
 
@@ -156,6 +159,7 @@ payload(void)
   uint32_t aer_offset;
   uint32_t rp_aer_offset;
   uint32_t timeout;
+  ERR_EVENT *evt;
 
   uint32_t device_id = 0;
   uint32_t stream_id = 0;
@@ -181,22 +185,27 @@ payload(void)
           continue;
       val_pcie_enable_eru(erp_bdf);
 
+      /* Resolve AER/DPC capabilities of exerciser and its RP once for the campaign */
+      err_campaign_init(&campaign, instance, e_bdf, erp_bdf, lpi_int_id + instance);
+      aer_offset = campaign.aer_offset;
+      rp_aer_offset = campaign.rp_aer_offset;
+      rp_dpc_cap_base = campaign.rp_dpc_base;
+
       /* Check AER capability for both exerciser and RP */
-      if (val_pcie_find_capability(e_bdf, PCIE_ECAP, ECID_AER, &aer_offset) != PCIE_SUCCESS) {
+      if (aer_offset == 0) {
           val_print(ACS_PRINT_ERR, "\n       AER Capability not supported", 0);
           val_print(ACS_PRINT_ERR, "\n       Skipping for BDF : 0x%x", e_bdf);
           continue;
       }
 
-      if (val_pcie_find_capability(erp_bdf, PCIE_ECAP, ECID_AER, &rp_aer_offset) != PCIE_SUCCESS) {
+      if (rp_aer_offset == 0) {
           val_print(ACS_PRINT_ERR, "\n       AER Capability not supported", 0);
           val_print(ACS_PRINT_ERR, "\n       Skipping for BDF : 0x%x", erp_bdf);
           continue;
       }
 
       /* Check DPC capability */
-      status = val_pcie_find_capability(erp_bdf, PCIE_ECAP, ECID_DPC, &rp_dpc_cap_base);
-      if (status == PCIE_CAP_NOT_FOUND)
+      if (rp_dpc_cap_base == 0)
       {
           val_print(ACS_PRINT_ERR, "\n       ECID_DPC not found", 0);
           val_print(ACS_PRINT_ERR, "\n       Skipping for BDF : 0x%x", erp_bdf);
@@ -221,9 +230,7 @@ payload(void)
       }
 
       /* Get DeviceID & ITS_ID for this device */
-      status = val_iovirt_get_device_info(PCIE_CREATE_BDF_PACKED(erp_bdf),
-                                        PCIE_EXTRACT_BDF_SEG(erp_bdf), &device_id,
-                                        &stream_id, &its_id);
+      status = route_map_device_info(erp_bdf, &device_id, &stream_id, &its_id);
 
       if (status) {
           val_print(ACS_PRINT_ERR, "\n       iovirt_get_device failed for bdf 0x%x", e_bdf);
@@ -247,10 +254,16 @@ payload(void)
           return;
       }
 
+      /* Queue UR and Completer abort for this RP */
+      for (int i = 0; i < 2; i++)
+          err_campaign_queue(&campaign, msg_type[i]);
+
       /* check for UR and Completor abort */
       for (int i = 0; i < 2; i++)
       {
-          status = val_exerciser_set_param(ERROR_INJECT_TYPE, msg_type[i], 1, instance);
+          evt = &campaign.event[i];
+          status = val_exerciser_set_param(ERROR_INJECT_TYPE, evt->err_code, 1, instance);
+          evt->err_type = status;
           if (status != ERR_UNCORR) {
               val_print(ACS_PRINT_ERR, "\n       Error Injection failed, Bdf : 0x%x", e_bdf);
               continue;
@@ -260,7 +273,6 @@ payload(void)
            to restore after Secondary Bus Reset (SBR)*/
           save_config_space(erp_bdf);
 
-          irq_pending = 1;
           val_pcie_read_cfg(erp_bdf, rp_dpc_cap_base + DPC_CTRL_OFFSET, &reg_value);
           reg_value &= DPC_DISABLE_MASK;
           reg_value |= DPC_INTR_ENABLE;
@@ -274,7 +286,8 @@ payload(void)
            */
 
           /*Inject error immediately*/
-          val_exerciser_ops(INJECT_ERROR, CFG_READ, instance);
+          err_campaign_arm(&campaign, evt);
+          evt->err_value = val_exerciser_ops(INJECT_ERROR, CFG_READ, instance);
 
           val_pcie_read_cfg(e_bdf, CFG_READ, &reg_value);
           if (reg_value != PCIE_UNKNOWN_RESPONSE)
@@ -283,7 +296,9 @@ payload(void)
               fail_cnt++;
           }
 
-          val_pcie_read_cfg(erp_bdf, rp_dpc_cap_base + DPC_STATUS_OFFSET, &reg_value);
+          /* Capture the AER/DPC state of the event in one pass */
+          err_campaign_snapshot(&campaign, &evt->snap);
+          reg_value = evt->snap.rp_dpc_status;
 
           /* Check DPC Trigger status */
           if ((reg_value & 1) == 0)
@@ -292,12 +307,8 @@ payload(void)
               fail_cnt++;
           }
 
-          timeout = TIMEOUT_LARGE;
-          while ((--timeout > 0) && irq_pending)
-          {};
-
-          if (timeout == 0) {
-              val_gic_free_irq(irq_pending, 0);
+          if (err_campaign_wait(&campaign, evt, TIMEOUT_LARGE)) {
+              val_gic_free_irq(campaign.int_id, 0);
               val_print(ACS_PRINT_ERR, "\n       Interrupt trigger failed for bdf 0x%lx", e_bdf);
               fail_cnt++;
               continue;
@@ -367,6 +378,8 @@ payload(void)
               fail_cnt++;
           }
       }
+
+      err_campaign_report(&campaign);
   }
 
   if (test_skip)
@@ -24,6 +24,8 @@
 #include "val/common/include/acs_pcie_enumeration.h"
 #include "val/common/include/acs_pcie.h"
 
+#include "../../common/ras_index.h"
+
 #define TEST_NUM   (ACS_EXERCISER_TEST_NUM_BASE + 11)
 #define TEST_RULE  "PCI_ER_08"
 #define TEST_DESC  "RAS ERR record for poisoned data      "
@@ -79,7 +81,8 @@ payload()
           goto get_bar_data;
       }
 
-      ras_node = val_exerciser_get_pcie_ras_compliant_err_node(e_bdf, erp_bdf);
+      /* Root port to RAS node lookups are cached across exercisers and tests */
+      ras_node = ras_index_pcie_node(e_bdf, erp_bdf);
       if (ras_node == NOT_IMPLEMENTED) {
           val_print(ACS_PRINT_ERR, "\n       No RAS compliant node to record PCIe Error", 0);
           val_print(ACS_PRINT_ERR, "\n       Skipping RAS check for BDF  - 0x%x", e_bdf);
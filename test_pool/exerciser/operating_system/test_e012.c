@@ -22,6 +22,8 @@
 #include "val/common/include/acs_pe.h"
 #include "val/common/include/acs_pcie_enumeration.h"
 #include "val/common/include/acs_pcie.h"
+
+#include "../../common/ras_index.h"
 #include "val/sbsa/include/sbsa_acs_ras.h"
 #include "val/sbsa/include/sbsa_acs_exerciser.h"
 
@@ -102,7 +104,8 @@ payload()
           return;
       }
 
-      ras_node = val_exerciser_get_pcie_ras_compliant_err_node(e_bdf, erp_bdf);
+      /* Root port to RAS node lookups are cached across exercisers and tests */
+      ras_node = ras_index_pcie_node(e_bdf, erp_bdf);
       if (ras_node == NOT_IMPLEMENTED) {
           val_print(ACS_PRINT_DEBUG, "\n       No RAS compliant node to record PCIe Error", 0);
           val_print(ACS_PRINT_DEBUG, "\n       Skippping RAS check for BDF  - 0x%x", e_bdf);
@@ -27,12 +27,13 @@
 #include "val/sbsa/include/sbsa_acs_exerciser.h"
 #include "val/sbsa/include/sbsa_acs_smmu.h"
 
+#include "../../common/smmu_ctx.h"
+#include "../../common/route_map.h"
+
 #define TEST_NUM   (ACS_EXERCISER_TEST_NUM_BASE + 13)
 #define TEST_DESC  "Enable and disable STE.DCP bit        "
 #define TEST_RULE  "S_PCIe_10"
 
-#define TEST_DATA_NUM_PAGES  4
-
 static
 void
 payload(void)
@@ -47,30 +48,26 @@ payload(void)
   pgt_descriptor_t pgt_desc;
   smmu_master_attributes_t master;
   uint64_t ttbr;
-  uint64_t *pgt_base_array;
 
   pe_index = val_pe_get_index_mpid(val_pe_get_mpid());
   num_exercisers = val_exerciser_get_info(EXERCISER_NUM_CARDS);
   num_smmus = val_iovirt_get_smmu_info(SMMU_NUM_CTRL, 0);
   test_skip = 1;
 
+  /* Map the buffer shared by the SMMU-backed exerciser tests, so the
+   * translations an earlier test built are reused
+   */
+  if (smmu_ctx_shared_buf() == NULL) {
+    val_print(ACS_PRINT_ERR, "\n       Cacheable mem alloc failure", 0);
+    val_set_status(pe_index, RESULT_FAIL(TEST_NUM, 03));
+    return;
+  }
+
   /* Initialize DMA master and memory descriptors */
   val_memory_set(&master, sizeof(master), 0);
   val_memory_set(mem_desc_array, sizeof(mem_desc_array), 0);
   mem_desc = &mem_desc_array[0];
 
-  /* Allocate an array to store base addresses of page tables allocated for
-   * all exercisers
-   */
-  pgt_base_array = val_aligned_alloc(MEM_ALIGN_4K, sizeof(uint64_t) * num_exercisers);
-  if (!pgt_base_array) {
-      val_print(ACS_PRINT_ERR, "\n       mem alloc failure %x", 03);
-      val_set_status(pe_index, RESULT_FAIL(TEST_NUM, 03));
-      return;
-  }
-
-  val_memory_set(pgt_base_array, sizeof(uint64_t) * num_exercisers, 0);
-
   /* Get translation attributes via TCR and translation table base via TTBR */
   if (val_pe_reg_read_tcr(0 /*for TTBR0*/, &pgt_desc.tcr)) {
     val_print(ACS_PRINT_ERR, "\n       Unable to get translation attributes via TCR", 0);
@@ -101,11 +98,9 @@ payload(void)
     val_print(ACS_PRINT_DEBUG, "\n       Exercise BDF - 0x%x", e_bdf);
 
     /* Get SMMU node index for this exerciser instance */
-    master.smmu_index = val_iovirt_get_rc_smmu_index(PCIE_EXTRACT_BDF_SEG(e_bdf),
-                                                     PCIE_CREATE_BDF_PACKED(e_bdf));
+    master.smmu_index = route_map_smmu_index(e_bdf);
 
-    if (master.smmu_index != ACS_INVALID_INDEX &&
-        val_iovirt_get_smmu_info(SMMU_CTRL_ARCH_MAJOR_REV, master.smmu_index) == 3) {
+    if (route_map_smmu_arch(e_bdf) == 3) {
 
         /* DCP bit is RES0 for SMMUv3, hence check only for SMMU verion greater than 3.0 */
         smmu_minor = VAL_EXTRACT_BITS(val_smmu_read_cfg(SMMUv3_AIDR, master.smmu_index), 0, 3);
@@ -114,13 +109,11 @@ payload(void)
             continue;
         }
 
-        if (val_iovirt_get_device_info(PCIE_CREATE_BDF_PACKED(e_bdf),
-                                       PCIE_EXTRACT_BDF_SEG(e_bdf),
-                                       &device_id, &master.streamid,
-                                       &its_id))
+        if (route_map_device_info(e_bdf, &device_id, &master.streamid, &its_id))
             continue;
 
         test_skip = 0;
+        smmu_ctx_shared_region(instance, mem_desc);
 
         /* Need to know input and output address sizes before creating page table */
         pgt_desc.ias = val_smmu_get_info(SMMU_IN_ADDR_SIZE, master.smmu_index);
@@ -137,20 +130,9 @@ payload(void)
           goto test_fail;
         }
 
-        /* set pgt_desc.pgt_base to NULL to create new translation table, val_pgt_create
-           will update pgt_desc.pgt_base to point to created translation table */
-        pgt_desc.pgt_base = (uint64_t) NULL;
-        if (val_pgt_create(mem_desc, &pgt_desc)) {
-          val_print(ACS_PRINT_ERR,
-                    "\n       Unable to create page table with given attributes", 0);
-          goto test_fail;
-        }
-
-        pgt_base_array[instance] = pgt_desc.pgt_base;
-
-        /* Configure the SMMU tables for this exerciser to use this page table
-           for VA to PA translations */
-        if (val_smmu_map(master, pgt_desc))
+        /* Configure the SMMU tables for this exerciser to use a page table for
+           VA to PA translations, reusing the pooled one if this mapping was built before */
+        if (smmu_ctx_map(&master, mem_desc, &pgt_desc) == NULL)
         {
             val_print(ACS_PRINT_ERR,
                      "\n       SMMU mapping failed (%x)     ", e_bdf);
@@ -189,29 +171,14 @@ test_clean:
   if (test_skip == 1)
       val_set_status(pe_index, RESULT_SKIP(TEST_NUM, 01));
 
-  /* Remove all address mappings for each exerciser */
-  for (instance = 0; instance < num_exercisers; ++instance)
-  {
-    e_bdf = val_exerciser_get_bdf(instance);
-    master.smmu_index = val_iovirt_get_rc_smmu_index(PCIE_EXTRACT_BDF_SEG(e_bdf),
-                                                     PCIE_CREATE_BDF_PACKED(e_bdf));
-    if (val_iovirt_get_device_info(PCIE_CREATE_BDF_PACKED(e_bdf),
-                                   PCIE_EXTRACT_BDF_SEG(e_bdf),
-                                   &device_id, &master.streamid,
-                                   &its_id))
-        continue;
-    val_smmu_unmap(master);
-    if (pgt_base_array[instance] != 0) {
-      pgt_desc.pgt_base = pgt_base_array[instance];
-      val_pgt_destroy(pgt_desc);
-    }
-  }
+  /* Disable the STEs but keep the page tables for the next SMMU-backed
+   * test, the pool is destroyed once the exerciser module ends
+   */
+  smmu_ctx_unmap_all();
 
   /* Disable all SMMUs */
   for (instance = 0; instance < num_smmus; ++instance)
      val_smmu_disable(instance);
-
-  val_memory_free_aligned(pgt_base_array);
 }
 
 
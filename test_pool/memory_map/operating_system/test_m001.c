@@ -21,43 +21,31 @@
 #include "val/common/include/acs_peripherals.h"
 #include "val/sbsa/include/sbsa_acs_memory.h"
 
+#include "../../common/addr_map.h"
+
 #define TEST_NUM (ACS_MEMORY_MAP_TEST_NUM_BASE + 1)
 #define TEST_RULE "S_L3MM_01, S_L3MM_02"
 #define TEST_DESC "Check peripherals addr 64Kb apart     "
 
+static ADDR_MAP peri_map;
+
 static void payload(void)
 {
     uint32_t pe_index;
-    uint32_t peri_index, peri_index1;
-    uint64_t peri_count, addr_diff;
-    uint64_t peri_addr1, peri_addr2;
+    uint64_t peri_count;
     uint32_t fail_cnt = 0;
 
     pe_index = val_pe_get_index_mpid(val_pe_get_mpid());
     peri_count = val_peripheral_get_info(NUM_ALL, 0);
 
+    val_print(ACS_PRINT_INFO, "\n   Number of peripherals %d", peri_count);
+    addr_map_init(&peri_map);
+    addr_map_add_peripherals(&peri_map, NUM_ALL, ANY_BASE0, ADDR_OWNER_PERIPHERAL);
+
     /* check whether all peripheral base addresses are 64KB apart from each other */
-    for (peri_index = 0 ; peri_index < peri_count; peri_index++) {
-        for (peri_index1 = peri_index + 1; peri_index1 < peri_count; peri_index1++) {
-
-            peri_addr1 = val_peripheral_get_info(ANY_BASE0, peri_index);
-            peri_addr2 = val_peripheral_get_info(ANY_BASE0, peri_index1);
-            val_print(ACS_PRINT_INFO, "\n   addr of Peripheral 1 is  %llx", peri_addr1);
-            val_print(ACS_PRINT_INFO, "\n   addr of Peripheral 2 is  %llx", peri_addr2);
-
-           if ((peri_addr1 == 0) || (peri_addr2 == 0))
-                continue;
-
-            addr_diff = (peri_addr1 > peri_addr2) ?
-                         peri_addr1 - peri_addr2 : peri_addr2 - peri_addr1;
-
-            if (addr_diff < MEM_SIZE_64KB) {
-                val_print(ACS_PRINT_ERR,
-                         "\n  Peripheral base addresses isn't atleast 64Kb apart %llx", addr_diff);
-                fail_cnt++;
-            }
-        }
-    }
+    fail_cnt = addr_map_check(&peri_map, MEM_SIZE_64KB, ADDR_OWNER_ALL);
+    if (fail_cnt)
+        val_print(ACS_PRINT_ERR, "\n  Peripheral base addresses isn't atleast 64Kb apart", 0);
 
     if (fail_cnt)
     {
@@ -65,6 +53,15 @@ static void payload(void)
         return;
     }
 
+    /* Peripherals past the end of the map were never checked */
+    if (peri_map.dropped)
+    {
+        val_print(ACS_PRINT_ERR, "\n  Address map full, %d peripherals not checked",
+                  peri_map.dropped);
+        val_set_status(pe_index, RESULT_SKIP(TEST_NUM, 01));
+        return;
+    }
+
     val_set_status(pe_index, RESULT_PASS(TEST_NUM, 01));
 }
 
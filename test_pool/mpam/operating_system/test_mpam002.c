@@ -22,6 +22,8 @@
 #include "val/sbsa/include/sbsa_acs_pe.h"
 #include "val/sbsa/include/sbsa_acs_mpam.h"
 
+#include "../../common/mpam_index.h"
+
 
 #define TEST_NUM   (ACS_MPAM_TEST_NUM_BASE + 2)
 #define TEST_RULE  "S_L7MP_03, S_L7MP_04"
@@ -33,8 +35,8 @@ static void payload(void)
     uint64_t cache_identifier;
     uint32_t msc_node_cnt;
     uint32_t rsrc_node_cnt;
-    uint32_t msc_index, rsrc_index;
-    uint32_t csumon_count;
+    uint32_t rsrc_num;
+    MPAM_RSRC *rsrc;
     uint32_t test_fail = 0;
     uint32_t test_run = 0;
     uint32_t index = val_pe_get_index_mpid(val_pe_get_mpid());
@@ -68,8 +70,7 @@ static void payload(void)
 
 
     /* Check in the MPAM table which MSC is attached to the LLC */
-
-    msc_node_cnt = val_mpam_get_msc_count();
+    msc_node_cnt = mpam_index_num_msc();
     val_print(ACS_PRINT_DEBUG, "\n       MSC count = %d", msc_node_cnt);
 
     if (msc_node_cnt == 0) {
@@ -77,37 +78,32 @@ static void payload(void)
         return;
     }
 
-    /* visit each MSC node and check for cache resources */
-    for (msc_index = 0; msc_index < msc_node_cnt; msc_index++) {
-        rsrc_node_cnt = val_mpam_get_info(MPAM_MSC_RSRC_COUNT, msc_index, 0);
-
-        val_print(ACS_PRINT_DEBUG, "\n       msc index  = %d", msc_index);
-        val_print(ACS_PRINT_DEBUG, "\n       Resource count %d = ", rsrc_node_cnt);
-
-        for (rsrc_index = 0; rsrc_index < rsrc_node_cnt; rsrc_index++) {
-
-            /* check whether the resource location is cache */
-            if (val_mpam_get_info(MPAM_MSC_RSRC_TYPE, msc_index, rsrc_index) ==
-                                                                       MPAM_RSRC_TYPE_PE_CACHE) {
-                if (val_mpam_get_info(MPAM_MSC_RSRC_DESC1, msc_index, rsrc_index) ==
-                                                                               cache_identifier) {
-                    /* We have MSC which controls/monitors the LLC cache */
-                    val_print(ACS_PRINT_DEBUG, "\n       rsrc index  = %d", rsrc_index);
-
-                    test_run = 1;
-                    /* Check CSU monitor are present */
-                    if (!val_mpam_supports_csumon(msc_index)) {
-                        val_print(ACS_PRINT_ERR, "\n       CSU MON unsupported by LLC", 0);
-                        test_fail = 1;
-                    }
-                    /* Check min 16 CSU monitor are present */
-                    csumon_count = val_mpam_get_csumon_count(msc_index);
-                    if (csumon_count < 16) {
-                        val_print(ACS_PRINT_ERR, "\n       CSU MON %d less than 16", csumon_count);
-                        test_fail = 1;
-                    }
-                }
-            }
+    /* Resource nodes past the end of the index would never be checked */
+    if (mpam_index_dropped()) {
+        val_print(ACS_PRINT_ERR, "\n       MPAM index full, %d nodes not checked",
+                  mpam_index_dropped());
+        val_set_status(index, RESULT_SKIP(TEST_NUM, 03));
+        return;
+    }
+
+    /* visit each cache resource node of the LLC */
+    rsrc_node_cnt = mpam_index_find(MPAM_RSRC_TYPE_PE_CACHE, cache_identifier, &rsrc);
+    for (rsrc_num = 0; rsrc_num < rsrc_node_cnt; rsrc_num++, rsrc++) {
+        /* We have MSC which controls/monitors the LLC cache */
+        val_print(ACS_PRINT_DEBUG, "\n       msc index  = %d", rsrc->msc_index);
+        val_print(ACS_PRINT_DEBUG, "\n       rsrc index  = %d", rsrc->rsrc_index);
+        test_run = 1;
+
+        /* Check CSU monitor are present */
+        if (!rsrc->csumon) {
+            val_print(ACS_PRINT_ERR, "\n       CSU MON unsupported by LLC", 0);
+            test_fail = 1;
+        }
+
+        /* Check min 16 CSU monitor are present */
+        if (rsrc->csumon_count < 16) {
+            val_print(ACS_PRINT_ERR, "\n       CSU MON %d less than 16", rsrc->csumon_count);
+            test_fail = 1;
         }
     }
 
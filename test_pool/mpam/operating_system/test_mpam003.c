@@ -23,6 +23,10 @@
 #include "val/sbsa/include/sbsa_acs_pe.h"
 #include "val/sbsa/include/sbsa_acs_mpam.h"
 
+#include "../../common/mpam_index.h"
+#include "../../common/mbw_bench.h"
+#include "../../common/traffic_gen.h"
+
 
 #define TEST_NUM   (ACS_MPAM_TEST_NUM_BASE + 3)
 #define TEST_RULE  "S_L7MP_05"
@@ -30,11 +34,28 @@
 
 #define BUFFER_SIZE 65536 /* 64 Kilobytes*/
 
+/* Counter callback for the linearity sweep, ctx is the MSC index */
+static uint64_t mbwu_counter(void *ctx, uint32_t op)
+{
+    uint32_t msc_index = *(uint32_t *)ctx;
+
+    if (op == TGEN_COUNTER_READ)
+        return val_mpam_memory_mbwumon_read_count(msc_index);
+
+    val_mpam_memory_mbwumon_disable(msc_index);
+    val_mpam_memory_mbwumon_reset(msc_index);
+    val_mpam_memory_mbwumon_enable(msc_index);
+    return 0;
+}
+
 static void payload(void)
 {
     uint32_t pe_index;
     uint32_t msc_node_cnt, msc_index;
     uint32_t rsrc_node_cnt, rsrc_index;
+    uint32_t rsrc_num;
+    MPAM_RSRC *mem_rsrc;
+    MPAM_RSRC *rsrc;
     uint64_t mpam2_el2, mpam2_el2_temp;
     uint64_t byte_count;
     uint64_t byte_count_min;
@@ -44,6 +65,7 @@ static void payload(void)
     uint32_t test_skip = 1;
     void *src_buf = 0;
     void *dest_buf = 0;
+    TGEN_CFG traffic = {TGEN_OP_COPY, TGEN_PATTERN_SEQ, 0, 0, 1, 0, 0, BUFFER_SIZE, 0};
 
     pe_index = val_pe_get_index_mpid(val_pe_get_mpid());
 
@@ -61,7 +83,7 @@ static void payload(void)
 
 
     /* get total number of MSCs reported by MPAM ACPI table */
-    msc_node_cnt = val_mpam_get_msc_count();
+    msc_node_cnt = mpam_index_num_msc();
     val_print(ACS_PRINT_DEBUG, "\n       MSC count = %d", msc_node_cnt);
 
     if (!msc_node_cnt) {
@@ -69,6 +91,18 @@ static void payload(void)
         return;
     }
 
+    /* Resource nodes past the end of the index would never be checked */
+    if (mpam_index_dropped()) {
+        val_print(ACS_PRINT_ERR, "\n       MPAM index full, %d nodes not checked",
+                  mpam_index_dropped());
+        val_set_status(pe_index, RESULT_SKIP(TEST_NUM, 05));
+        return;
+    }
+
+    /* Bandwidth achieved per PARTID against the MBW_MAX/MBW_MIN portions */
+    if (g_sbsa_perf_mode)
+        mbw_bench_run(TEST_NUM);
+
     /* read MPAM2_EL2 and store the value for restoring later */
     mpam2_el2 = val_mpam_reg_read(MPAM2_EL2);
     mpam2_el2_temp = mpam2_el2;
@@ -82,103 +116,107 @@ static void payload(void)
     val_print(ACS_PRINT_DEBUG, "\n       Value written to MPAM2_EL2 = 0x%llx", mpam2_el2);
     val_mpam_reg_write(MPAM2_EL2, mpam2_el2);
 
-    /* visit each MSC node and check for memory resources */
-    for (msc_index = 0; msc_index < msc_node_cnt; msc_index++) {
-        rsrc_node_cnt = val_mpam_get_info(MPAM_MSC_RSRC_COUNT, msc_index, 0);
+    /* visit each memory resource node */
+    rsrc_node_cnt = mpam_index_type(MPAM_RSRC_TYPE_MEMORY, &mem_rsrc);
+    val_print(ACS_PRINT_DEBUG, "\n       Memory resource count = %d", rsrc_node_cnt);
 
-        val_print(ACS_PRINT_DEBUG, "\n       msc index  = %d", msc_index);
-        val_print(ACS_PRINT_DEBUG, "\n       Resource count %d = ", rsrc_node_cnt);
-
-        for (rsrc_index = 0; rsrc_index < rsrc_node_cnt; rsrc_index++) {
+    for (rsrc_num = 0; rsrc_num < rsrc_node_cnt; rsrc_num++) {
+        rsrc = &mem_rsrc[rsrc_num];
+        msc_index  = rsrc->msc_index;
+        rsrc_index = rsrc->rsrc_index;
 
-            /* check whether the resource location is memory */
-            if (val_mpam_get_info(MPAM_MSC_RSRC_TYPE, msc_index, rsrc_index) ==
-                                                                         MPAM_RSRC_TYPE_MEMORY) {
+        val_print(ACS_PRINT_DEBUG, "\n       msc index  = %d", msc_index);
 
-                /* As per S_L7MP_05, MBWU monitoring must be supported for general purpose mem */
-                if (!val_mpam_msc_supports_mbwumon(msc_index)) {
-                    val_print(ACS_PRINT_ERR, "\n       MBWU MON unsupported by MSC %d", msc_index);
-                    test_fails++;
-                    break;
-                }
+        /* As per S_L7MP_05, MBWU monitoring must be supported for general purpose mem */
+        if (!rsrc->mbwumon) {
+            val_print(ACS_PRINT_ERR, "\n       MBWU MON unsupported by MSC %d", msc_index);
+            test_fails++;
+            continue;
+        }
 
-                test_skip = 0;
-                /* select resource instance if RIS feature implemented */
-                if (val_mpam_msc_supports_ris(msc_index))
-                    val_mpam_memory_configure_ris_sel(msc_index, rsrc_index);
+        test_skip = 0;
+        /* select resource instance if RIS feature implemented */
+        if (rsrc->ris)
+            val_mpam_memory_configure_ris_sel(msc_index, rsrc_index);
 
-                val_print(ACS_PRINT_DEBUG, "\n       rsrc index = %d", rsrc_index);
+        val_print(ACS_PRINT_DEBUG, "\n       rsrc index = %d", rsrc_index);
 
-                /* Allocate source and destination memory buffers*/
-                addr_base = val_mpam_memory_get_base(msc_index, rsrc_index);
-                addr_len  = val_mpam_memory_get_size(msc_index, rsrc_index);
+        /* Allocate source and destination memory buffers*/
+        addr_base = val_mpam_memory_get_base(msc_index, rsrc_index);
+        addr_len  = val_mpam_memory_get_size(msc_index, rsrc_index);
 
-                if ((addr_base == SRAT_INVALID_INFO) || (addr_len == SRAT_INVALID_INFO) ||
-                    (addr_len <= 2 * BUFFER_SIZE)) { /* src and dst buffer size */
-                    val_print(ACS_PRINT_ERR, "\n       No SRAT mem range info found", 0);
-                    val_set_status(pe_index, RESULT_FAIL(TEST_NUM, 01));
+        if ((addr_base == SRAT_INVALID_INFO) || (addr_len == SRAT_INVALID_INFO) ||
+            (addr_len <= 2 * BUFFER_SIZE)) { /* src and dst buffer size */
+            val_print(ACS_PRINT_ERR, "\n       No SRAT mem range info found", 0);
+            val_set_status(pe_index, RESULT_FAIL(TEST_NUM, 01));
 
-                    /* Restore MPAM2_EL2 settings */
-                    val_mpam_reg_write(MPAM2_EL2, mpam2_el2_temp);
-                    return;
-                }
+            /* Restore MPAM2_EL2 settings */
+            val_mpam_reg_write(MPAM2_EL2, mpam2_el2_temp);
+            return;
+        }
 
 
-                src_buf = (void *)val_mem_alloc_at_address(addr_base, BUFFER_SIZE);
-                dest_buf = (void *)val_mem_alloc_at_address(addr_base + BUFFER_SIZE, BUFFER_SIZE);
+        src_buf = (void *)val_mem_alloc_at_address(addr_base, BUFFER_SIZE);
+        dest_buf = (void *)val_mem_alloc_at_address(addr_base + BUFFER_SIZE, BUFFER_SIZE);
 
-                if ((src_buf == NULL) || (dest_buf == NULL)) {
-                    val_print(ACS_PRINT_ERR, "\n       Memory allocation of buffers failed", 0);
-                    val_set_status(pe_index, RESULT_FAIL(TEST_NUM, 02));
+        if ((src_buf == NULL) || (dest_buf == NULL)) {
+            val_print(ACS_PRINT_ERR, "\n       Memory allocation of buffers failed", 0);
+            val_set_status(pe_index, RESULT_FAIL(TEST_NUM, 02));
 
-                    /* Restore MPAM2_EL2 settings */
-                    val_mpam_reg_write(MPAM2_EL2, mpam2_el2_temp);
-                    return;
-                }
+            /* Restore MPAM2_EL2 settings */
+            val_mpam_reg_write(MPAM2_EL2, mpam2_el2_temp);
+            return;
+        }
 
-                /* configure MBWU Monitor for this memory resource node */
-                val_mpam_memory_configure_mbwumon(msc_index);
+        /* configure MBWU Monitor for this memory resource node */
+        val_mpam_memory_configure_mbwumon(msc_index);
 
-                /* enable MBWU monitoring */
-                val_mpam_memory_mbwumon_enable(msc_index);
+        /* enable MBWU monitoring */
+        val_mpam_memory_mbwumon_enable(msc_index);
 
 
-                /* wait for MAX_NRDY_USEC after msc config change */
-                nrdy_timeout = val_mpam_get_info(MPAM_MSC_NRDY, msc_index, 0);
-                while (nrdy_timeout) {
-                    --nrdy_timeout;
-                };
+        /* wait for MAX_NRDY_USEC after msc config change */
+        nrdy_timeout = rsrc->nrdy;
+        while (nrdy_timeout) {
+            --nrdy_timeout;
+        };
 
-                /* perform memory operation */
-                val_memcpy(src_buf, dest_buf, BUFFER_SIZE);
+        /* perform memory operation */
+        traffic.src = (uint64_t)src_buf;
+        traffic.dst = (uint64_t)dest_buf;
+        tgen_run(&traffic);
 
-                /* read the memory bandwidth usage monitor */
-                byte_count = val_mpam_memory_mbwumon_read_count(msc_index);
+        /* read the memory bandwidth usage monitor */
+        byte_count = val_mpam_memory_mbwumon_read_count(msc_index);
 
-                /* disable and reset the MBWU monitor */
-                val_mpam_memory_mbwumon_disable(msc_index);
-                val_mpam_memory_mbwumon_reset(msc_index);
+        /* disable and reset the MBWU monitor */
+        val_mpam_memory_mbwumon_disable(msc_index);
+        val_mpam_memory_mbwumon_reset(msc_index);
 
-                val_print(ACS_PRINT_DEBUG, "\n       byte_count = 0x%llx bytes", byte_count);
+        val_print(ACS_PRINT_DEBUG, "\n       byte_count = 0x%llx bytes", byte_count);
 
-                /* the monitor must count both read and write bandwidth,
-                   hence count must be twice of the buffer size
-                   with 30% room for implementation differences */
-                byte_count_min = 2 * BUFFER_SIZE - ((2 * BUFFER_SIZE * 3) / 10);
+        /* the monitor must count both read and write bandwidth,
+           hence count must be twice of the buffer size
+           with 30% room for implementation differences */
+        byte_count_min = 2 * BUFFER_SIZE - ((2 * BUFFER_SIZE * 3) / 10);
 
-                /* Report fail if the monitor count does not belong within permitted range */
-                if (!((byte_count > byte_count_min) && (byte_count <= 2 * BUFFER_SIZE))) {
-                    val_print(ACS_PRINT_ERR, "\n       Monitor count incorrect for MSC %d",
-                                                                                       msc_index);
-                    val_print(ACS_PRINT_ERR, "       rsrc node %d", rsrc_index);
-                    test_fails++;
-                }
+        /* Report fail if the monitor count does not belong within permitted range */
+        if (!((byte_count > byte_count_min) && (byte_count <= 2 * BUFFER_SIZE))) {
+            val_print(ACS_PRINT_ERR, "\n       Monitor count incorrect for MSC %d",
+                                                                               msc_index);
+            val_print(ACS_PRINT_ERR, "       rsrc node %d", rsrc_index);
+            test_fails++;
+        }
 
-                /* free the buffers */
-                val_mem_free_at_address((uint64_t)src_buf, BUFFER_SIZE);
-                val_mem_free_at_address((uint64_t)dest_buf, BUFFER_SIZE);
-            }
+        /* Check the monitor scales with the traffic, not just at one point */
+        if (g_sbsa_perf_mode) {
+            tgen_linearity(&traffic, mbwu_counter, &msc_index, "MBWU monitor");
+            val_mpam_memory_mbwumon_disable(msc_index);
         }
+
+        /* free the buffers */
+        val_mem_free_at_address((uint64_t)src_buf, BUFFER_SIZE);
+        val_mem_free_at_address((uint64_t)dest_buf, BUFFER_SIZE);
     }
     /* Restore MPAM2_EL2 settings */
     val_mpam_reg_write(MPAM2_EL2, mpam2_el2_temp);
@@ -22,22 +22,22 @@
 #include "val/sbsa/include/sbsa_acs_mpam.h"
 #include "val/common/include/acs_peripherals.h"
 
+#include "../../common/addr_map.h"
+
 #define TEST_NUM   (ACS_MPAM_TEST_NUM_BASE + 5)
 #define TEST_RULE  "S_L7MP_08"
 #define TEST_DESC  "Check for MPAM MSC address overlap    "
 
+static ADDR_MAP msc_map;
+
 static void payload(void)
 {
     uint32_t msc_node_cnt;
     uint32_t msc_index;
-    uint32_t msc_index1;
     uint64_t msc_addr;
     uint32_t msc_len;
-    uint64_t msc_addr1;
     uint32_t test_fails = 0;
     uint32_t index = val_pe_get_index_mpid(val_pe_get_mpid());
-    uint64_t peri_count;
-    uint64_t peripheral_base;
 
    if (g_sbsa_level < 7) {
         val_set_status(index, RESULT_SKIP(TEST_NUM, 01));
@@ -52,64 +52,31 @@ static void payload(void)
         return;
     }
 
-    /* Check MSC memory node size are not overlapping with other MSC */
+    addr_map_init(&msc_map);
+
     for (msc_index = 0; msc_index < msc_node_cnt; msc_index++) {
         msc_addr = val_mpam_get_info(MPAM_MSC_BASE_ADDR, msc_index, 0);
         msc_len = val_mpam_get_info(MPAM_MSC_ADDR_LEN, msc_index, 0);
-
-        for (msc_index1 = msc_index + 1; msc_index1 < msc_node_cnt; msc_index1++) {
-            msc_addr1 = val_mpam_get_info(MPAM_MSC_BASE_ADDR, msc_index1, 0);
-
-            if (msc_addr1 >= msc_addr && msc_addr1 <= (msc_addr + msc_len)) {
-                val_print(ACS_PRINT_ERR, "\n       MSC %d and", msc_index);
-                val_print(ACS_PRINT_ERR, " %d memory layout overlapping", msc_index1);
-                test_fails++;
-            }
-        }
-
-        /* Check with peripherals - USB */
-        peri_count = val_peripheral_get_info(NUM_USB, 0);
-        while (peri_count) {
-            --peri_count;  //array index starts from 0, so subtract 1 from count
-            val_print(ACS_PRINT_DEBUG, "\n       USB index %d", peri_count);
-            peripheral_base = val_peripheral_get_info(USB_BASE0, peri_count);
-            if (peripheral_base >= msc_addr && peripheral_base <= (msc_addr + msc_len)) {
-                val_print(ACS_PRINT_ERR, "\n       MSC %d and", msc_index);
-                val_print(ACS_PRINT_ERR, " USB %d memory layout overlapping", peri_count);
-                test_fails++;
-            }
-        }
-
-
-        /* Check with peripherals - UART */
-        peri_count = val_peripheral_get_info(NUM_UART, 0);
-        while (peri_count) {
-            --peri_count;  //array index starts from 0, so subtract 1 from count
-            val_print(ACS_PRINT_DEBUG, "\n       UART index %d", peri_count);
-            peripheral_base = val_peripheral_get_info(UART_BASE0, peri_count);
-            if (peripheral_base >= msc_addr && peripheral_base <= (msc_addr + msc_len)) {
-                val_print(ACS_PRINT_ERR, "\n       MSC %d and", msc_index);
-                val_print(ACS_PRINT_ERR, " UART %d memory layout overlapping", peri_count);
-                test_fails++;
-            }
-        }
-
-        /* Check with peripherals - SATA */
-        peri_count = val_peripheral_get_info(NUM_SATA, 0);
-        while (peri_count) {
-            --peri_count;  //array index starts from 0, so subtract 1 from count
-            val_print(ACS_PRINT_DEBUG, "\n       SATA index %d", peri_count);
-            peripheral_base = val_peripheral_get_info(SATA_BASE0, peri_count);
-            if (peripheral_base >= msc_addr && peripheral_base <= (msc_addr + msc_len)) {
-                val_print(ACS_PRINT_ERR, "\n       MSC %d and", msc_index);
-                val_print(ACS_PRINT_ERR, " SATA %d memory layout overlapping", peri_count);
-                test_fails++;
-            }
-        }
+        addr_map_add(&msc_map, msc_addr, msc_len, ADDR_OWNER_MSC, msc_index);
     }
 
+    /* Check with peripherals - USB, UART and SATA */
+    addr_map_add_peripherals(&msc_map, NUM_USB, USB_BASE0, ADDR_OWNER_USB);
+    addr_map_add_peripherals(&msc_map, NUM_UART, UART_BASE0, ADDR_OWNER_UART);
+    addr_map_add_peripherals(&msc_map, NUM_SATA, SATA_BASE0, ADDR_OWNER_SATA);
+
+    /* Check MSC memory node size are not overlapping with other MSC or peripherals.
+       The MSC range includes base + len, hence a minimum gap of 1 byte. */
+    test_fails = addr_map_check(&msc_map, 1, ADDR_OWNER_BIT(ADDR_OWNER_MSC));
+
+    /* Ranges past the end of the map were never checked */
     if (test_fails)
         val_set_status(index, RESULT_FAIL(TEST_NUM, 02));
+    else if (msc_map.dropped) {
+        val_print(ACS_PRINT_ERR, "\n       Address map full, %d ranges not checked",
+                  msc_map.dropped);
+        val_set_status(index, RESULT_SKIP(TEST_NUM, 02));
+    }
     else
         val_set_status(index, RESULT_PASS(TEST_NUM, 01));
 }
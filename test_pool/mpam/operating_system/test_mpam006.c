@@ -23,6 +23,10 @@
 #include "val/sbsa/include/sbsa_acs_mpam.h"
 #include "val/sbsa/include/sbsa_acs_memory.h"
 
+#include "../../common/mpam_index.h"
+#include "../../common/cpor_bench.h"
+#include "../../common/traffic_gen.h"
+
 #define TEST_NUM   (ACS_MPAM_TEST_NUM_BASE + 6)
 #define TEST_RULE  "S_L7MP_03"
 #define TEST_DESC  "Check PMG storage by CPOR nodes       "
@@ -37,7 +41,9 @@ static void payload(void)
     uint32_t msc_node_cnt;
     uint32_t rsrc_node_cnt;
     uint32_t msc_index;
-    uint32_t rsrc_index;
+    uint32_t rsrc_num;
+    MPAM_RSRC *llc_rsrc;
+    MPAM_RSRC *rsrc;
     uint32_t llc_index;
     uint64_t cache_identifier;
     uint32_t cache_size;
@@ -49,6 +55,7 @@ static void payload(void)
     uint8_t pmg2;
     void *src_buf = 0;
     void *dest_buf = 0;
+    TGEN_CFG traffic = {TGEN_OP_COPY, TGEN_PATTERN_SEQ, 0, 0, 1, 0, 0, 0, 0};
     uint64_t buf_size;
     uint64_t mpam2_el2 = 0;
     uint64_t nrdy_timeout;
@@ -68,6 +75,10 @@ static void payload(void)
             return;
     }
 
+    /* Victim latency and LLC occupancy beside a noisy neighbour, with and without CPOR */
+    if (g_sbsa_perf_mode)
+        cpor_bench_run(TEST_NUM);
+
    /* Get the Index for LLC */
     llc_index = val_cache_get_llc_index();
     if (llc_index == CACHE_TABLE_EMPTY) {
@@ -85,7 +96,7 @@ static void payload(void)
     }
 
     /* Get total number of MSCs reported by MPAM ACPI table */
-    msc_node_cnt = val_mpam_get_msc_count();
+    msc_node_cnt = mpam_index_num_msc();
     val_print(ACS_PRINT_DEBUG, "\n       MSC count = %d", msc_node_cnt);
 
     if (msc_node_cnt == 0) {
@@ -93,27 +104,28 @@ static void payload(void)
         return;
     }
 
+    /* Resource nodes past the end of the index would never be checked */
+    if (mpam_index_dropped()) {
+        val_print(ACS_PRINT_ERR, "\n       MPAM index full, %d nodes not checked",
+                  mpam_index_dropped());
+        val_set_status(index, RESULT_SKIP(TEST_NUM, 04));
+        return;
+    }
+
     /* Get MPAM related information for LLC */
-    for (msc_index = 0; msc_index < msc_node_cnt; msc_index++) {
-        rsrc_node_cnt = val_mpam_get_info(MPAM_MSC_RSRC_COUNT, msc_index, 0);
-        for (rsrc_index = 0; rsrc_index < rsrc_node_cnt; rsrc_index++) {
-            if (val_mpam_get_info(MPAM_MSC_RSRC_TYPE, msc_index, rsrc_index) ==
-                                                                MPAM_RSRC_TYPE_PE_CACHE) {
-                if (val_mpam_get_info(MPAM_MSC_RSRC_DESC1, msc_index, rsrc_index) ==
-                                                                               cache_identifier) {
-                    if (val_mpam_supports_cpor(msc_index)) {
-                        cache_size = val_cache_get_info(CACHE_SIZE, llc_index);
-
-                        max_pmg = val_mpam_get_max_pmg(msc_index);
-
-                        if (val_mpam_supports_csumon(msc_index))
-                            csumon_count = val_mpam_get_csumon_count(msc_index);
-                        cpor_nodes++;
-                    }
-                    max_partid = val_mpam_get_max_partid(msc_index);
-                }
-            }
+    rsrc_node_cnt = mpam_index_find(MPAM_RSRC_TYPE_PE_CACHE, cache_identifier, &llc_rsrc);
+    for (rsrc_num = 0; rsrc_num < rsrc_node_cnt; rsrc_num++) {
+        rsrc = &llc_rsrc[rsrc_num];
+        if (rsrc->cpor) {
+            cache_size = val_cache_get_info(CACHE_SIZE, llc_index);
+
+            max_pmg = rsrc->max_pmg;
+
+            if (rsrc->csumon)
+                csumon_count = rsrc->csumon_count;
+            cpor_nodes++;
         }
+        max_partid = rsrc->max_partid;
     }
 
     val_print(ACS_PRINT_DEBUG, "\n       CPOR Nodes = %d", cpor_nodes);
@@ -131,22 +143,15 @@ static void payload(void)
     }
 
     /* Configure CPOR settings for nodes supporting CPOR */
-    for (msc_index = 0; msc_index < msc_node_cnt; msc_index++) {
-        rsrc_node_cnt = val_mpam_get_info(MPAM_MSC_RSRC_COUNT, msc_index, 0);
-        for (rsrc_index = 0; rsrc_index < rsrc_node_cnt; rsrc_index++) {
-            if (val_mpam_get_info(MPAM_MSC_RSRC_TYPE, msc_index, rsrc_index) ==
-                                                                MPAM_RSRC_TYPE_PE_CACHE) {
-                if (val_mpam_get_info(MPAM_MSC_RSRC_DESC1, msc_index, rsrc_index) ==
-                                                                               cache_identifier) {
-                    /* Select resource instance if RIS feature implemented */
-                    if (val_mpam_msc_supports_ris(msc_index))
-                        val_mpam_memory_configure_ris_sel(msc_index, rsrc_index);
-
-                    if (val_mpam_supports_cpor(msc_index))
-                        val_mpam_configure_cpor(msc_index, max_partid, PARTITION_PERCENTAGE);
-                }
-            }
-        }
+    for (rsrc_num = 0; rsrc_num < rsrc_node_cnt; rsrc_num++) {
+        rsrc = &llc_rsrc[rsrc_num];
+
+        /* Select resource instance if RIS feature implemented */
+        if (rsrc->ris)
+            val_mpam_memory_configure_ris_sel(rsrc->msc_index, rsrc->rsrc_index);
+
+        if (rsrc->cpor)
+            val_mpam_configure_cpor(rsrc->msc_index, max_partid, PARTITION_PERCENTAGE);
     }
 
     /* Create two PMG groups for PE traffic */
@@ -156,130 +161,122 @@ static void payload(void)
     mpam2_el2 = val_mpam_reg_read(MPAM2_EL2);
     mpam2_el2_temp = mpam2_el2;
 
-     /* visit each MSC node and check for Cache resources */
-    for (msc_index = 0; msc_index < msc_node_cnt; msc_index++) {
-        rsrc_node_cnt = val_mpam_get_info(MPAM_MSC_RSRC_COUNT, msc_index, 0);
+    /* visit each cache resource node of the LLC */
+    for (rsrc_num = 0; rsrc_num < rsrc_node_cnt; rsrc_num++) {
+        rsrc = &llc_rsrc[rsrc_num];
+        msc_index = rsrc->msc_index;
 
         val_print(ACS_PRINT_DEBUG, "\n       msc index  = %d", msc_index);
-        val_print(ACS_PRINT_DEBUG, "\n       Resource count %d = ", rsrc_node_cnt);
-
-        for (rsrc_index = 0; rsrc_index < rsrc_node_cnt; rsrc_index++) {
-
-            /* Check whether resource node is a PE Cache */
-            if (val_mpam_get_info(MPAM_MSC_RSRC_TYPE, msc_index, rsrc_index) ==
-                                                          MPAM_RSRC_TYPE_PE_CACHE) {
+        val_print(ACS_PRINT_DEBUG, "\n       rsrc index = %d", rsrc->rsrc_index);
 
-                /*Check if the PE Cache ID matches LLC ID */
-                if (val_mpam_get_info(MPAM_MSC_RSRC_DESC1, msc_index, rsrc_index) ==
-                                                                               cache_identifier) {
+        buf_size = cache_size * CACHE_PERCENTAGE / 100 ;
 
-                    buf_size = cache_size * CACHE_PERCENTAGE / 100 ;
+        /*Allocate memory for source and destination buffers */
+        src_buf = (void *)val_aligned_alloc(MEM_ALIGN_4K, buf_size);
+        dest_buf = (void *)val_aligned_alloc(MEM_ALIGN_4K, buf_size);
 
-                    /*Allocate memory for source and destination buffers */
-                    src_buf = (void *)val_aligned_alloc(MEM_ALIGN_4K, buf_size);
-                    dest_buf = (void *)val_aligned_alloc(MEM_ALIGN_4K, buf_size);
+        val_print(ACS_PRINT_DEBUG, "\n       buf_size            = 0x%x", buf_size);
 
-                    val_print(ACS_PRINT_DEBUG, "\n       buf_size            = 0x%x", buf_size);
+        if ((src_buf == NULL) || (dest_buf == NULL)) {
+            val_print(ACS_PRINT_ERR, "\n       Mem allocation failed", 0);
+            val_set_status(index, RESULT_FAIL(TEST_NUM, 04));
+        }
 
-                    if ((src_buf == NULL) || (dest_buf == NULL)) {
-                        val_print(ACS_PRINT_ERR, "\n       Mem allocation failed", 0);
-                        val_set_status(index, RESULT_FAIL(TEST_NUM, 04));
-                    }
+        traffic.src  = (uint64_t)src_buf;
+        traffic.dst  = (uint64_t)dest_buf;
+        traffic.size = buf_size;
 
-                    /* Clear the PARTID_D & PMG_D bits in mpam2_el2 before writing to them */
-                    mpam2_el2 = CLEAR_BITS_M_TO_N(mpam2_el2, MPAMn_ELx_PARTID_D_SHIFT+15,
-                                                             MPAMn_ELx_PARTID_D_SHIFT);
-                    mpam2_el2 = CLEAR_BITS_M_TO_N(mpam2_el2, MPAMn_ELx_PMG_D_SHIFT+7,
-                                                             MPAMn_ELx_PMG_D_SHIFT);
+        /* Clear the PARTID_D & PMG_D bits in mpam2_el2 before writing to them */
+        mpam2_el2 = CLEAR_BITS_M_TO_N(mpam2_el2, MPAMn_ELx_PARTID_D_SHIFT+15,
+                                                 MPAMn_ELx_PARTID_D_SHIFT);
+        mpam2_el2 = CLEAR_BITS_M_TO_N(mpam2_el2, MPAMn_ELx_PMG_D_SHIFT+7,
+                                                 MPAMn_ELx_PMG_D_SHIFT);
 
-                    /* Write MAX_PARTID & PMG2 to MPAM2_EL2 and generate PE traffic */
-                    mpam2_el2 |= (((uint64_t)pmg2 << MPAMn_ELx_PMG_D_SHIFT) |
-                                  ((uint64_t)max_partid << MPAMn_ELx_PARTID_D_SHIFT));
+        /* Write MAX_PARTID & PMG2 to MPAM2_EL2 and generate PE traffic */
+        mpam2_el2 |= (((uint64_t)pmg2 << MPAMn_ELx_PMG_D_SHIFT) |
+                      ((uint64_t)max_partid << MPAMn_ELx_PARTID_D_SHIFT));
 
-                    val_mpam_reg_write(MPAM2_EL2, mpam2_el2);
+        val_mpam_reg_write(MPAM2_EL2, mpam2_el2);
 
-                    /* Configure CSU monitors with PMG1 */
-                    if (val_mpam_supports_cpor(msc_index) && val_mpam_supports_csumon(msc_index))
-                        val_mpam_configure_csu_mon(msc_index, max_partid, pmg1, 0);
+        /* Configure CSU monitors with PMG1 */
+        if (rsrc->cpor && rsrc->csumon)
+            val_mpam_configure_csu_mon(msc_index, max_partid, pmg1, 0);
 
-                    /* Enable CSU monitoring */
-                    val_mpam_csumon_enable(msc_index);
+        /* Enable CSU monitoring */
+        val_mpam_csumon_enable(msc_index);
 
-                    /* wait for MAX_NRDY_USEC after msc config change */
-                    nrdy_timeout = val_mpam_get_info(MPAM_MSC_NRDY, msc_index, 0);
-                    while (nrdy_timeout) {
-                        --nrdy_timeout;
-                    };
+        /* wait for MAX_NRDY_USEC after msc config change */
+        nrdy_timeout = rsrc->nrdy;
+        while (nrdy_timeout) {
+            --nrdy_timeout;
+        };
 
-                    /*Perform first memory transaction */
-                    val_memcpy(src_buf, dest_buf, buf_size);
+        /*Perform first memory transaction */
+        tgen_run(&traffic);
 
-                    /* Read Cache storage value */
-                    storage_value1 = val_mpam_read_csumon(msc_index);
+        /* Read Cache storage value */
+        storage_value1 = val_mpam_read_csumon(msc_index);
 
-                    val_print(ACS_PRINT_DEBUG, "\n       Storage Value 1 = 0x%x", storage_value1);
+        val_print(ACS_PRINT_DEBUG, "\n       Storage Value 1 = 0x%x", storage_value1);
 
-                    /*Restore initial MPAM_EL2 settings */
-                    mpam2_el2 = mpam2_el2_temp;
+        /*Restore initial MPAM_EL2 settings */
+        mpam2_el2 = mpam2_el2_temp;
 
-                    /* Clear the PARTID_D & PMG_D bits in mpam2_el2 before writing to them */
-                    mpam2_el2 = CLEAR_BITS_M_TO_N(mpam2_el2, MPAMn_ELx_PARTID_D_SHIFT+15,
-                                                             MPAMn_ELx_PARTID_D_SHIFT);
-                    mpam2_el2 = CLEAR_BITS_M_TO_N(mpam2_el2, MPAMn_ELx_PMG_D_SHIFT+7,
-                                                             MPAMn_ELx_PMG_D_SHIFT);
+        /* Clear the PARTID_D & PMG_D bits in mpam2_el2 before writing to them */
+        mpam2_el2 = CLEAR_BITS_M_TO_N(mpam2_el2, MPAMn_ELx_PARTID_D_SHIFT+15,
+                                                 MPAMn_ELx_PARTID_D_SHIFT);
+        mpam2_el2 = CLEAR_BITS_M_TO_N(mpam2_el2, MPAMn_ELx_PMG_D_SHIFT+7,
+                                                 MPAMn_ELx_PMG_D_SHIFT);
 
-                    /* Write MAX_PARTID & PMG1 to MPAM2_EL2 and generate PE traffic */
-                    mpam2_el2 |= (((uint64_t)pmg1 << MPAMn_ELx_PMG_D_SHIFT) |
-                                  ((uint64_t)max_partid << MPAMn_ELx_PARTID_D_SHIFT));
+        /* Write MAX_PARTID & PMG1 to MPAM2_EL2 and generate PE traffic */
+        mpam2_el2 |= (((uint64_t)pmg1 << MPAMn_ELx_PMG_D_SHIFT) |
+                      ((uint64_t)max_partid << MPAMn_ELx_PARTID_D_SHIFT));
 
-                    val_mpam_reg_write(MPAM2_EL2, mpam2_el2);
+        val_mpam_reg_write(MPAM2_EL2, mpam2_el2);
 
-                    /* Disable the monitor */
-                    val_mpam_csumon_disable(msc_index);
+        /* Disable the monitor */
+        val_mpam_csumon_disable(msc_index);
 
-                    /* Enable CSU monitoring */
-                    val_mpam_csumon_enable(msc_index);
+        /* Enable CSU monitoring */
+        val_mpam_csumon_enable(msc_index);
 
-                    /* wait for MAX_NRDY_USEC after msc config change */
-                    nrdy_timeout = val_mpam_get_info(MPAM_MSC_NRDY, msc_index, 0);
-                    while (nrdy_timeout) {
-                        --nrdy_timeout;
-                    };
+        /* wait for MAX_NRDY_USEC after msc config change */
+        nrdy_timeout = rsrc->nrdy;
+        while (nrdy_timeout) {
+            --nrdy_timeout;
+        };
 
-                    /*Perform second memory transaction */
-                    val_memcpy(src_buf, dest_buf, buf_size);
+        /*Perform second memory transaction */
+        tgen_run(&traffic);
 
-                    /* Read Cache storage value for PMG1 */
-                    storage_value2 = val_mpam_read_csumon(msc_index);
+        /* Read Cache storage value for PMG1 */
+        storage_value2 = val_mpam_read_csumon(msc_index);
 
-                    val_print(ACS_PRINT_DEBUG, "\n       Storage Value 1 = 0x%x", storage_value2);
+        val_print(ACS_PRINT_DEBUG, "\n       Storage Value 1 = 0x%x", storage_value2);
 
-                    /* Disable the monitor */
-                    val_mpam_csumon_disable(msc_index);
+        /* Disable the monitor */
+        val_mpam_csumon_disable(msc_index);
 
-                    /* Test fails if storage_value1 is non zero or storage_value2 is zero */
-                    if (storage_value1 || !storage_value2) {
-                        val_set_status(index, RESULT_FAIL(TEST_NUM, 05));
+        /* Test fails if storage_value1 is non zero or storage_value2 is zero */
+        if (storage_value1 || !storage_value2) {
+            val_set_status(index, RESULT_FAIL(TEST_NUM, 05));
 
-                        /*Restore MPAM2_EL2 settings */
-                        val_mpam_reg_write(MPAM2_EL2, mpam2_el2_temp);
+            /*Restore MPAM2_EL2 settings */
+            val_mpam_reg_write(MPAM2_EL2, mpam2_el2_temp);
 
-                        /*Free the buffers */
-                        val_memory_free_aligned(src_buf);
-                        val_memory_free_aligned(dest_buf);
+            /*Free the buffers */
+            val_memory_free_aligned(src_buf);
+            val_memory_free_aligned(dest_buf);
 
-                        return;
-                    }
+            return;
+        }
 
-                    /*Restore MPAM2_EL2 settings */
-                    val_mpam_reg_write(MPAM2_EL2, mpam2_el2_temp);
+        /*Restore MPAM2_EL2 settings */
+        val_mpam_reg_write(MPAM2_EL2, mpam2_el2_temp);
 
-                    /*Free the buffers */
-                    val_memory_free_aligned(src_buf);
-                    val_memory_free_aligned(dest_buf);
-                }
-            }
-        }
+        /*Free the buffers */
+        val_memory_free_aligned(src_buf);
+        val_memory_free_aligned(dest_buf);
     }
 
     val_set_status(index, RESULT_PASS(TEST_NUM, 01));
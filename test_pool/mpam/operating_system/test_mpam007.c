@@ -21,6 +21,8 @@
 #include "val/sbsa/include/sbsa_val_interface.h"
 #include "val/sbsa/include/sbsa_acs_mpam.h"
 
+#include "../../common/mpam_index.h"
+
 #define TEST_NUM   (ACS_MPAM_TEST_NUM_BASE + 7)
 #define TEST_RULE  "S_L7MP_03"
 #define TEST_DESC  "Check MPAM LLC Requirements           "
@@ -37,17 +39,15 @@ static void payload(void)
     uint32_t index = val_pe_get_index_mpid(val_pe_get_mpid());
     uint32_t msc_node_cnt;
     uint32_t rsrc_node_cnt;
-    uint32_t msc_index, rsrc_index;
+    uint32_t rsrc_num;
+    MPAM_RSRC *rsrc;
     uint32_t pptt_llc_index;
     uint64_t pptt_cache_id;
     uint32_t pptt_llc_msc_found = 0;
     uint32_t mem_llc_msc_found = 0;
-    uint32_t ris_supported = 0;
     uint32_t pe_prox_domain;
     uint32_t pptt_llc_cpor_supported = 0;
     uint32_t memside_llc_cpor_supported = 0;
-    uint64_t desc1;
-    uint64_t desc2;
 
     if (g_sbsa_level < 7) {
         val_set_status(index, RESULT_SKIP(TEST_NUM, 01));
@@ -63,7 +63,7 @@ static void payload(void)
 
     /* If MPAM table not present, or no MSC
        found in table fail the test */
-    msc_node_cnt = val_mpam_get_msc_count();
+    msc_node_cnt = mpam_index_num_msc();
     val_print(ACS_PRINT_DEBUG, "\n       MSC count = %d", msc_node_cnt);
 
     if (msc_node_cnt == 0) {
@@ -72,6 +72,14 @@ static void payload(void)
         return;
     }
 
+    /* Resource nodes past the end of the index would never be checked */
+    if (mpam_index_dropped()) {
+        val_print(ACS_PRINT_ERR, "\n       MPAM index full, %d nodes not checked",
+                  mpam_index_dropped());
+        val_set_status(index, RESULT_SKIP(TEST_NUM, 02));
+        return;
+    }
+
     /* Find the PPTT LLC cache identifier */
     pptt_llc_index = val_cache_get_llc_index();
     if (pptt_llc_index == CACHE_TABLE_EMPTY) {
@@ -82,45 +90,25 @@ static void payload(void)
             val_print(ACS_PRINT_DEBUG, "\n       LLC invalid in PPTT", 0);
         } else {
 
-            /* visit each MSC node and check for PPTT cache resources */
-            for (msc_index = 0; msc_index < msc_node_cnt; msc_index++) {
-                rsrc_node_cnt = val_mpam_get_info(MPAM_MSC_RSRC_COUNT, msc_index, 0);
-
-                val_print(ACS_PRINT_DEBUG, "\n       MSC index  = %d", msc_index);
-                val_print(ACS_PRINT_DEBUG, "\n       Resource count = %d", rsrc_node_cnt);
-
-                ris_supported = val_mpam_msc_supports_ris(msc_index);
-                val_print(ACS_PRINT_INFO, "\n       RIS support = %d", ris_supported);
-
-                for (rsrc_index = 0; rsrc_index < rsrc_node_cnt; rsrc_index++) {
-                    /* check whether the resource location is PPTT cache */
-                    if (val_mpam_get_info(MPAM_MSC_RSRC_TYPE, msc_index, rsrc_index) ==
-                                                                        MPAM_RSRC_TYPE_PE_CACHE) {
-                        val_print(ACS_PRINT_DEBUG, "\n       rsrc index  = %d", rsrc_index);
-                        desc1 = val_mpam_get_info(MPAM_MSC_RSRC_DESC1, msc_index, rsrc_index);
-
-                        /* match pptt llc cache id */
-                        val_print(ACS_PRINT_DEBUG, "\n       rsrc descriptor 1  = %llx", desc1);
-                        if (desc1 == pptt_cache_id) {
-                            pptt_llc_msc_found = 1;
-                            /* Select resource instance if RIS feature implemented */
-                            if (ris_supported)
-                                val_mpam_memory_configure_ris_sel(msc_index, rsrc_index);
-
-                            /* Check CPOR are present */
-                            if (val_mpam_supports_cpor(msc_index)) {
-                                val_print(ACS_PRINT_DEBUG,
-                                    "\n       CPOR Supported by LLC for rsrc_index %d", rsrc_index);
-                                pptt_llc_cpor_supported = 1;
-                                break;
-                            }
-                            val_print(ACS_PRINT_DEBUG,
-                              "\n       CPOR Not Supported by LLC for rsrc_index %d", rsrc_index);
-                        }
-                    }
-                }
-                if (pptt_llc_cpor_supported)
+            /* visit each PPTT cache resource matching the LLC cache id */
+            rsrc_node_cnt = mpam_index_find(MPAM_RSRC_TYPE_PE_CACHE, pptt_cache_id, &rsrc);
+            val_print(ACS_PRINT_DEBUG, "\n       PPTT LLC resource count = %d", rsrc_node_cnt);
+
+            for (rsrc_num = 0; rsrc_num < rsrc_node_cnt; rsrc_num++, rsrc++) {
+                val_print(ACS_PRINT_DEBUG, "\n       MSC index  = %d", rsrc->msc_index);
+                val_print(ACS_PRINT_DEBUG, "\n       rsrc index  = %d", rsrc->rsrc_index);
+                val_print(ACS_PRINT_INFO, "\n       RIS support = %d", rsrc->ris);
+                pptt_llc_msc_found = 1;
+
+                /* Check CPOR are present */
+                if (rsrc->cpor) {
+                    val_print(ACS_PRINT_DEBUG,
+                        "\n       CPOR Supported by LLC for rsrc_index %d", rsrc->rsrc_index);
+                    pptt_llc_cpor_supported = 1;
                     break;
+                }
+                val_print(ACS_PRINT_DEBUG,
+                  "\n       CPOR Not Supported by LLC for rsrc_index %d", rsrc->rsrc_index);
             }
         }
     }
@@ -134,52 +122,36 @@ static void payload(void)
     /* test mem-side cache for cpor support */
     val_print(ACS_PRINT_DEBUG, "\n\n       Testing mem-side caches for CPOR support", 0);
     pe_prox_domain = val_srat_get_info(SRAT_GICC_PROX_DOMAIN, val_pe_get_uid(index));
-    /* visit each MSC node and check for mem cache resources */
-    for (msc_index = 0; msc_index < msc_node_cnt; msc_index++) {
-        rsrc_node_cnt = val_mpam_get_info(MPAM_MSC_RSRC_COUNT, msc_index, 0);
-
-        val_print(ACS_PRINT_DEBUG, "\n       MSC index  = %d", msc_index);
-        val_print(ACS_PRINT_DEBUG, "\n       Resource count = %d", rsrc_node_cnt);
-
-        ris_supported = val_mpam_msc_supports_ris(msc_index);
-        val_print(ACS_PRINT_INFO, "\n       RIS support = %d", ris_supported);
-
-        for (rsrc_index = 0; rsrc_index < rsrc_node_cnt; rsrc_index++) {
-            /* check whether the resource type is a mem-cache */
-            if (val_mpam_get_info(MPAM_MSC_RSRC_TYPE, msc_index, rsrc_index) ==
-                MPAM_RSRC_TYPE_MEM_SIDE_CACHE) {
-                val_print(ACS_PRINT_DEBUG, "\n       rsrc index  = %d", rsrc_index);
-                desc1 = val_mpam_get_info(MPAM_MSC_RSRC_DESC1, msc_index, rsrc_index);
-                desc2 = val_mpam_get_info(MPAM_MSC_RSRC_DESC2, msc_index, rsrc_index);
-                val_print(ACS_PRINT_DEBUG, "\n       rsrc descriptor 1  = %llx", desc1);
-                val_print(ACS_PRINT_DEBUG, "\n       rsrc descriptor 2  = %llx", desc2);
-
-                /* check if mem-side cache matches with PE proximity domain
-                   and cache level == 1 for mem-side LLC (based on assumption that
+
+    /* visit each mem cache resource node */
+    rsrc_node_cnt = mpam_index_type(MPAM_RSRC_TYPE_MEM_SIDE_CACHE, &rsrc);
+    val_print(ACS_PRINT_DEBUG, "\n       Mem-side resource count = %d", rsrc_node_cnt);
+
+    for (rsrc_num = 0; rsrc_num < rsrc_node_cnt; rsrc_num++, rsrc++) {
+        val_print(ACS_PRINT_DEBUG, "\n       MSC index  = %d", rsrc->msc_index);
+        val_print(ACS_PRINT_DEBUG, "\n       rsrc index  = %d", rsrc->rsrc_index);
+        val_print(ACS_PRINT_DEBUG, "\n       rsrc descriptor 1  = %llx", rsrc->desc1);
+        val_print(ACS_PRINT_DEBUG, "\n       rsrc descriptor 2  = %llx", rsrc->desc2);
+
+        /* check if mem-side cache matches with PE proximity domain
+           and cache level == 1 for mem-side LLC (based on assumption that
            mem-cache nearer to memory is LLC) */
-                if ((desc2 == pe_prox_domain) &&
-                   ((desc1 >> MEM_CACHE_LVL_SHIFT) & MEM_CACHE_LVL_MASK) == MEM_CACHE_LEVEL_1) {
-                    mem_llc_msc_found = 1;
-                    /* Select resource instance if RIS feature implemented */
-                    if (ris_supported)
-                        val_mpam_memory_configure_ris_sel(msc_index, rsrc_index);
-
-                    /* Check CPOR are present */
-                    if (val_mpam_supports_cpor(msc_index)) {
-                        val_print(ACS_PRINT_DEBUG,
-                                  "\n       CPOR Supported by mem-side cache with rsrc_index %d",
-                  rsrc_index);
-                        memside_llc_cpor_supported = 1;
-                        break;
-                    }
-                    val_print(ACS_PRINT_DEBUG,
-                              "\n       CPOR Not Supported by mem-side cache with rsrc_index %d",
-                   rsrc_index);
-                }
+        if ((rsrc->desc2 == pe_prox_domain) &&
+           ((rsrc->desc1 >> MEM_CACHE_LVL_SHIFT) & MEM_CACHE_LVL_MASK) == MEM_CACHE_LEVEL_1) {
+            mem_llc_msc_found = 1;
+
+            /* Check CPOR are present */
+            if (rsrc->cpor) {
+                val_print(ACS_PRINT_DEBUG,
+                          "\n       CPOR Supported by mem-side cache with rsrc_index %d",
+                          rsrc->rsrc_index);
+                memside_llc_cpor_supported = 1;
+                break;
             }
+            val_print(ACS_PRINT_DEBUG,
+                      "\n       CPOR Not Supported by mem-side cache with rsrc_index %d",
+                      rsrc->rsrc_index);
         }
-        if (memside_llc_cpor_supported)
-            break;
     }
 
     if (!mem_llc_msc_found) {
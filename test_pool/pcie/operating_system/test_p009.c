@@ -20,12 +20,21 @@
 #include "val/common/include/acs_memory.h"
 #include "val/sbsa/include/sbsa_acs_pcie.h"
 
+#ifndef TARGET_LINUX
+#include "../../common/msi_bench.h"
+#endif
+
 #define TEST_NUM   (ACS_PCIE_TEST_NUM_BASE + 9)
 #define TEST_DESC  "Check all MSI(X) vectors are LPIs     "
 #define TEST_RULE  "S_L3GI_02"
 
 #define LPI_BASE 8192
 
+/* LPI delivery benchmark, only run with -perf. The rate is set with -msi_gap
+ * and -msi_rounds, the active vectors are stepped up to MSI_BENCH_MAX_VECTORS.
+ */
+#define MSI_BENCH_ROUNDS   32
+
 /**
     @brief   Returns MSI(X) status of the device
 
@@ -130,6 +139,17 @@ payload (void)
   } else if (!status) {
     val_set_status (index, RESULT_PASS(TEST_NUM, 0));
   }
+
+#ifndef TARGET_LINUX
+  /* Measure LPI delivery through the ITS using the exerciser as MSI source */
+  if (g_sbsa_perf_mode) {
+    MSI_BENCH_CFG cfg = {MSI_BENCH_MAX_VECTORS,
+                         g_sbsa_msi_rounds ? g_sbsa_msi_rounds : MSI_BENCH_ROUNDS,
+                         g_sbsa_msi_gap};
+
+    msi_bench_run (&cfg);
+  }
+#endif
 }
 
 uint32_t
@@ -20,6 +20,8 @@
 #include "val/sbsa/include/sbsa_acs_pe.h"
 #include "val/common/include/acs_common.h"
 
+#include "../../common/pmu_irq_bench.h"
+
 #define TEST_NUM   (ACS_PMU_TEST_NUM_BASE  +  1)
 #define TEST_RULE  "PMU_PE_02"
 #define TEST_DESC  "Check PMU Overflow signal             "
@@ -84,8 +86,14 @@ payload()
     ;
   }
 
-  if (timeout == 0)
+  if (timeout == 0) {
       val_set_status(index, RESULT_FAIL(TEST_NUM, 01));
+      return;
+  }
+
+  /* Overflow to ISR latency and sustainable sample rate with the other PEs loading */
+  if (g_sbsa_perf_mode)
+      pmu_irq_bench_run(int_id, TEST_NUM);
 }
 
 /**
@@ -24,6 +24,9 @@
 #include "val/sbsa/include/sbsa_acs_mpam.h"
 #include "val/common/include/acs_common.h"
 
+#include "../../common/traffic_gen.h"
+#include "../../common/apmt_prof.h"
+
 #define TEST_NUM  (ACS_PMU_TEST_NUM_BASE + 4)
 #define TEST_RULE "PMU_BM_1, PMU_SYS_1, PMU_SYS_2"
 #define TEST_DESC "Check memory bandwidth monitors        "
@@ -42,6 +45,7 @@ static uint32_t generate_inbound_traffic(uint32_t node_index, uint64_t base_addr
     uint32_t  i;
     void *src_buf = 0;
     void *dest_buf = 0;
+    TGEN_CFG traffic = {TGEN_OP_COPY, TGEN_PATTERN_SEQ, 0, 0, 1, 0, 0, 0, 0};
     /* Generate inbound traffic for given size*/
 
     /* Allocate memory for 4 Megabytes */
@@ -52,7 +56,10 @@ static uint32_t generate_inbound_traffic(uint32_t node_index, uint64_t base_addr
         return 1;
 
     /* Perform memory copy for given size */
-    val_memcpy(src_buf, dest_buf, size);
+    traffic.src = (uint64_t)src_buf;
+    traffic.dst = (uint64_t)dest_buf;
+    traffic.size = size;
+    tgen_run(&traffic);
 
     /* Read the configured monitors for bandwidth values */
     for (i = 0; i < NUM_PMU_MON ; i++) {
@@ -68,6 +75,49 @@ static uint32_t generate_inbound_traffic(uint32_t node_index, uint64_t base_addr
     return 0;
 }
 
+/* Counter callback for the linearity sweep, ctx is the PMU node index */
+static uint64_t total_bw_counter(void *ctx, uint32_t op)
+{
+    uint32_t node_index = *(uint32_t *)ctx;
+
+    if (op == TGEN_COUNTER_READ)
+        return val_pmu_read_count(node_index, 0);
+
+    val_pmu_disable_monitor(node_index, 0);
+    val_pmu_enable_monitor(node_index, 0);
+    return 0;
+}
+
+/* Sweep read, write and copy traffic over the total bandwidth monitor */
+static void check_linearity(uint32_t node_index, uint64_t base_addr)
+{
+    TGEN_CFG traffic = {TGEN_OP_READ, TGEN_PATTERN_SEQ, 0, 0, 1, 0, 0, BUFFER_SIZE, 0};
+    void *src_buf;
+    void *dest_buf;
+
+    src_buf = (void *)val_mem_alloc_at_address(base_addr, BUFFER_SIZE);
+    dest_buf = (void *)val_mem_alloc_at_address(base_addr + BUFFER_SIZE, BUFFER_SIZE);
+
+    if ((src_buf != NULL) && (dest_buf != NULL)) {
+        traffic.src = (uint64_t)src_buf;
+        traffic.dst = (uint64_t)dest_buf;
+        tgen_linearity(&traffic, total_bw_counter, &node_index, "IB total BW, read");
+
+        traffic.op = TGEN_OP_WRITE;
+        traffic.nontemporal = 1;
+        tgen_linearity(&traffic, total_bw_counter, &node_index, "IB total BW, NT write");
+
+        traffic.op = TGEN_OP_COPY;
+        traffic.nontemporal = 0;
+        tgen_linearity(&traffic, total_bw_counter, &node_index, "IB total BW, copy");
+    }
+
+    if (src_buf != NULL)
+        val_mem_free_at_address((uint64_t)src_buf, BUFFER_SIZE);
+    if (dest_buf != NULL)
+        val_mem_free_at_address((uint64_t)dest_buf, BUFFER_SIZE);
+}
+
 static void payload(void)
 {
     uint64_t data = 0;
@@ -213,10 +263,18 @@ static void payload(void)
             }
         }
 
+        /* Check the total bandwidth monitor scales with the traffic */
+        if (g_sbsa_perf_mode)
+            check_linearity(node_index, prox_base_addr);
+
         /* Disable PMU monitors */
         val_pmu_disable_all_monitors(node_index);
     }
 
+    /* Bandwidth time series of every node under traffic through each memory range */
+    if (g_sbsa_perf_mode)
+        apmt_prof_run(APMT_PROF_BANDWIDTH);
+
     if (fail_cnt) {
         val_set_status(index, RESULT_FAIL(TEST_NUM, 03));
         return;
@@ -23,6 +23,8 @@
 #include "val/sbsa/include/sbsa_acs_mpam.h"
 #include "val/common/include/acs_common.h"
 
+#include "../../common/apmt_prof.h"
+
 #define TEST_NUM  (ACS_PMU_TEST_NUM_BASE + 5)
 #define TEST_RULE "PMU_MEM_1, PMU_SYS_1, PMU_SYS_2"
 #define TEST_DESC "Check memory latency monitors          "
@@ -172,6 +174,10 @@ static void payload(void)
         val_pmu_disable_all_monitors(node_index);
     }
 
+    /* Latency time series of every node under traffic through each memory range */
+    if (g_sbsa_perf_mode)
+        apmt_prof_run(APMT_PROF_LATENCY);
+
     if (fail_cnt) {
         val_set_status(index, RESULT_FAIL(TEST_NUM, 03));
         return;
@@ -22,6 +22,8 @@
 #include "val/sbsa/include/sbsa_acs_pcie.h"
 #include "val/common/include/acs_common.h"
 
+#include "../../common/pcie_mon_bench.h"
+
 #define TEST_NUM  (ACS_PMU_TEST_NUM_BASE + 7)
 #define TEST_RULE "PMU_BM_2, PMU_SYS_1, PMU_SYS_2"
 #define TEST_DESC "Check PCIe bandwidth monitors          "
@@ -183,6 +185,10 @@ static void payload(void)
         }
     }
 
+    /* Monitor accuracy, update latency and wrap time under known traffic */
+    if (g_sbsa_perf_mode && run_flag)
+        pcie_mon_bench_run();
+
     if (!run_flag) {
         val_print(ACS_PRINT_ERR, "\n       No PMU associated with PCIe interface", 0);
         val_set_status(index, RESULT_FAIL(TEST_NUM, 04));
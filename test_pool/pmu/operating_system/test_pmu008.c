@@ -23,6 +23,11 @@
 #include "val/sbsa/include/sbsa_acs_mpam.h"
 #include "val/common/include/acs_common.h"
 
+#include "../../common/traffic_gen.h"
+#include "../../common/apmt_prof.h"
+#include "../../common/numa_bench.h"
+#include "../../common/hmat_check.h"
+
 #define TEST_NUM  (ACS_PMU_TEST_NUM_BASE + 8)
 #define TEST_RULE "PMU_SYS_5"
 #define TEST_DESC "Check System PMU for NUMA systems      "
@@ -42,7 +47,11 @@ static void *dest_buf;
 /* This payload generates remote PE traffic for 2 MB*/
 static void payload1(void)
 {
-    val_memcpy(src_buf, dest_buf, BUFFER_SIZE / 2);
+    TGEN_CFG traffic = {TGEN_OP_COPY, TGEN_PATTERN_SEQ, 0, 0, 1, 0, 0, BUFFER_SIZE / 2, 0};
+
+    traffic.src = (uint64_t)src_buf;
+    traffic.dst = (uint64_t)dest_buf;
+    tgen_run(&traffic);
 
     val_set_status(remote_pe_index, RESULT_PASS(TEST_NUM, 01));
 }
@@ -50,7 +59,11 @@ static void payload1(void)
 /* This payload generates remote PE traffic for 4 MB*/
 static void payload2(void)
 {
-    val_memcpy(src_buf, dest_buf, BUFFER_SIZE);
+    TGEN_CFG traffic = {TGEN_OP_COPY, TGEN_PATTERN_SEQ, 0, 0, 1, 0, 0, BUFFER_SIZE, 0};
+
+    traffic.src = (uint64_t)src_buf;
+    traffic.dst = (uint64_t)dest_buf;
+    tgen_run(&traffic);
 
     val_set_status(remote_pe_index, RESULT_PASS(TEST_NUM, 02));
 }
@@ -59,6 +72,7 @@ static uint32_t generate_traffic(uint64_t prox_domain, uint32_t size, void (*rem
 {
     uint64_t prox_base_addr, addr_len;
     uint32_t timeout = TIMEOUT_LARGE;
+    TGEN_CFG traffic = {TGEN_OP_COPY, TGEN_PATTERN_SEQ, 0, 0, 1, 0, 0, 0, 0};
 
     prox_base_addr = val_srat_get_info(SRAT_MEM_BASE_ADDR, prox_domain);
     addr_len = val_srat_get_info(SRAT_MEM_ADDR_LEN, prox_domain);
@@ -78,7 +92,10 @@ static uint32_t generate_traffic(uint64_t prox_domain, uint32_t size, void (*rem
         return 1;
 
     /* Perform memory copy for given size */
-    val_memcpy(src_buf, dest_buf, size);
+    traffic.src = (uint64_t)src_buf;
+    traffic.dst = (uint64_t)dest_buf;
+    traffic.size = size;
+    tgen_run(&traffic);
 
     /* Perform memory copy from remote PE*/
     val_execute_on_pe(remote_pe_index, remote_traffic, 0);
@@ -111,6 +128,7 @@ static void payload(void)
     uint32_t remote_pe_uid, remote_pe_prox_domain;
     uint64_t value1[NUM_PMU_MON];
     uint64_t value2[NUM_PMU_MON];
+    NUMA_MATRIX *matrix;
 
     if (g_sbsa_level < 7) {
         val_set_status(index, RESULT_SKIP(TEST_NUM, 01));
@@ -245,6 +263,18 @@ static void payload(void)
     /* Disable PMU monitors */
     val_pmu_disable_all_monitors(mc_node_index);
 
+    /* Local and remote bandwidth time series of every node */
+    if (g_sbsa_perf_mode)
+        apmt_prof_run(APMT_PROF_NUMA);
+
+    /* Bandwidth and latency of every initiator/memory domain pair, and the
+       HMAT bandwidth claims checked against them */
+    if (g_sbsa_perf_mode) {
+        matrix = numa_bench_run(TEST_NUM);
+        if (matrix != NULL)
+            hmat_check_run(matrix, TEST_NUM);
+    }
+
     val_set_status(index, RESULT_PASS(TEST_NUM, 03));
 }
 
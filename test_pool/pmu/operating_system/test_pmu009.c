@@ -23,6 +23,8 @@
 #include "val/sbsa/include/sbsa_acs_mpam.h"
 #include "val/common/include/acs_common.h"
 
+#include "../../common/mix_traffic.h"
+
 #define TEST_NUM  (ACS_PMU_TEST_NUM_BASE + 9)
 #define TEST_RULE "PMU_SYS_6"
 #define TEST_DESC "Check multiple type traffic measurement"
@@ -139,6 +141,10 @@ static void payload(void)
     /* Disable PMU monitors */
     val_pmu_disable_all_monitors(pmu_node_index);
 
+    /* Attribution of CPU read, CPU write and DMA traffic overlapping on several PEs */
+    if (g_sbsa_perf_mode)
+        mix_traffic_run(pmu_node_index, num_mon, TEST_NUM);
+
     val_set_status(index, RESULT_PASS(TEST_NUM, 9));
 }
 
@@ -20,6 +20,8 @@
 
 #include "val/sbsa/include/sbsa_acs_smmu.h"
 
+#include "../../common/smmu_caps.h"
+
 #define TEST_NUM   (ACS_SMMU_TEST_NUM_BASE + 1)
 #define TEST_RULE  "S_L4SM_01, S_L4SM_02"
 #define TEST_DESC  "Check SMMU Compatibility              "
@@ -31,9 +33,10 @@ payload(void)
 
     uint64_t data;
     uint32_t num_smmu;
+    SMMU_CAPS *caps;
     uint32_t index = val_pe_get_index_mpid(val_pe_get_mpid());
 
-    num_smmu = val_iovirt_get_smmu_info(SMMU_NUM_CTRL, 0);
+    num_smmu = smmu_caps_num();
 
     if (num_smmu == 0) {
         val_print(ACS_PRINT_ERR, "\n       No SMMU Controllers are discovered ", 0);
@@ -43,7 +46,9 @@ payload(void)
 
     while (num_smmu--)
     {
-        if (val_smmu_get_info(SMMU_CTRL_ARCH_MAJOR_REV, num_smmu) < 3) {
+        caps = smmu_caps_get(num_smmu);
+
+        if (caps->arch_major < 3) {
             val_print(ACS_PRINT_ERR,
                      "\n       SMMUv3, or higher must be supported by level 4 or higher systems",
                         0);
@@ -51,7 +56,7 @@ payload(void)
             return;
         } else {
             val_print(ACS_PRINT_INFO, "\n       Detected SMMUv3, or higher implementation ", 0);
-            data = val_smmu_read_cfg(SMMUv3_IDR0, num_smmu);
+            data = caps->idr[0];
             /* Check Stage 2 translation support */
             if ((data & BIT0) == 0) {
                 val_print(ACS_PRINT_ERR, "\n       Stage 2 translation not supported ", 0);
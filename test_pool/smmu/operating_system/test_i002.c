@@ -20,6 +20,8 @@
 
 #include "val/sbsa/include/sbsa_acs_smmu.h"
 
+#include "../../common/smmu_caps.h"
+
 #define TEST_NUM   (ACS_SMMU_TEST_NUM_BASE + 2)
 #define TEST_RULE  "S_L5SM_01, S_L5SM_02, S_L8SM_01"
 #define TEST_DESC  "Check SMMUv3.2 or higher              "
@@ -30,9 +32,10 @@ payload(void)
 {
   uint64_t data;
   uint32_t num_smmu;
+  SMMU_CAPS *caps;
   uint32_t index = val_pe_get_index_mpid(val_pe_get_mpid());
 
-  num_smmu = val_smmu_get_info(SMMU_NUM_CTRL, 0);
+  num_smmu = smmu_caps_num();
 
   if (num_smmu == 0) {
       val_print(ACS_PRINT_ERR, "\n       No SMMU Controllers are discovered ", 0);
@@ -41,7 +44,9 @@ payload(void)
   }
 
   while (num_smmu--) {
-      if (val_smmu_get_info(SMMU_CTRL_ARCH_MAJOR_REV, num_smmu) < 3) {
+      caps = smmu_caps_get(num_smmu);
+
+      if (caps->arch_major < 3) {
           val_print(ACS_PRINT_ERR,
                             "\n       Level 5 or higher systems must be compliant "
                             "with the Arm SMMUv3.2 or higher  ", 0);
@@ -49,7 +54,7 @@ payload(void)
           return;
       } else {
           /* Read SMMU minor version */
-          data = VAL_EXTRACT_BITS(val_smmu_read_cfg(SMMUv3_AIDR, num_smmu), 0, 7);
+          data = VAL_EXTRACT_BITS(caps->aidr, 0, 7);
 
           if (g_sbsa_level < 8) {
               if (data < 0x2) { /* SMMUv3.2 or higher not implemented */
@@ -23,6 +23,8 @@
 #include "val/sbsa/include/sbsa_acs_smmu.h"
 #include "val/sbsa/include/sbsa_acs_pcie.h"
 
+#include "../../common/smmu_caps.h"
+
 #define TEST_NUM   (ACS_SMMU_TEST_NUM_BASE + 4)
 #define TEST_RULE  "B_SMMU_20"
 #define TEST_DESC  "Check S-EL2 & SMMU Stage2 Support     "
@@ -33,6 +35,7 @@ payload()
 {
   /* Check SMMU Revision & S-EL2 Support for Hypervisor */
   uint32_t num_smmu;
+  SMMU_CAPS *caps;
   uint32_t index;
   uint32_t s_el2;
   uint32_t smmu_rev;
@@ -48,7 +51,7 @@ payload()
       return;
   }
 
-  num_smmu = val_smmu_get_info(SMMU_NUM_CTRL, 0);
+  num_smmu = smmu_caps_num();
   if (num_smmu == 0) {
       val_print(ACS_PRINT_ERR, "\n       No SMMU Controllers are discovered ", 0);
       val_set_status(index, RESULT_SKIP(TEST_NUM, 2));
@@ -56,7 +59,9 @@ payload()
   }
 
   while (num_smmu--) {
-      smmu_rev = val_smmu_get_info(SMMU_CTRL_ARCH_MAJOR_REV, num_smmu);
+      caps = smmu_caps_get(num_smmu);
+
+      smmu_rev = caps->arch_major;
 
       if (smmu_rev < 3) {
           val_print(ACS_PRINT_ERR,
@@ -64,14 +69,14 @@ payload()
           val_set_status(index, RESULT_FAIL(TEST_NUM, 1));
           return;
       } else {
-          minor = VAL_EXTRACT_BITS(val_smmu_read_cfg(SMMUv3_AIDR, num_smmu), 0, 3);
+          minor = caps->minor;
           if (minor < 2) {
               val_print(ACS_PRINT_ERR,
                   "\n       SMMUv3.%d detected: revision must be v3.2 or higher  ", minor);
               val_set_status(index, RESULT_FAIL(TEST_NUM, 2));
               return;
           }
-          s2p = VAL_EXTRACT_BITS(val_smmu_read_cfg(SMMUv3_IDR0, num_smmu), 0, 0);
+          s2p = caps->s2p;
           if (!s2p) {
               val_print(ACS_PRINT_ERR,
                         "\n       SMMUv3.%d detected: but Stage 2 "
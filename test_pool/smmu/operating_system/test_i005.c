@@ -22,6 +22,8 @@
 #include "val/sbsa/include/sbsa_acs_pe.h"
 #include "val/sbsa/include/sbsa_acs_smmu.h"
 
+#include "../../common/smmu_caps.h"
+
 #define TEST_NUM   (ACS_SMMU_TEST_NUM_BASE + 5)
 #define TEST_RULE  "B_SMMU_11, B_SMMU_22, S_L5SM_03"
 #define TEST_DESC  "Check SMMU for MPAM support           "
@@ -32,6 +34,7 @@ payload()
 {
 
   uint32_t num_smmu;
+  SMMU_CAPS *caps;
   uint32_t smmu_rev;
   uint32_t minor;
   uint32_t index;
@@ -45,7 +48,7 @@ payload()
   /* Minor MPAM revision supported by the PE (i.e. MPAM vx.1) */
   frac = VAL_EXTRACT_BITS(val_pe_reg_read(ID_AA64PFR1_EL1), 16, 19);
 
-  num_smmu = val_smmu_get_info(SMMU_NUM_CTRL, 0);
+  num_smmu = smmu_caps_num();
   if (num_smmu == 0) {
     val_print(ACS_PRINT_DEBUG, "\n       No SMMU Controllers are discovered                 ", 0);
     val_set_status(index, RESULT_SKIP(TEST_NUM, 1));
@@ -59,7 +62,9 @@ payload()
   }
 
   while (num_smmu--) {
-        smmu_rev = val_smmu_get_info(SMMU_CTRL_ARCH_MAJOR_REV, num_smmu);
+        caps = smmu_caps_get(num_smmu);
+
+        smmu_rev = caps->arch_major;
         if (smmu_rev < 3) {
                 /* MPAM support not required for SMMUv2 and below */
                 val_print(ACS_PRINT_DEBUG, "\n       SMMU revision v2 or lower detected  ", 0);
@@ -67,15 +72,13 @@ payload()
                 return;
         }
         else {
-                minor = VAL_EXTRACT_BITS(val_smmu_read_cfg(SMMUv3_AIDR, num_smmu), 0, 3);
+                minor = caps->minor;
                 /* Check if MPAM is supported for any security state (only for SMMU v3.2+) */
                 if (minor >= 2) {
                         /* SMMU general MPAM support (in either Secure/Non-Secure state) */
-                        mpam = VAL_EXTRACT_BITS(val_smmu_read_cfg(SMMUv3_IDR3, num_smmu),
-                              7, 7);
+                        mpam = caps->mpam;
                         /* Check if MPAM is supported for any of the NS resources (max part ID) */
-                        max_id = VAL_EXTRACT_BITS(val_smmu_read_cfg(SMMUv3_MPAMIDR,
-                              num_smmu), 0, 15);
+                        max_id = caps->partid_max;
                         if (!(mpam && max_id)) {
                                 val_print(ACS_PRINT_ERR,
                                           "\n       SMMU without MPAM support detected  ", 0);
@@ -21,6 +21,9 @@
 #include "val/sbsa/include/sbsa_acs_smmu.h"
 #include "val/sbsa/include/sbsa_acs_pcie.h"
 
+#include "../../common/smmu_caps.h"
+#include "../../common/httu_bench.h"
+
 #define TEST_NUM   (ACS_SMMU_TEST_NUM_BASE + 6)
 #define TEST_RULE  "S_L6SM_02"
 #define TEST_DESC  "Check SMMU HTTU Support               "
@@ -32,6 +35,7 @@ payload(void)
 
   uint64_t data;
   uint32_t num_smmu;
+  SMMU_CAPS *caps;
   uint32_t index = val_pe_get_index_mpid(val_pe_get_mpid());
 
   if (g_sbsa_level < 6) {
@@ -39,7 +43,11 @@ payload(void)
       return;
   }
 
-  num_smmu = val_smmu_get_info(SMMU_NUM_CTRL, 0);
+  /* Cost of hardware Access flag and dirty state updates */
+  if (g_sbsa_perf_mode)
+      httu_bench_run();
+
+  num_smmu = smmu_caps_num();
 
   if (num_smmu == 0) {
       val_print(ACS_PRINT_ERR, "\n       No SMMU Controllers are discovered ", 0);
@@ -48,13 +56,15 @@ payload(void)
   }
 
   while (num_smmu--) {
-      if (val_smmu_get_info(SMMU_CTRL_ARCH_MAJOR_REV, num_smmu) == 2) {
+      caps = smmu_caps_get(num_smmu);
+
+      if (caps->arch_major == 2) {
           val_print(ACS_PRINT_WARN, "\n       Not valid for SMMU v2           ", 0);
           val_set_status(index, RESULT_SKIP(TEST_NUM, 03));
           return;
       }
 
-      data = VAL_EXTRACT_BITS(val_smmu_read_cfg(SMMUv3_IDR0, num_smmu), 6, 7);
+      data = caps->httu;
 
       /* Check If SMMU_IDR0.HTTU == 0b10 */
       if (data != 2) {
@@ -23,6 +23,8 @@
 #include "val/sbsa/include/sbsa_acs_smmu.h"
 #include "val/sbsa/include/sbsa_acs_pcie.h"
 
+#include "../../common/smmu_caps.h"
+
 #define TEST_NUM   (ACS_SMMU_TEST_NUM_BASE + 8)
 #define TEST_RULE  "B_SMMU_23"
 #define TEST_DESC  "Check SMMU 16 Bit VMID Support        "
@@ -34,13 +36,14 @@ payload()
 
   uint64_t data;
   uint32_t num_smmu;
+  SMMU_CAPS *caps;
   uint32_t index;
   uint32_t pe_vmid;
 
   index = val_pe_get_index_mpid(val_pe_get_mpid());
   pe_vmid = VAL_EXTRACT_BITS(val_pe_reg_read(ID_AA64MMFR1_EL1), 4, 7);
 
-  num_smmu = val_smmu_get_info(SMMU_NUM_CTRL, 0);
+  num_smmu = smmu_caps_num();
   if (num_smmu == 0) {
       val_print(ACS_PRINT_ERR, "\n       No SMMU Controllers are discovered ", 0);
       val_set_status(index, RESULT_SKIP(TEST_NUM, 1));
@@ -48,13 +51,15 @@ payload()
   }
 
   while (num_smmu--) {
-      if (val_smmu_get_info(SMMU_CTRL_ARCH_MAJOR_REV, num_smmu) == 2) {
+      caps = smmu_caps_get(num_smmu);
+
+      if (caps->arch_major == 2) {
           val_print(ACS_PRINT_WARN, "\n       Not valid for SMMU v2           ", 0);
           val_set_status(index, RESULT_SKIP(TEST_NUM, 2));
           return;
       }
 
-      data = VAL_EXTRACT_BITS(val_smmu_read_cfg(SMMUv3_IDR0, num_smmu), 18, 18);
+      data = caps->vmid16;
 
       if (!data && pe_vmid) {
           val_set_status(index, RESULT_FAIL(TEST_NUM, 1));
@@ -22,6 +22,8 @@
 #include "val/sbsa/include/sbsa_acs_smmu.h"
 #include "val/sbsa/include/sbsa_acs_pe.h"
 
+#include "../../common/smmu_caps.h"
+
 #define TEST_NUM   (ACS_SMMU_TEST_NUM_BASE + 9)
 #define TEST_RULE  "B_SMMU_03"
 #define TEST_DESC  "Check SMMU Large VA Support           "
@@ -33,6 +35,7 @@ payload()
 
   uint64_t data_va_range, data_vax;
   uint32_t num_smmu;
+  SMMU_CAPS *caps;
   uint32_t index;
 
   index = val_pe_get_index_mpid(val_pe_get_mpid());
@@ -44,7 +47,7 @@ payload()
     return;
   }
 
-  num_smmu = val_smmu_get_info(SMMU_NUM_CTRL, 0);
+  num_smmu = smmu_caps_num();
   if (num_smmu == 0) {
     val_print(ACS_PRINT_ERR, "\n       No SMMU Controllers are discovered                  ", 0);
     val_set_status(index, RESULT_SKIP(TEST_NUM, 2));
@@ -52,13 +55,15 @@ payload()
   }
 
   while (num_smmu--) {
-      if (val_smmu_get_info(SMMU_CTRL_ARCH_MAJOR_REV, num_smmu) == 2) {
+      caps = smmu_caps_get(num_smmu);
+
+      if (caps->arch_major == 2) {
           val_print(ACS_PRINT_WARN, "\n       Large VA Not Supported in SMMUv2", 0);
           val_set_status(index, RESULT_FAIL(TEST_NUM, 1));
           return;
       }
 
-      data_vax = VAL_EXTRACT_BITS(val_smmu_read_cfg(SMMUv3_IDR5, num_smmu), 10, 11);
+      data_vax = caps->vax;
 
       /* If PE Supports Large VA Range then SMMU_IDR5.VAX = 0b01 */
       if (data_va_range == 1) {
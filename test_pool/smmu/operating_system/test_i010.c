@@ -22,6 +22,9 @@
 #include "val/sbsa/include/sbsa_acs_smmu.h"
 #include "val/sbsa/include/sbsa_acs_pe.h"
 
+#include "../../common/smmu_caps.h"
+#include "../../common/cmdq_bench.h"
+
 #define TEST_NUM   (ACS_SMMU_TEST_NUM_BASE + 10)
 #define TEST_RULE  "B_SMMU_04, B_SMMU_05"
 #define TEST_DESC  "Check TLB Range Invalidation          "
@@ -33,10 +36,15 @@ payload()
 
   uint64_t data_pe_tlb, data_ril;
   uint32_t num_smmu;
+  SMMU_CAPS *caps;
   uint32_t index;
 
   index = val_pe_get_index_mpid(val_pe_get_mpid());
 
+  /* Compare per page and range invalidation cost whatever the PE supports */
+  if (g_sbsa_perf_mode)
+      cmdq_bench_run();
+
   data_pe_tlb = VAL_EXTRACT_BITS(val_pe_reg_read(ID_AA64ISAR0_EL1), 56, 59);
   if (data_pe_tlb != 0x2) {
       val_print(ACS_PRINT_DEBUG, "\n       TLB Range Invalid Not "
@@ -45,7 +53,7 @@ payload()
       return;
   }
 
-  num_smmu = val_smmu_get_info(SMMU_NUM_CTRL, 0);
+  num_smmu = smmu_caps_num();
   if (num_smmu == 0) {
     val_print(ACS_PRINT_DEBUG, "\n       No SMMU Controllers are discovered"
                                  "                  ", 0);
@@ -54,14 +62,16 @@ payload()
   }
 
   while (num_smmu--) {
-    if (val_smmu_get_info(SMMU_CTRL_ARCH_MAJOR_REV, num_smmu) < 3) {
+    caps = smmu_caps_get(num_smmu);
+
+    if (caps->arch_major < 3) {
       val_print(ACS_PRINT_DEBUG, "\n       Not valid for SMMUv2 or older"
                                     "version               ", 0);
       val_set_status(index, RESULT_SKIP(TEST_NUM, 3));
       return;
     }
 
-    data_ril = VAL_EXTRACT_BITS(val_smmu_read_cfg(SMMUv3_IDR3, num_smmu), 10, 10);
+    data_ril = caps->ril;
 
     /* If PE TLB Range Invalidation then SMMU_IDR3.RIL = 0b1 */
     if (data_pe_tlb == 0x2) {
@@ -23,6 +23,8 @@
 #include "val/sbsa/include/sbsa_acs_pcie.h"
 #include "val/sbsa/include/sbsa_acs_pe.h"
 
+#include "../../common/smmu_caps.h"
+
 #define TEST_NUM   (ACS_SMMU_TEST_NUM_BASE + 12)
 #define TEST_RULE  "B_SMMU_14"
 #define TEST_DESC  "Check SMMU Endianess Support          "
@@ -35,11 +37,12 @@ payload()
   uint64_t data;
   uint64_t data_pe_endian = 0;
   uint32_t num_smmu;
+  SMMU_CAPS *caps;
   uint32_t index;
 
   index = val_pe_get_index_mpid(val_pe_get_mpid());
 
-  num_smmu = val_smmu_get_info(SMMU_NUM_CTRL, 0);
+  num_smmu = smmu_caps_num();
 
   if (num_smmu == 0) {
     val_print(ACS_PRINT_ERR, "\n       No SMMU Controllers are discovered                  ", 0);
@@ -55,13 +58,15 @@ payload()
   }
 
   while (num_smmu--) {
-      if (val_smmu_get_info(SMMU_CTRL_ARCH_MAJOR_REV, num_smmu) == 2) {
+      caps = smmu_caps_get(num_smmu);
+
+      if (caps->arch_major == 2) {
           val_print(ACS_PRINT_WARN, "\n       Not valid for SMMU v2           ", 0);
           val_set_status(index, RESULT_SKIP(TEST_NUM, 2));
           return;
       }
 
-      data = VAL_EXTRACT_BITS(val_smmu_read_cfg(SMMUv3_IDR0, num_smmu), 21, 22);
+      data = caps->ttendian;
 
       if ((data_pe_endian == 1) && ((data == 1) || (data == 2))) {
           /* If PE supports big endian */
@@ -23,6 +23,9 @@
 #include "val/sbsa/include/sbsa_acs_smmu.h"
 #include "val/sbsa/include/sbsa_acs_pcie.h"
 
+#include "../../common/smmu_caps.h"
+#include "../../common/pmcg_prof.h"
+
 #define TEST_NUM   (ACS_SMMU_TEST_NUM_BASE + 14)
 #define TEST_RULE  "S_L7SM_03, S_L7SM_04"
 #define TEST_DESC  "Check SMMU PMU Extension              "
@@ -33,6 +36,7 @@ payload()
 {
 
   uint32_t num_smmu;
+  SMMU_CAPS *caps;
   uint32_t num_pmcg = 0;
   uint32_t i = 0;
   uint32_t smmu_version;
@@ -49,7 +53,7 @@ payload()
       return;
   }
 
-  num_smmu = val_smmu_get_info(SMMU_NUM_CTRL, 0);
+  num_smmu = smmu_caps_num();
   num_pmcg = val_iovirt_get_pmcg_info(PMCG_NUM_CTRL, 0);
 
   if (num_smmu == 0) {
@@ -59,14 +63,16 @@ payload()
   }
 
   while (num_smmu--) {
-      smmu_version = val_smmu_get_info(SMMU_CTRL_ARCH_MAJOR_REV, num_smmu);
+      caps = smmu_caps_get(num_smmu);
+
+      smmu_version = caps->arch_major;
       if (smmu_version != 3) {
           val_print(ACS_PRINT_DEBUG,
                     "\n       Valid for only SMMU v3, smmu version %d", smmu_version);
           continue;
       }
 
-      smmu_base = val_smmu_get_info(SMMU_CTRL_BASE, num_smmu);
+      smmu_base = caps->base;
 
       num_pmcg_found = 0;
       /* Each SMMUv3 must contain atleast 1 PMCG*/
@@ -101,6 +107,10 @@ payload()
 
   }
 
+  /* Per stream translation profile of a reference DMA workload, on the PMCGs checked above */
+  if (g_sbsa_perf_mode)
+      pmcg_prof_run();
+
   if (test_fail)
       val_set_status(index, RESULT_FAIL(TEST_NUM, 01));
   else
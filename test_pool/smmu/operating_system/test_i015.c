@@ -21,6 +21,8 @@
 #include "val/sbsa/include/sbsa_acs_pe.h"
 #include "val/common/include/acs_iovirt.h"
 
+#include "../../common/route_map.h"
+
 #define TEST_NUM   (ACS_SMMU_TEST_NUM_BASE + 15)
 #define TEST_RULE  "S_L7SM_01"
 #define TEST_DESC  "Check if all DMA reqs behind SMMU     "
@@ -30,63 +32,53 @@ void
 payload()
 {
 
-  uint32_t num_pcie_rc, num_named_comp;
+  uint32_t num_nodes;
   uint32_t i, test_fails = 0;
   uint32_t index = val_pe_get_index_mpid(val_pe_get_mpid());
-  uint32_t num_dma_req = 0;
+  ROUTE_NODE *node;
 
   if (g_sbsa_level < 7) {
       val_set_status(index, RESULT_SKIP(TEST_NUM, 01));
       return;
   }
 
-  /* check whether all DMA capable PCIe root complexes are behind a SMMU */
-  num_pcie_rc = val_iovirt_get_pcie_rc_info(NUM_PCIE_RC, 0);
-  num_dma_req = num_pcie_rc;
-  for (i = 0; i < num_pcie_rc; i++) {
+  /* check whether all DMA capable PCIe root complexes and Named component
+     requestors are behind a SMMU */
+  num_nodes = route_map_num_nodes();
+  for (i = 0; i < num_nodes; i++) {
+      node = route_map_node(i);
+
       /* print info fields */
-      val_print(ACS_PRINT_DEBUG, "\n       RC segment no  : 0x%llx",
-                    val_iovirt_get_pcie_rc_info(RC_SEGMENT_NUM, i));
-      val_print(ACS_PRINT_DEBUG, "\n       CCA attribute  : 0x%x",
-                    val_iovirt_get_pcie_rc_info(RC_MEM_ATTRIBUTE, i));
-      val_print(ACS_PRINT_DEBUG, "\n       SMMU base addr : 0x%llx\n",
-                    val_iovirt_get_pcie_rc_info(RC_SMMU_BASE, i));
-
-      if (val_iovirt_get_pcie_rc_info(RC_MEM_ATTRIBUTE, i) == 0x1 &&
-                                    val_iovirt_get_pcie_rc_info(RC_SMMU_BASE, i) == 0) {
-          val_print(ACS_PRINT_ERR,
-                    "\n       DMA capable PCIe root port with segment no: %llx not behind a SMMU.",
-                    val_iovirt_get_pcie_rc_info(RC_SEGMENT_NUM, i));
-          test_fails++;
+      if (node->type == ROUTE_NODE_RC) {
+          val_print(ACS_PRINT_DEBUG, "\n       RC segment no  : 0x%llx", node->segment);
+          val_print(ACS_PRINT_DEBUG, "\n       CCA attribute  : 0x%x", node->cca);
+          val_print(ACS_PRINT_DEBUG, "\n       SMMU base addr : 0x%llx\n", node->smmu_base);
+      } else {
+          val_print(ACS_PRINT_DEBUG, "\n       Named component  :", 0);
+          val_print(ACS_PRINT_DEBUG, node->name, 0);
+          val_print(ACS_PRINT_DEBUG, "\n       CCA attribute    : 0x%x", node->cca);
+          val_print(ACS_PRINT_DEBUG, "\n       SMMU base addr   : 0x%llx\n", node->smmu_base);
       }
-  }
 
-  /* check whether all DMA capable Named component requestors are behind a SMMU */
-  num_named_comp = val_iovirt_get_named_comp_info(NUM_NAMED_COMP, 0);
-  num_dma_req += num_named_comp;
-  for (i = 0; i < num_named_comp; i++) {
-      /* print info fields */
-      val_print(ACS_PRINT_DEBUG, "\n       Named component  :", 0);
-      val_print(ACS_PRINT_DEBUG,
-                    (char8_t *)val_iovirt_get_named_comp_info(NAMED_COMP_DEV_OBJ_NAME, i), 0);
-      val_print(ACS_PRINT_DEBUG, "\n       CCA attribute    : 0x%x",
-                    val_iovirt_get_named_comp_info(NAMED_COMP_CCA_ATTR, i));
-      val_print(ACS_PRINT_DEBUG, "\n       SMMU base addr   : 0x%llx\n",
-                    val_iovirt_get_named_comp_info(NAMED_COMP_SMMU_BASE, i));
-      if (val_iovirt_get_named_comp_info(NAMED_COMP_CCA_ATTR, i) == 0x1 &&
-                                    val_iovirt_get_named_comp_info(NAMED_COMP_SMMU_BASE, i) == 0) {
+      if (node->cca != 0x1 || node->smmu_base != 0)
+          continue;
+
+      if (node->type == ROUTE_NODE_RC) {
           val_print(ACS_PRINT_ERR,
-                    "\n       DMA capable named component with namespace path: ", 0);
+                    "\n       DMA capable PCIe root port with segment no: %llx not behind a SMMU.",
+                    node->segment);
+      } else {
           val_print(ACS_PRINT_ERR,
-                    (char8_t *)val_iovirt_get_named_comp_info(NAMED_COMP_DEV_OBJ_NAME, i), 0);
+                    "\n       DMA capable named component with namespace path: ", 0);
+          val_print(ACS_PRINT_ERR, node->name, 0);
           val_print(ACS_PRINT_ERR, " not behind a SMMU.", 0);
-          test_fails++;
       }
+      test_fails++;
   }
 
   if (test_fails)
       val_set_status(index, RESULT_FAIL(TEST_NUM, 01));
-  else if (!num_dma_req) {
+  else if (!num_nodes) {
       val_print(ACS_PRINT_DEBUG, "\n       No DMA requestors present", 0);
       val_set_status(index, RESULT_SKIP(TEST_NUM, 02));
   } else {
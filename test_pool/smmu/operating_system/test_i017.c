@@ -21,6 +21,8 @@
 #include "val/sbsa/include/sbsa_acs_smmu.h"
 #include "val/common/include/acs_pcie.h"
 
+#include "../../common/smmu_caps.h"
+
 #define TEST_NUM   (ACS_SMMU_TEST_NUM_BASE + 17)
 #define TEST_RULE  "GPU_04"
 #define TEST_DESC  "Check ATS Support for SMMU            "
@@ -30,6 +32,7 @@ static void payload(void)
 
   uint64_t data;
   uint32_t num_smmu;
+  SMMU_CAPS *caps;
   uint32_t index = val_pe_get_index_mpid(val_pe_get_mpid());
 
   if (g_sbsa_level < 8) {
@@ -37,7 +40,7 @@ static void payload(void)
       return;
   }
 
-  num_smmu = val_smmu_get_info(SMMU_NUM_CTRL, 0);
+  num_smmu = smmu_caps_num();
 
   if (num_smmu == 0) {
       val_print(ACS_PRINT_ERR, "\n       No SMMU Controllers are discovered ", 0);
@@ -46,7 +49,9 @@ static void payload(void)
   }
 
   while (num_smmu--) {
-      if (val_smmu_get_info(SMMU_CTRL_ARCH_MAJOR_REV, num_smmu) == 2) {
+      caps = smmu_caps_get(num_smmu);
+
+      if (caps->arch_major == 2) {
           val_print(ACS_PRINT_WARN, "\n       Not valid for SMMU v2           ", 0);
           val_set_status(index, RESULT_SKIP(TEST_NUM, 03));
           return;
@@ -54,7 +59,7 @@ static void payload(void)
 
       /* For all SMMU controllers ATS capability must be present
        * if SMMU_IDR0.ATS[10:10] == 0b1 */
-      data = VAL_EXTRACT_BITS(val_smmu_read_cfg(SMMUv3_IDR0, num_smmu), 10, 10);
+      data = caps->ats;
       if (data != 1) {
           val_print(ACS_PRINT_ERR, "\n       ATS is not supported for Smmu Index : %d ", num_smmu);
           val_set_status(index, RESULT_FAIL(TEST_NUM, 01));
@@ -35,9 +35,10 @@ list(APPEND TEST_INCLUDE
 
 set(TEST_LIB ${EXE_NAME}_test_lib)
 
-# Compile all .c/.S files from test directory
+# Compile all .c/.S files from test directory and the helpers shared by tests
 file(GLOB TEST_SRC
     "${SBSA_DIR}/test_pool/*/*/test_*.c"
+    "${SBSA_DIR}/test_pool/common/*.c"
 )
 
 # Create TEST library
@@ -27,6 +27,10 @@
 #include "val/common/include/acs_pe.h"
 #include "val/common/include/acs_val.h"
 #include "val/common/include/acs_memory.h"
+#include "val/common/include/acs_pgt.h"
+#include "val/sbsa/include/sbsa_acs_smmu.h"
+
+#include "../test_pool/common/smmu_ctx.h"
 
 #include "SbsaAvs.h"
 
@@ -54,6 +58,10 @@ UINT64  g_exception_ret_addr;
 UINT64  g_ret_addr;
 UINT32  g_wakeup_timeout;
 UINT32  g_sys_last_lvl_cache;
+UINT32  g_sbsa_perf_mode;
+UINT32  g_sbsa_hmat_tol;
+UINT32  g_sbsa_msi_gap;
+UINT32  g_sbsa_msi_rounds;
 SHELL_FILE_HANDLE g_acs_log_file_handle;
 /* VE systems run acs at EL1 and in some systems crash is observed during acess
    of EL1 phy and virt timer, Below command line option is added only for debug
@@ -277,7 +285,8 @@ HelpMsg (
   )
 {
    Print (L"\nUsage: Sbsa.efi [-v <n>] | [-l <n>] | [-only] | [-fr] | [-f <filename>] | "
-         "[-skip <n>] | [-nist] | [-t <n>] | [-m <n>]\n"
+         "[-skip <n>] | [-nist] | [-t <n>] | [-m <n>] | [-perf] | [-hmat_tol <n>] | "
+         "[-msi_gap <n>] | [-msi_rounds <n>]\n"
          "Options:\n"
          "-v      Verbosity of the Prints\n"
          "        1 shows all prints, 5 shows Errors\n"
@@ -307,6 +316,13 @@ HelpMsg (
          "        1 - PPTT PE-side cache,  2 - HMAT mem-side cache\n"
          "         defaults to 0, if not set depicting SLC type unknown\n"
          "-el1physkip Skips EL1 register checks\n"
+         "-perf   Run the performance benchmarks of the tests which provide them\n"
+         "-hmat_tol  Percent HMAT bandwidth may be off the measured one, use with -perf\n"
+         "        defaults to 20\n"
+         "-msi_gap  Delay in ns between two MSIs of a burst in the LPI benchmark, use with -perf\n"
+         "        defaults to 0, back to back\n"
+         "-msi_rounds  Bursts per active vector count in the LPI benchmark, use with -perf\n"
+         "        defaults to 32\n"
   );
 }
 
@@ -329,6 +345,10 @@ STATIC CONST SHELL_PARAM_ITEM ParamList[] = {
   {L"-timeout" , TypeValue}, // -timeout # Set timeout multiple for wakeup tests
   {L"-slc"  , TypeValue},    // -slc  # system last level cache type
   {L"-el1physkip", TypeFlag}, // -el1physkip # Skips EL1 register checks
+  {L"-perf" , TypeFlag},     // -perf # Run performance benchmarks
+  {L"-hmat_tol", TypeValue}, // -hmat_tol # HMAT claims tolerance in percent
+  {L"-msi_gap", TypeValue},  // -msi_gap # Delay between MSIs of a burst in ns
+  {L"-msi_rounds", TypeValue}, // -msi_rounds # Bursts per active vector count
   {NULL     , TypeMax}
   };
 
@@ -519,6 +539,36 @@ ShellAppMainsbsa (
     g_el1physkip = TRUE;
   }
 
+  if (ShellCommandLineGetFlag (ParamPackage, L"-perf")) {
+    g_sbsa_perf_mode = TRUE;
+  } else {
+    g_sbsa_perf_mode = FALSE;
+  }
+
+  CmdLineArg  = ShellCommandLineGetValue (ParamPackage, L"-hmat_tol");
+  if (CmdLineArg == NULL) {
+    g_sbsa_hmat_tol = 0; /* default tolerance */
+  } else {
+    g_sbsa_hmat_tol = StrDecimalToUintn(CmdLineArg);
+    Print(L"HMAT tolerance %d%%.\n", g_sbsa_hmat_tol);
+  }
+
+  CmdLineArg  = ShellCommandLineGetValue (ParamPackage, L"-msi_gap");
+  if (CmdLineArg == NULL) {
+    g_sbsa_msi_gap = 0; /* back to back */
+  } else {
+    g_sbsa_msi_gap = StrDecimalToUintn(CmdLineArg);
+    Print(L"MSI gap %d ns.\n", g_sbsa_msi_gap);
+  }
+
+  CmdLineArg  = ShellCommandLineGetValue (ParamPackage, L"-msi_rounds");
+  if (CmdLineArg == NULL) {
+    g_sbsa_msi_rounds = 0; /* default rounds */
+  } else {
+    g_sbsa_msi_rounds = StrDecimalToUintn(CmdLineArg);
+    Print(L"MSI rounds %d.\n", g_sbsa_msi_rounds);
+  }
+
   // Options with Flags
   if ((ShellCommandLineGetFlag (ParamPackage, L"-no_crypto_ext")))
      g_crypto_support = FALSE;
@@ -683,6 +733,7 @@ ShellAppMainsbsa (
 
   /***         Starting Exerciser tests              ***/
   Status |= val_sbsa_exerciser_execute_tests(g_sbsa_level);
+  smmu_ctx_pool_destroy();
 
   /***         Starting MPAM tests                   ***/
   Status |= val_sbsa_mpam_execute_tests(g_sbsa_level, val_pe_get_num());